@@ -305,6 +305,29 @@ struct TestFindIfNot
 };
 VariableUnitTest<TestFindIfNot, SignedIntegralTypes> TestFindIfNotInstance;
 
+template <typename T>
+struct TestFindIfManyMatches
+{
+    void operator()(const size_t n)
+    {
+        // matches spread over the back half of the input, of which the first must be found
+        thrust::host_vector<T> h_data(n, T(0));
+        for (size_t i = n / 2; i < n; i += 1 + n / 64)
+        {
+            h_data[i] = T(1);
+        }
+        thrust::device_vector<T> d_data = h_data;
+
+        typename thrust::host_vector<T>::iterator   h_iter;
+        typename thrust::device_vector<T>::iterator d_iter;
+
+        h_iter = thrust::find_if(h_data.begin(), h_data.end(), equal_to_value_pred<T>(1));
+        d_iter = thrust::find_if(d_data.begin(), d_data.end(), equal_to_value_pred<T>(1));
+        ASSERT_EQUAL(h_iter - h_data.begin(), d_iter - d_data.begin());
+    }
+};
+VariableUnitTest<TestFindIfManyMatches, SignedIntegralTypes> TestFindIfManyMatchesInstance;
+
 void TestFindWithBigIndexesHelper(int magnitude)
 {
     thrust::counting_iterator<long long> begin(1);
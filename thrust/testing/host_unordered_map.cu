@@ -0,0 +1,180 @@
+#include <unittest/unittest.h>
+
+#include <thrust/detail/config.h>
+
+#if _CCCL_STD_VER >= 2011
+#include <thrust/host_unordered_map.h>
+#include <thrust/host_unordered_set.h>
+#include <thrust/host_vector.h>
+#include <thrust/execution_policy.h>
+#include <thrust/sort.h>
+#include <thrust/reduce.h>
+#include <thrust/functional.h>
+
+void TestHostUnorderedMapInsertAndFind()
+{
+  thrust::host_unordered_map<int, float> map;
+  ASSERT_EQUAL(map.empty(), true);
+
+  int keys[]     = { 3, 17, 3, -5 };
+  float values[] = { 1, 2, 3, 4 };
+
+  // of duplicate keys, one is inserted
+  ASSERT_EQUAL(map.bulk_insert(thrust::host, keys, keys + 4, values), 3u);
+  ASSERT_EQUAL(map.size(), 3u);
+
+  // keys already in the map keep their values
+  int more_keys[]     = { 17, 100 };
+  float more_values[] = { 50, 60 };
+  ASSERT_EQUAL(map.bulk_insert(thrust::host, more_keys, more_keys + 2, more_values), 1u);
+
+  int queries[] = { 17, -5, 100, 8 };
+  thrust::host_vector<float> found(4);
+  map.bulk_find(thrust::host, queries, queries + 4, found.begin(), -1.0f);
+  ASSERT_EQUAL(found[0], 2);
+  ASSERT_EQUAL(found[1], 4);
+  ASSERT_EQUAL(found[2], 60);
+  ASSERT_EQUAL(found[3], -1);
+
+  thrust::host_vector<bool> contained(4);
+  map.bulk_contains(thrust::host, queries, queries + 4, contained.begin());
+  ASSERT_EQUAL(contained[0], true);
+  ASSERT_EQUAL(contained[3], false);
+
+  map.clear();
+  ASSERT_EQUAL(map.size(), 0u);
+  map.bulk_contains(thrust::host, queries, queries + 4, contained.begin());
+  ASSERT_EQUAL(contained[0], false);
+}
+DECLARE_UNITTEST(TestHostUnorderedMapInsertAndFind);
+
+void TestHostUnorderedMapGrows()
+{
+  const int n = 10000;
+
+  thrust::host_vector<int> keys(n);
+  thrust::host_vector<int> values(n);
+  for(int i = 0; i < n; ++i)
+  {
+    keys[i] = i * 7919;
+    values[i] = i;
+  }
+
+  thrust::host_unordered_map<int, int> map;
+  std::size_t capacity = map.capacity();
+
+  // the map grows between insertions, keeping the keys it has
+  map.bulk_insert(thrust::host, keys.begin(), keys.begin() + n / 2, values.begin());
+  map.bulk_insert(thrust::host, keys.begin() + n / 2, keys.end(), values.begin() + n / 2);
+  ASSERT_EQUAL(map.size(), static_cast<std::size_t>(n));
+  ASSERT_LESS(capacity, map.capacity());
+  ASSERT_LEQUAL(2 * map.size(), map.capacity());
+
+  thrust::host_vector<int> found(n);
+  map.bulk_find(thrust::host, keys.begin(), keys.end(), found.begin());
+  ASSERT_EQUAL(found, values);
+}
+DECLARE_UNITTEST(TestHostUnorderedMapGrows);
+
+void TestHostUnorderedMapInsertOrReduce()
+{
+  const int n = 1000;
+
+  thrust::host_vector<int> keys(n);
+  thrust::host_vector<int> values(n, 1);
+  for(int i = 0; i < n; ++i)
+  {
+    keys[i] = (i * 31) % 10;
+  }
+
+  thrust::host_unordered_map<int, int> counts;
+  ASSERT_EQUAL(counts.insert_or_reduce(thrust::host, keys.begin(), keys.end(), values.begin(), thrust::plus<int>()), 10u);
+
+  // the same as reduce_by_key over the sorted keys
+  thrust::host_vector<int> unique_keys(counts.size());
+  thrust::host_vector<int> sums(counts.size());
+  counts.retrieve_all(thrust::host, unique_keys.begin(), sums.begin());
+  thrust::sort_by_key(unique_keys.begin(), unique_keys.end(), sums.begin());
+
+  thrust::host_vector<int> sorted_keys(keys);
+  thrust::host_vector<int> expected_keys(10);
+  thrust::host_vector<int> expected_sums(10);
+  thrust::sort(sorted_keys.begin(), sorted_keys.end());
+  thrust::reduce_by_key(sorted_keys.begin(), sorted_keys.end(), values.begin(), expected_keys.begin(), expected_sums.begin());
+
+  ASSERT_EQUAL(unique_keys, expected_keys);
+  ASSERT_EQUAL(sums, expected_sums);
+}
+DECLARE_UNITTEST(TestHostUnorderedMapInsertOrReduce);
+
+void TestHostUnorderedMapGrowsWithDistinctKeys()
+{
+  const int n = 100000;
+
+  thrust::host_vector<int> keys(n);
+  thrust::host_vector<int> values(n, 1);
+  for(int i = 0; i < n; ++i)
+  {
+    keys[i] = i % 4;
+  }
+
+  // the capacity follows the four distinct keys, not the number of keys inserted
+  thrust::host_unordered_map<int, int> counts;
+  ASSERT_EQUAL(counts.insert_or_reduce(thrust::host, keys.begin(), keys.end(), values.begin(), thrust::plus<int>()), 4u);
+  ASSERT_EQUAL(counts.insert_or_reduce(thrust::host, keys.begin(), keys.end(), values.begin(), thrust::plus<int>()), 0u);
+  ASSERT_EQUAL(counts.size(), 4u);
+  ASSERT_LEQUAL(counts.capacity(), 16u);
+
+  int queries[] = { 0, 1, 2, 3 };
+  thrust::host_vector<int> sums(4);
+  counts.bulk_find(thrust::host, queries, queries + 4, sums.begin());
+  ASSERT_EQUAL(sums, thrust::host_vector<int>(4, 2 * n / 4));
+
+  // keys which don't fit are inserted again after the map grows, and
+  // are reduced exactly once
+  for(int i = 0; i < n; ++i)
+  {
+    keys[i] = i % 5000;
+  }
+
+  ASSERT_EQUAL(counts.insert_or_reduce(thrust::host, keys.begin(), keys.end(), values.begin(), thrust::plus<int>()), 4996u);
+  ASSERT_EQUAL(counts.size(), 5000u);
+  ASSERT_LEQUAL(2 * counts.size(), counts.capacity());
+  ASSERT_LESS(counts.capacity(), 4 * 8192u);
+
+  thrust::host_vector<int> unique_keys(counts.size());
+  thrust::host_vector<int> all_sums(counts.size());
+  counts.retrieve_all(thrust::host, unique_keys.begin(), all_sums.begin());
+  thrust::sort_by_key(unique_keys.begin(), unique_keys.end(), all_sums.begin());
+
+  for(int i = 0; i < 5000; ++i)
+  {
+    ASSERT_EQUAL(unique_keys[i], i);
+    ASSERT_EQUAL(all_sums[i], i < 4 ? 2 * n / 4 + n / 5000 : n / 5000);
+  }
+}
+DECLARE_UNITTEST(TestHostUnorderedMapGrowsWithDistinctKeys);
+
+void TestHostUnorderedSet()
+{
+  int keys[] = { 4, 1, 4, 4, 9, 1 };
+
+  thrust::host_unordered_set<int> set;
+  ASSERT_EQUAL(set.bulk_insert(thrust::host, keys, keys + 6), 3u);
+  ASSERT_EQUAL(set.size(), 3u);
+
+  int queries[] = { 9, 2 };
+  thrust::host_vector<bool> contained(2);
+  set.bulk_contains(thrust::host, queries, queries + 2, contained.begin());
+  ASSERT_EQUAL(contained[0], true);
+  ASSERT_EQUAL(contained[1], false);
+
+  thrust::host_vector<int> unique_keys(set.size());
+  ASSERT_EQUAL(set.retrieve_all(thrust::host, unique_keys.begin()) - unique_keys.begin(), 3);
+  thrust::sort(unique_keys.begin(), unique_keys.end());
+  ASSERT_EQUAL(unique_keys[0], 1);
+  ASSERT_EQUAL(unique_keys[1], 4);
+  ASSERT_EQUAL(unique_keys[2], 9);
+}
+DECLARE_UNITTEST(TestHostUnorderedSet);
+#endif
@@ -6,6 +6,10 @@
 
 #if _CCCL_STD_VER >= 2011
 #include <thrust/mr/disjoint_sync_pool.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
 #endif
 
 struct alloc_id
@@ -274,6 +278,117 @@ void TestDisjointSynchronizedPoolCachingOversized()
 DECLARE_UNITTEST(TestDisjointSynchronizedPoolCachingOversized);
 #endif
 
+template<template<typename, typename> class PoolTemplate>
+void TestDisjointPoolTrimmingCachedOversized()
+{
+    dummy_resource upstream;
+    thrust::mr::new_delete_resource bookkeeper;
+
+    typedef PoolTemplate<
+        dummy_resource,
+        thrust::mr::new_delete_resource
+    > Pool;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.cache_oversized = true;
+    opts.largest_block_size = 1024;
+    opts.max_cached_oversized_bytes = 2 * 2048;
+
+    Pool pool(&upstream, &bookkeeper, opts);
+
+    upstream.id_to_allocate = 1;
+    alloc_id a1 = pool.do_allocate(2048, 32);
+    upstream.id_to_allocate = 2;
+    alloc_id a2 = pool.do_allocate(2048, 32);
+    upstream.id_to_allocate = 3;
+    alloc_id a3 = pool.do_allocate(2048, 32);
+
+    pool.do_deallocate(a1, 2048, 32);
+    pool.do_deallocate(a2, 2048, 32);
+
+    // make sure that the least recently cached block is returned upstream when the cache goes over budget
+    upstream.id_to_deallocate = 1;
+    pool.do_deallocate(a3, 2048, 32);
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+
+    alloc_id a4 = pool.do_allocate(2048, 32);
+    alloc_id a5 = pool.do_allocate(2048, 32);
+    ASSERT_EQUAL(a4.id + a5.id, 5u);
+
+    // make sure that there's nothing else in the cache
+    upstream.id_to_allocate = 4;
+    alloc_id a6 = pool.do_allocate(2048, 32);
+    ASSERT_EQUAL(a6.id, 4u);
+
+    pool.do_deallocate(a4, 2048, 32);
+    pool.do_deallocate(a5, 2048, 32);
+    pool.do_deallocate(a6, 2048, 32);
+}
+
+void TestDisjointUnsynchronizedPoolTrimmingCachedOversized()
+{
+    TestDisjointPoolTrimmingCachedOversized<thrust::mr::disjoint_unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointUnsynchronizedPoolTrimmingCachedOversized);
+
+#if _CCCL_STD_VER >= 2011
+void TestDisjointSynchronizedPoolTrimmingCachedOversized()
+{
+    TestDisjointPoolTrimmingCachedOversized<thrust::mr::disjoint_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointSynchronizedPoolTrimmingCachedOversized);
+#endif
+
+template<template<typename, typename> class PoolTemplate>
+void TestDisjointPoolSizeClasses()
+{
+    typedef PoolTemplate<
+        thrust::mr::new_delete_resource,
+        thrust::mr::new_delete_resource
+    > Pool;
+
+    thrust::mr::new_delete_resource upstream;
+    thrust::mr::new_delete_resource bookkeeper;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.size_classes_per_doubling = 4;
+
+    Pool pool(&upstream, &bookkeeper, opts);
+
+    // blocks are split out of chunks at the size of their class
+    char * a1 = static_cast<char *>(pool.do_allocate(1126));
+    char * a2 = static_cast<char *>(pool.do_allocate(1126));
+    ASSERT_EQUAL(a1 > a2 ? a1 - a2 : a2 - a1, 1280);
+
+    void * a3 = pool.do_allocate(1300);
+    thrust::mr::pool_fragmentation_statistics s = pool.fragmentation_statistics();
+    ASSERT_EQUAL(s.requested_bytes, 2 * 1126u + 1300u);
+    ASSERT_EQUAL(s.allocated_bytes, 2 * 1280u + 1536u);
+    ASSERT_LEQUAL(s.allocated_bytes, s.pooled_bytes);
+
+    pool.do_deallocate(a1, 1126);
+    pool.do_deallocate(a2, 1126);
+    pool.do_deallocate(a3, 1300);
+
+    s = pool.fragmentation_statistics();
+    ASSERT_EQUAL(s.requested_bytes, 0u);
+    ASSERT_EQUAL(s.allocated_bytes, 0u);
+}
+
+void TestDisjointUnsynchronizedPoolSizeClasses()
+{
+    TestDisjointPoolSizeClasses<thrust::mr::disjoint_unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointUnsynchronizedPoolSizeClasses);
+
+#if _CCCL_STD_VER >= 2011
+void TestDisjointSynchronizedPoolSizeClasses()
+{
+    TestDisjointPoolSizeClasses<thrust::mr::disjoint_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointSynchronizedPoolSizeClasses);
+#endif
+
 template<template<typename, typename> class PoolTemplate>
 void TestDisjointGlobalPool()
 {
@@ -299,3 +414,69 @@ void TestSynchronizedDisjointGlobalPool()
 DECLARE_UNITTEST(TestSynchronizedDisjointGlobalPool);
 #endif
 
+
+#if _CCCL_STD_VER >= 2011
+void TestDisjointSynchronizedPoolConcurrentUse()
+{
+    typedef thrust::mr::disjoint_synchronized_pool_resource<
+        thrust::mr::new_delete_resource,
+        thrust::mr::new_delete_resource
+    > Pool;
+
+    thrust::mr::new_delete_resource upstream;
+    thrust::mr::new_delete_resource bookkeeper;
+
+    Pool pool(&upstream, &bookkeeper, Pool::get_default_options(), 4);
+
+    const std::size_t num_threads = 8;
+    const std::size_t num_blocks = 512;
+    const std::size_t sizes[] = { 8, 100, 40000, 2 << 20 };
+
+    std::vector<std::vector<void *> > blocks(num_threads);
+    std::vector<int> ok(num_threads, 1);
+
+    // every thread fills blocks with its index, and the next thread checks and frees them
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t]{
+            for (std::size_t i = 0; i < num_blocks; ++i)
+            {
+                void * p = pool.do_allocate(sizes[i % 4]);
+                std::memset(p, static_cast<int>(t), sizes[i % 4]);
+                blocks[t].push_back(p);
+            }
+        });
+    }
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+        threads[t].join();
+    }
+    threads.clear();
+
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t]{
+            std::size_t owner = (t + 1) % num_threads;
+            for (std::size_t i = 0; i < num_blocks; ++i)
+            {
+                unsigned char * p = static_cast<unsigned char *>(blocks[owner][i]);
+                for (std::size_t j = 0; j < sizes[i % 4]; ++j)
+                {
+                    if (p[j] != owner)
+                    {
+                        ok[t] = 0;
+                    }
+                }
+                pool.do_deallocate(p, sizes[i % 4]);
+            }
+        });
+    }
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+        threads[t].join();
+        ASSERT_EQUAL(ok[t], 1);
+    }
+}
+DECLARE_UNITTEST(TestDisjointSynchronizedPoolConcurrentUse);
+#endif
@@ -0,0 +1,141 @@
+#include <unittest/unittest.h>
+#include <thrust/mr/mmap.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <thrust/mr/allocator.h>
+#include <thrust/host_vector.h>
+#include <thrust/fill.h>
+#include <thrust/count.h>
+
+#include <cstring>
+
+void TestMmapResourceAlignedAllocation()
+{
+    const thrust::mr::mmap_memory_resource::huge_page_mode modes[] = {
+        thrust::mr::mmap_memory_resource::no_huge_pages,
+        thrust::mr::mmap_memory_resource::transparent_huge_pages
+    };
+    const std::size_t sizes[] = { 1, 100, 4096, 100000, 3 << 20 };
+
+    for (std::size_t m = 0; m < 2; ++m)
+    {
+        thrust::mr::mmap_memory_resource memres(modes[m]);
+
+        for (std::size_t s = 0; s < 5; ++s)
+        {
+            for (std::size_t alignment = 16; alignment <= (4 << 20); alignment <<= 4)
+            {
+                void * ptr = memres.do_allocate(sizes[s], alignment);
+                ASSERT_EQUAL(reinterpret_cast<std::size_t>(ptr) % alignment, 0u);
+
+                char * char_ptr = static_cast<char *>(ptr);
+                thrust::fill(char_ptr, char_ptr + sizes[s], char{1});
+
+                memres.do_deallocate(ptr, sizes[s], alignment);
+            }
+        }
+    }
+}
+DECLARE_UNITTEST(TestMmapResourceAlignedAllocation);
+
+void TestMmapResourceExplicitHugePages()
+{
+    // falls back to regular pages when no huge pages are reserved
+    thrust::mr::mmap_memory_resource memres(thrust::mr::mmap_memory_resource::explicit_huge_pages);
+
+    void * ptr = memres.do_allocate(5 << 20);
+    ASSERT_EQUAL(reinterpret_cast<std::size_t>(ptr) % THRUST_MR_DEFAULT_ALIGNMENT, 0u);
+    std::memset(ptr, 1, 5 << 20);
+    memres.do_deallocate(ptr, 5 << 20);
+}
+DECLARE_UNITTEST(TestMmapResourceExplicitHugePages);
+
+void TestMmapResourceZeroFill()
+{
+    thrust::mr::mmap_memory_resource memres;
+
+    const std::size_t size = 1 << 20;
+    char * ptr = static_cast<char *>(memres.do_allocate(size));
+    ASSERT_EQUAL(thrust::count(ptr, ptr + size, 0), static_cast<std::ptrdiff_t>(size));
+
+    std::memset(ptr, 1, size);
+    memres.decommit(ptr, size);
+    ASSERT_EQUAL(thrust::count(ptr, ptr + size, 0), static_cast<std::ptrdiff_t>(size));
+
+    memres.do_deallocate(ptr, size);
+}
+DECLARE_UNITTEST(TestMmapResourceZeroFill);
+
+void TestMmapResourceVectorValueInitialization()
+{
+    typedef thrust::mr::allocator<int, thrust::mr::mmap_memory_resource> Alloc;
+
+    thrust::mr::mmap_memory_resource memres(thrust::mr::mmap_memory_resource::no_huge_pages);
+    Alloc alloc(&memres);
+
+    thrust::host_vector<int, Alloc> v(100000, alloc);
+    ASSERT_EQUAL(thrust::count(v.begin(), v.end(), 0), 100000);
+
+    // elements appended within the capacity are value-initialized, even though the memory was written to
+    thrust::fill(v.begin(), v.end(), 7);
+    v.resize(10);
+    v.resize(100000);
+    ASSERT_EQUAL(thrust::count(v.begin(), v.end(), 7), 10);
+    ASSERT_EQUAL(thrust::count(v.begin(), v.end(), 0), 100000 - 10);
+
+    // and so are elements appended to new storage
+    v.resize(300000);
+    ASSERT_EQUAL(thrust::count(v.begin(), v.end(), 0), 300000 - 10);
+}
+DECLARE_UNITTEST(TestMmapResourceVectorValueInitialization);
+
+#if defined(__linux__)
+void TestMmapResourceReallocate()
+{
+    thrust::mr::mmap_memory_resource memres(thrust::mr::mmap_memory_resource::no_huge_pages);
+
+    const std::size_t size = 100000;
+    char * ptr = static_cast<char *>(memres.reallocate(memres.do_allocate(size), size, size));
+    std::memset(ptr, 1, size);
+
+    // the contents are kept, and the added pages read as zeros
+    char * grown = static_cast<char *>(memres.reallocate(ptr, size, 100 * size));
+    ASSERT_EQUAL(grown != NULL, true);
+    ASSERT_EQUAL(thrust::count(grown, grown + size, 1), static_cast<std::ptrdiff_t>(size));
+    ASSERT_EQUAL(thrust::count(grown + 2 * size, grown + 100 * size, 0), static_cast<std::ptrdiff_t>(98 * size));
+
+    char * shrunk = static_cast<char *>(memres.reallocate(grown, 100 * size, size / 2));
+    ASSERT_EQUAL(shrunk, grown);
+    ASSERT_EQUAL(thrust::count(shrunk, shrunk + size / 2, 1), static_cast<std::ptrdiff_t>(size / 2));
+
+    memres.do_deallocate(shrunk, size / 2);
+}
+DECLARE_UNITTEST(TestMmapResourceReallocate);
+
+void TestMmapResourceVectorGrowth()
+{
+    typedef thrust::mr::allocator<int, thrust::mr::mmap_memory_resource> Alloc;
+
+    thrust::mr::mmap_memory_resource memres;
+    Alloc alloc(&memres);
+
+    thrust::host_vector<int, Alloc> v(alloc);
+    for (int i = 0; i < 1000000; ++i)
+    {
+        v.push_back(i);
+    }
+
+    // grown by remapping; elements appended past the old size are value-initialized
+    v.reserve(3000000);
+    v.resize(2000000);
+
+    ASSERT_EQUAL(v.capacity(), 3000000u);
+    for (int i = 0; i < 1000000; ++i)
+    {
+        ASSERT_EQUAL(v[i], i);
+    }
+    ASSERT_EQUAL(thrust::count(v.begin() + 1000000, v.end(), 0), 1000000);
+}
+DECLARE_UNITTEST(TestMmapResourceVectorGrowth);
+#endif
+#endif
@@ -0,0 +1,169 @@
+#include <unittest/unittest.h>
+
+#include <thrust/mr/monotonic_buffer.h>
+#include <thrust/mr/new.h>
+#include <thrust/mr/allocator.h>
+#include <thrust/sort.h>
+#include <thrust/execution_policy.h>
+#include <thrust/host_vector.h>
+
+class counting_resource final : public thrust::mr::memory_resource<>
+{
+public:
+    counting_resource() : allocations(0), deallocations(0)
+    {
+    }
+
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        return upstream.do_allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void * p, std::size_t bytes, std::size_t alignment) override
+    {
+        ++deallocations;
+        upstream.do_deallocate(p, bytes, alignment);
+    }
+
+    std::size_t allocations;
+    std::size_t deallocations;
+
+private:
+    thrust::mr::new_delete_resource upstream;
+};
+
+typedef thrust::mr::monotonic_buffer_resource<counting_resource> Arena;
+
+void TestMonotonicBuffer()
+{
+    counting_resource upstream;
+
+    {
+        Arena arena(&upstream, 1024);
+
+        char * a1 = static_cast<char *>(arena.do_allocate(100));
+        char * a2 = static_cast<char *>(arena.do_allocate(100));
+        ASSERT_EQUAL(upstream.allocations, 1u);
+        ASSERT_EQUAL(a2 >= a1 + 100, true);
+        ASSERT_EQUAL(reinterpret_cast<std::size_t>(a2) % THRUST_MR_DEFAULT_ALIGNMENT, 0u);
+
+        // overaligned requests are aligned as requested
+        void * a3 = arena.do_allocate(8, 256);
+        ASSERT_EQUAL(reinterpret_cast<std::size_t>(a3) % 256, 0u);
+
+        // deallocation is a no-op
+        arena.do_deallocate(a1, 100);
+        ASSERT_EQUAL(upstream.deallocations, 0u);
+
+        // requests bigger than the next chunk get a chunk of their own
+        void * a4 = arena.do_allocate(8192);
+        ASSERT_EQUAL(a4 != NULL, true);
+        ASSERT_EQUAL(upstream.allocations, 2u);
+
+        arena.release();
+        ASSERT_EQUAL(upstream.deallocations, 2u);
+
+        (void) arena.do_allocate(10);
+        ASSERT_EQUAL(upstream.allocations, 3u);
+    }
+
+    // the destructor releases everything
+    ASSERT_EQUAL(upstream.deallocations, 3u);
+}
+DECLARE_UNITTEST(TestMonotonicBuffer);
+
+void TestMonotonicBufferGrowth()
+{
+    counting_resource upstream;
+    Arena arena(&upstream, 1024);
+
+    // chunks grow geometrically, so many small allocations take few chunks
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        (void) arena.do_allocate(64);
+    }
+    ASSERT_LEQUAL(upstream.allocations, 7u);
+}
+DECLARE_UNITTEST(TestMonotonicBufferGrowth);
+
+void TestMonotonicBufferRewind()
+{
+    counting_resource upstream;
+    Arena arena(&upstream, 1024);
+
+    Arena::checkpoint_type start = arena.checkpoint();
+    void * kept = arena.do_allocate(100);
+
+    Arena::checkpoint_type point = arena.checkpoint();
+    void * first = arena.do_allocate(100);
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        (void) arena.do_allocate(100);
+    }
+    std::size_t allocations = upstream.allocations;
+
+    // memory allocated after the checkpoint is reused, and so are the chunks allocated since
+    arena.rewind(point);
+    ASSERT_EQUAL(arena.do_allocate(100), first);
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        (void) arena.do_allocate(100);
+    }
+    ASSERT_EQUAL(upstream.allocations, allocations);
+    ASSERT_EQUAL(upstream.deallocations, 0u);
+
+    // rewinding to before the first allocation reuses the first chunk
+    arena.rewind(start);
+    ASSERT_EQUAL(arena.do_allocate(100), kept);
+
+    {
+        Arena::scoped_rewind scope(arena);
+        (void) arena.do_allocate(100);
+    }
+    ASSERT_EQUAL(arena.do_allocate(100), first);
+}
+DECLARE_UNITTEST(TestMonotonicBufferRewind);
+
+void TestMonotonicBufferTemporaries()
+{
+    counting_resource upstream;
+    Arena arena(&upstream);
+
+    typedef thrust::mr::allocator<char, Arena> Alloc;
+    Alloc alloc(&arena);
+
+    // the sorts of the host systems allocate their temporaries through the policy
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP || THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+    auto policy = thrust::device(alloc);
+#else
+    auto policy = thrust::host(alloc);
+#endif
+
+    const int n = 100000;
+
+    std::size_t allocations = 0;
+    for (std::size_t round = 0; round < 4; ++round)
+    {
+        Arena::scoped_rewind scope(arena);
+
+        thrust::host_vector<int> data(n);
+        for (int i = 0; i < n; ++i)
+        {
+            data[i] = (i * 7919) % n;
+        }
+
+        thrust::sort(policy, data.begin(), data.end());
+        ASSERT_EQUAL(data[0], 0);
+        ASSERT_EQUAL(data[n - 1], n - 1);
+
+        // the temporaries of later rounds are served from the chunks of the first
+        if (round == 0)
+        {
+            allocations = upstream.allocations;
+            ASSERT_EQUAL(allocations > 0, true);
+        }
+        ASSERT_EQUAL(upstream.allocations, allocations);
+    }
+}
+DECLARE_UNITTEST(TestMonotonicBufferTemporaries);
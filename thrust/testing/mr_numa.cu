@@ -0,0 +1,50 @@
+#include <unittest/unittest.h>
+#include <thrust/mr/numa.h>
+
+#if defined(__linux__)
+#include <thrust/mr/allocator.h>
+#include <thrust/host_vector.h>
+#include <thrust/count.h>
+
+#include <cstring>
+
+void TestNumaResourcePlacements()
+{
+    ASSERT_GEQUAL(thrust::mr::numa_memory_resource::node_count(), 1u);
+
+    const thrust::mr::numa_memory_resource::placement placements[] = {
+        thrust::mr::numa_memory_resource::first_touch,
+        thrust::mr::numa_memory_resource::interleaved,
+        thrust::mr::numa_memory_resource::preferred_node,
+        thrust::mr::numa_memory_resource::bound_to_node
+    };
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        thrust::mr::numa_memory_resource memres(placements[i]);
+
+        const std::size_t size = 3 << 20;
+        char * ptr = static_cast<char *>(memres.do_allocate(size, 4096));
+        ASSERT_EQUAL(reinterpret_cast<std::size_t>(ptr) % 4096, 0u);
+        ASSERT_EQUAL(thrust::count(ptr, ptr + size, 0), static_cast<std::ptrdiff_t>(size));
+
+        std::memset(ptr, 1, size);
+        ASSERT_EQUAL(thrust::count(ptr, ptr + size, 1), static_cast<std::ptrdiff_t>(size));
+
+        memres.do_deallocate(ptr, size, 4096);
+    }
+}
+DECLARE_UNITTEST(TestNumaResourcePlacements);
+
+void TestNumaResourceVector()
+{
+    typedef thrust::mr::allocator<double, thrust::mr::numa_memory_resource> Alloc;
+
+    thrust::mr::numa_memory_resource memres;
+    Alloc alloc(&memres);
+
+    thrust::host_vector<double, Alloc> v(1 << 20, alloc);
+    ASSERT_EQUAL(thrust::count(v.begin(), v.end(), 0.0), 1 << 20);
+}
+DECLARE_UNITTEST(TestNumaResourceVector);
+#endif
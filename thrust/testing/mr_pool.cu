@@ -6,6 +6,10 @@
 
 #if _CCCL_STD_VER >= 2011
 #include <thrust/mr/sync_pool.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
 #endif
 
 template<typename T>
@@ -367,6 +371,130 @@ void TestSynchronizedPoolCachingOversized()
 DECLARE_UNITTEST(TestSynchronizedPoolCachingOversized);
 #endif
 
+template<template<typename> class PoolTemplate>
+void TestPoolTrimmingCachedOversized()
+{
+    tracked_resource upstream;
+
+    upstream.id_to_allocate = -1u;
+
+    typedef PoolTemplate<
+        tracked_resource
+    > Pool;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.cache_oversized = true;
+    opts.largest_block_size = 1024;
+    opts.max_cached_oversized_bytes = 2 * 2048;
+
+    Pool pool(&upstream, opts);
+
+    upstream.id_to_allocate = 1;
+    tracked_pointer<void> a1 = pool.do_allocate(2048);
+    upstream.id_to_allocate = 2;
+    tracked_pointer<void> a2 = pool.do_allocate(2048);
+    upstream.id_to_allocate = 3;
+    tracked_pointer<void> a3 = pool.do_allocate(2048);
+
+    pool.do_deallocate(a1, 2048);
+    pool.do_deallocate(a2, 2048);
+
+    // make sure that the least recently cached block is returned upstream when the cache goes over budget
+    upstream.id_to_deallocate = 1;
+    pool.do_deallocate(a3, 2048);
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+
+    tracked_pointer<void> a4 = pool.do_allocate(2048);
+    tracked_pointer<void> a5 = pool.do_allocate(2048);
+    ASSERT_EQUAL(a4.id + a5.id, 5u);
+
+    // make sure that there's nothing else in the cache
+    upstream.id_to_allocate = 4;
+    tracked_pointer<void> a6 = pool.do_allocate(2048);
+    ASSERT_EQUAL(a6.id, 4u);
+
+    pool.do_deallocate(a4, 2048);
+    pool.do_deallocate(a5, 2048);
+    pool.do_deallocate(a6, 2048);
+}
+
+void TestUnsynchronizedPoolTrimmingCachedOversized()
+{
+    TestPoolTrimmingCachedOversized<thrust::mr::unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestUnsynchronizedPoolTrimmingCachedOversized);
+
+#if _CCCL_STD_VER >= 2011
+void TestSynchronizedPoolTrimmingCachedOversized()
+{
+    TestPoolTrimmingCachedOversized<thrust::mr::synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestSynchronizedPoolTrimmingCachedOversized);
+#endif
+
+template<template<typename> class PoolTemplate>
+void TestPoolSizeClasses()
+{
+    typedef PoolTemplate<
+        thrust::mr::new_delete_resource
+    > Pool;
+
+    thrust::mr::new_delete_resource upstream;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.size_classes_per_doubling = 4;
+
+    Pool pool(&upstream, opts);
+
+    // just above a power of two, a block of 1.25 times it is used, rather than twice it
+    void * a1 = pool.do_allocate(1126);
+    thrust::mr::pool_fragmentation_statistics s = pool.fragmentation_statistics();
+    ASSERT_EQUAL(s.requested_bytes, 1126u);
+    ASSERT_EQUAL(s.allocated_bytes, 1280u);
+    ASSERT_LEQUAL(s.allocated_bytes, s.pooled_bytes);
+
+    void * a2 = pool.do_allocate(1300);
+    void * a3 = pool.do_allocate(1280);
+    s = pool.fragmentation_statistics();
+    ASSERT_EQUAL(s.requested_bytes, 1126u + 1300u + 1280u);
+    ASSERT_EQUAL(s.allocated_bytes, 1280u + 1536u + 1280u);
+
+    // blocks of the same class are reused for requests of different sizes
+    pool.do_deallocate(a1, 1126);
+    void * a4 = pool.do_allocate(1200);
+    ASSERT_EQUAL(a4, a1);
+
+    pool.do_deallocate(a2, 1300);
+    pool.do_deallocate(a3, 1280);
+    pool.do_deallocate(a4, 1200);
+
+    s = pool.fragmentation_statistics();
+    ASSERT_EQUAL(s.requested_bytes, 0u);
+    ASSERT_EQUAL(s.allocated_bytes, 0u);
+
+    // with one class per doubling, block sizes are powers of two
+    opts.size_classes_per_doubling = 1;
+    Pool power_of_two_pool(&upstream, opts);
+
+    void * a5 = power_of_two_pool.do_allocate(1126);
+    ASSERT_EQUAL(power_of_two_pool.fragmentation_statistics().allocated_bytes, 2048u);
+    power_of_two_pool.do_deallocate(a5, 1126);
+}
+
+void TestUnsynchronizedPoolSizeClasses()
+{
+    TestPoolSizeClasses<thrust::mr::unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestUnsynchronizedPoolSizeClasses);
+
+#if _CCCL_STD_VER >= 2011
+void TestSynchronizedPoolSizeClasses()
+{
+    TestPoolSizeClasses<thrust::mr::synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestSynchronizedPoolSizeClasses);
+#endif
+
 template<template<typename> class PoolTemplate>
 void TestGlobalPool()
 {
@@ -391,3 +519,145 @@ void TestSynchronizedGlobalPool()
 DECLARE_UNITTEST(TestSynchronizedGlobalPool);
 #endif
 
+
+#if _CCCL_STD_VER >= 2011
+template<typename Pool>
+void TestPoolConcurrentUseHelper(Pool & pool)
+{
+    const std::size_t num_threads = 8;
+    const std::size_t num_blocks = 512;
+    const std::size_t sizes[] = { 8, 24, 100, 3000, 40000, 2 << 20 };
+
+    std::vector<std::vector<void *> > blocks(num_threads);
+    std::vector<int> ok(num_threads, 1);
+
+    // every thread fills blocks of all sizes, pooled and oversized, with its index...
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t]{
+            for (std::size_t i = 0; i < num_blocks; ++i)
+            {
+                std::size_t size = sizes[i % 6];
+                void * p = pool.do_allocate(size);
+                std::memset(p, static_cast<int>(t), size);
+                blocks[t].push_back(p);
+
+                // ...freeing some of them right away...
+                if (i % 3 == 0)
+                {
+                    pool.do_deallocate(blocks[t][i / 2], sizes[(i / 2) % 6]);
+                    blocks[t][i / 2] = NULL;
+                }
+            }
+        });
+    }
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+        threads[t].join();
+    }
+    threads.clear();
+
+    // ...and then the next thread checks and frees the rest
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t]{
+            std::size_t owner = (t + 1) % num_threads;
+            for (std::size_t i = 0; i < num_blocks; ++i)
+            {
+                unsigned char * p = static_cast<unsigned char *>(blocks[owner][i]);
+                if (p == NULL)
+                {
+                    continue;
+                }
+
+                std::size_t size = sizes[i % 6];
+                for (std::size_t j = 0; j < size; ++j)
+                {
+                    if (p[j] != owner)
+                    {
+                        ok[t] = 0;
+                    }
+                }
+                pool.do_deallocate(p, size);
+            }
+        });
+    }
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+        threads[t].join();
+        ASSERT_EQUAL(ok[t], 1);
+    }
+}
+
+void TestSynchronizedPoolConcurrentUse()
+{
+    typedef thrust::mr::synchronized_pool_resource<thrust::mr::new_delete_resource> Pool;
+
+    thrust::mr::new_delete_resource upstream;
+
+    for (std::size_t num_shards = 1; num_shards <= 8; num_shards *= 8)
+    {
+        Pool pool(&upstream, Pool::get_default_options(), num_shards);
+
+        TestPoolConcurrentUseHelper(pool);
+        TestPoolConcurrentUseHelper(pool);
+
+        pool.release();
+        TestPoolConcurrentUseHelper(pool);
+    }
+}
+DECLARE_UNITTEST(TestSynchronizedPoolConcurrentUse);
+
+void TestSynchronizedPoolConcurrentLargeBlocks()
+{
+    typedef thrust::mr::synchronized_pool_resource<thrust::mr::new_delete_resource> Pool;
+
+    const std::size_t num_threads = 8;
+    const std::size_t num_rounds = 200;
+    // larger than the bytes a shard caches of a size class, but pooled
+    const std::size_t sizes[] = { 40000, 100000, 300000 };
+
+    thrust::mr::new_delete_resource upstream;
+
+    for (std::size_t num_shards = 1; num_shards <= 8; num_shards *= 8)
+    {
+        Pool pool(&upstream, Pool::get_default_options(), num_shards);
+
+        std::vector<int> ok(num_threads, 1);
+        std::vector<std::thread> threads;
+
+        // every thread allocates, fills, checks and frees large blocks at the same time as the others
+        for (std::size_t t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back([&, t]{
+                for (std::size_t i = 0; i < num_rounds; ++i)
+                {
+                    std::size_t size = sizes[(i + t) % 3];
+                    unsigned char * p = static_cast<unsigned char *>(pool.do_allocate(size));
+                    std::memset(p, static_cast<int>(t), size);
+                    for (std::size_t j = 0; j < size; j += 4096)
+                    {
+                        if (p[j] != t)
+                        {
+                            ok[t] = 0;
+                        }
+                    }
+                    pool.do_deallocate(p, size);
+                }
+            });
+        }
+        for (std::size_t t = 0; t < num_threads; ++t)
+        {
+            threads[t].join();
+            ASSERT_EQUAL(ok[t], 1);
+        }
+
+        // the blocks cached in shards count as free
+        thrust::mr::pool_fragmentation_statistics stats = pool.fragmentation_statistics();
+        ASSERT_EQUAL(stats.requested_bytes, 0u);
+        ASSERT_EQUAL(stats.allocated_bytes, 0u);
+    }
+}
+DECLARE_UNITTEST(TestSynchronizedPoolConcurrentLargeBlocks);
+#endif
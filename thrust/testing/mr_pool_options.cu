@@ -1,5 +1,8 @@
 #include <unittest/unittest.h>
 #include <thrust/mr/pool_options.h>
+#include <thrust/mr/detail/size_classes.h>
+
+#include <vector>
 
 void TestPoolOptionsBasicValidity()
 {
@@ -61,3 +64,43 @@ void TestPoolOptionsComplexValidity()
     ASSERT_EQUAL(options.validate(), true);
 }
 DECLARE_UNITTEST(TestPoolOptionsComplexValidity);
+
+void TestPoolOptionsSizeClasses()
+{
+    thrust::mr::pool_options options = thrust::mr::pool_options();
+    options.max_blocks_per_chunk = 1024;
+    options.max_bytes_per_chunk = 1024 * 1024;
+    options.smallest_block_size = 8;
+    options.largest_block_size = 1024;
+    options.alignment = 8;
+    ASSERT_EQUAL(options.validate(), true);
+
+    // the number of classes per doubling isn't a power of two
+    options.size_classes_per_doubling = 3;
+    ASSERT_EQUAL(options.validate(), false);
+    // the classes of the smallest doubling would be smaller than a byte apart
+    options.size_classes_per_doubling = 16;
+    ASSERT_EQUAL(options.validate(), false);
+    options.size_classes_per_doubling = 4;
+    ASSERT_EQUAL(options.validate(), true);
+
+    typedef thrust::detail::size_class_table<std::vector<std::size_t> > table_type;
+    table_type table(options, std::allocator<std::size_t>());
+
+    // 8, 16, 24, 32, 40, 48, 56, 64, 80, ..., 1024; below 32, classes are rounded up to the alignment and merged
+    ASSERT_EQUAL(table.size(), 1u + 1u + 2u + 5u * 4u);
+    ASSERT_EQUAL(table.class_size(0), 8u);
+    ASSERT_EQUAL(table.class_size(table.size() - 1), 1024u);
+
+    // every request maps to the smallest class that fits it
+    std::size_t size_class = 0;
+    for (std::size_t bytes = 1; bytes <= 1024; ++bytes)
+    {
+        if (bytes > table.class_size(size_class))
+        {
+            ++size_class;
+        }
+        ASSERT_EQUAL(table.class_of(bytes), size_class);
+    }
+}
+DECLARE_UNITTEST(TestPoolOptionsSizeClasses);
@@ -0,0 +1,179 @@
+#include <unittest/unittest.h>
+
+#include <thrust/detail/config.h>
+#include <thrust/mr/new.h>
+
+#if _CCCL_STD_VER >= 2011
+#include <thrust/mr/statistics.h>
+#include <thrust/mr/pool.h>
+#include <thrust/mr/allocator.h>
+#include <thrust/execution_policy.h>
+#include <thrust/host_vector.h>
+#include <thrust/sort.h>
+
+#include <sstream>
+#include <string>
+
+typedef thrust::mr::statistics_resource<thrust::mr::new_delete_resource> Stats;
+
+void TestStatisticsResource()
+{
+    thrust::mr::new_delete_resource upstream;
+    Stats stats(&upstream);
+
+    void * a1 = stats.do_allocate(100);
+    void * a2 = stats.do_allocate(3000, 64);
+
+    thrust::mr::allocation_statistics s = stats.statistics();
+    ASSERT_EQUAL(s.allocations, 2u);
+    ASSERT_EQUAL(s.bytes_allocated, 3100u);
+    ASSERT_EQUAL(s.live_blocks, 2u);
+    ASSERT_EQUAL(s.live_bytes, 3100u);
+    ASSERT_EQUAL(s.allocations_by_size_class[6], 1u);
+    ASSERT_EQUAL(s.allocations_by_size_class[11], 1u);
+    ASSERT_EQUAL(s.bytes_by_size_class[11], 3000u);
+
+    std::size_t latencies = 0;
+    for (std::size_t i = 0; i < thrust::mr::allocation_statistics::num_classes; ++i)
+    {
+        latencies += s.allocations_by_latency_class[i];
+    }
+    ASSERT_EQUAL(latencies, 2u);
+
+    stats.do_deallocate(a2, 3000, 64);
+    void * a3 = stats.do_allocate(10);
+
+    s = stats.statistics();
+    ASSERT_EQUAL(s.deallocations, 1u);
+    ASSERT_EQUAL(s.live_blocks, 2u);
+    ASSERT_EQUAL(s.live_bytes, 110u);
+    ASSERT_EQUAL(s.peak_live_bytes, 3100u);
+
+    // resetting keeps track of live blocks
+    stats.reset();
+    s = stats.statistics();
+    ASSERT_EQUAL(s.allocations, 0u);
+    ASSERT_EQUAL(s.live_blocks, 2u);
+    ASSERT_EQUAL(s.peak_live_bytes, 110u);
+
+    stats.do_deallocate(a1, 100);
+    stats.do_deallocate(a3, 10);
+    ASSERT_EQUAL(stats.statistics().live_bytes, 0u);
+}
+DECLARE_UNITTEST(TestStatisticsResource);
+
+void TestStatisticsResourceTrace()
+{
+    thrust::mr::new_delete_resource upstream;
+    Stats stats(&upstream);
+
+    void * untraced = stats.do_allocate(8);
+
+    stats.set_tracing(true);
+    std::uintptr_t address = 0;
+    {
+        Stats::scoped_tag outer("outer");
+        void * q = stats.do_allocate(32);
+        {
+            Stats::scoped_tag inner("inner");
+            void * p = stats.do_allocate(16);
+            address = reinterpret_cast<std::uintptr_t>(p);
+            stats.do_deallocate(p, 16);
+        }
+        stats.do_deallocate(q, 32);
+    }
+    stats.do_deallocate(untraced, 8);
+
+    std::vector<Stats::trace_entry> trace = stats.trace();
+    ASSERT_EQUAL(trace.size(), 5u);
+    ASSERT_EQUAL(trace[0].allocation, true);
+    ASSERT_EQUAL(std::string(trace[0].tag), "outer");
+    ASSERT_EQUAL(trace[1].bytes, 16u);
+    ASSERT_EQUAL(std::string(trace[1].tag), "inner");
+    ASSERT_EQUAL(trace[1].address, address);
+    ASSERT_EQUAL(trace[2].allocation, false);
+    ASSERT_EQUAL(std::string(trace[2].tag), "inner");
+    // tags are restored when scopes end
+    ASSERT_EQUAL(std::string(trace[3].tag), "outer");
+    ASSERT_EQUAL(trace[4].tag == NULL, true);
+
+    std::ostringstream os;
+    stats.dump_trace(os);
+    ASSERT_EQUAL(os.str().find("allocate tag=outer bytes=32") == 0, true);
+
+    stats.clear_trace();
+    ASSERT_EQUAL(stats.trace().size(), 0u);
+}
+DECLARE_UNITTEST(TestStatisticsResourceTrace);
+
+void TestStatisticsResourceTagsAcrossUpstreams()
+{
+    thrust::mr::new_delete_resource upstream;
+    Stats inner(&upstream);
+    thrust::mr::statistics_resource<Stats> outer(&inner);
+
+    inner.set_tracing(true);
+    outer.set_tracing(true);
+
+    // a tag set through one instantiation applies to resources over any upstream
+    {
+        Stats::scoped_tag tag("shared");
+        void * p = outer.do_allocate(16);
+        outer.do_deallocate(p, 16);
+    }
+
+    ASSERT_EQUAL(outer.trace().size(), 2u);
+    ASSERT_EQUAL(inner.trace().size(), 2u);
+    ASSERT_EQUAL(std::string(outer.trace()[0].tag), "shared");
+    ASSERT_EQUAL(std::string(inner.trace()[0].tag), "shared");
+}
+DECLARE_UNITTEST(TestStatisticsResourceTagsAcrossUpstreams);
+
+void TestStatisticsResourceUnderPool()
+{
+    thrust::mr::new_delete_resource upstream;
+    Stats stats(&upstream);
+
+    {
+        thrust::mr::unsynchronized_pool_resource<Stats> pool(&stats);
+
+        void * p = pool.do_allocate(64);
+        pool.do_deallocate(p, 64);
+        std::size_t allocations = stats.statistics().allocations;
+        ASSERT_LESS(0u, allocations);
+
+        // the pool serves the rest from the chunk it already took
+        for (std::size_t i = 0; i < 100; ++i)
+        {
+            p = pool.do_allocate(64);
+            pool.do_deallocate(p, 64);
+        }
+        ASSERT_EQUAL(stats.statistics().allocations, allocations);
+    }
+
+    ASSERT_EQUAL(stats.statistics().live_blocks, 0u);
+}
+DECLARE_UNITTEST(TestStatisticsResourceUnderPool);
+
+void TestStatisticsResourceTemporaries()
+{
+    Stats stats;
+    thrust::mr::allocator<char, Stats> alloc(&stats);
+
+    thrust::host_vector<int> v(10000);
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+        v[i] = static_cast<int>((i * 7919) % 10000);
+    }
+
+    stats.reset();
+    thrust::sort(thrust::host(alloc), v.begin(), v.end());
+
+    thrust::mr::allocation_statistics s = stats.statistics();
+    ASSERT_EQUAL(s.allocations, s.deallocations);
+    ASSERT_EQUAL(s.live_bytes, 0u);
+    ASSERT_EQUAL(v[0], 0);
+    ASSERT_EQUAL(v[9999], 9999);
+}
+DECLARE_UNITTEST(TestStatisticsResourceTemporaries);
+#endif
@@ -0,0 +1,154 @@
+#include <unittest/unittest.h>
+
+#include <thrust/detail/config.h>
+#include <thrust/mr/new.h>
+
+#if _CCCL_STD_VER >= 2011
+#include <thrust/mr/thread_caching_pool.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+typedef thrust::mr::thread_caching_pool_resource<thrust::mr::new_delete_resource> Pool;
+
+void TestThreadCachingPool()
+{
+    thrust::mr::new_delete_resource upstream;
+    Pool pool(&upstream);
+
+    void * a1 = pool.do_allocate(12);
+    void * a2 = pool.do_allocate(16);
+    ASSERT_EQUAL(a1 != a2, true);
+    ASSERT_EQUAL(reinterpret_cast<std::size_t>(a1) % THRUST_MR_DEFAULT_ALIGNMENT, 0u);
+    ASSERT_EQUAL(reinterpret_cast<std::size_t>(a2) % THRUST_MR_DEFAULT_ALIGNMENT, 0u);
+
+    // deallocating and allocating back should give the same block back
+    pool.do_deallocate(a1, 12);
+    void * a3 = pool.do_allocate(12);
+    ASSERT_EQUAL(a1, a3);
+
+    // overaligned blocks are aligned as requested
+    void * a4 = pool.do_allocate(32, THRUST_MR_DEFAULT_ALIGNMENT * 4);
+    ASSERT_EQUAL(reinterpret_cast<std::size_t>(a4) % (THRUST_MR_DEFAULT_ALIGNMENT * 4), 0u);
+    pool.do_deallocate(a4, 32, THRUST_MR_DEFAULT_ALIGNMENT * 4);
+
+    pool.do_deallocate(a2, 16);
+    pool.do_deallocate(a3, 12);
+}
+DECLARE_UNITTEST(TestThreadCachingPool);
+
+void TestThreadCachingPoolRemoteDeallocation()
+{
+    thrust::mr::new_delete_resource upstream;
+    Pool pool(&upstream);
+
+    void * block = pool.do_allocate(64);
+
+    // a block deallocated by another thread...
+    std::thread([&]{ pool.do_deallocate(block, 64); }).join();
+
+    // ...returns to the pool of its owner at its next allocation
+    ASSERT_EQUAL(pool.do_allocate(64), block);
+
+    pool.do_deallocate(block, 64);
+}
+DECLARE_UNITTEST(TestThreadCachingPoolRemoteDeallocation);
+
+void TestThreadCachingPoolAdoptsHeapsOfExitedThreads()
+{
+    thrust::mr::new_delete_resource upstream;
+    Pool pool(&upstream);
+
+    void * block = NULL;
+    std::thread([&]{ block = pool.do_allocate(64); }).join();
+
+    // a block deallocated after its owner exited...
+    pool.do_deallocate(block, 64);
+
+    // ...is drained by the next thread, which adopts the pool of the exited one
+    void * adopted = NULL;
+    std::thread([&]{ adopted = pool.do_allocate(64); }).join();
+    ASSERT_EQUAL(adopted, block);
+
+    pool.do_deallocate(adopted, 64);
+}
+DECLARE_UNITTEST(TestThreadCachingPoolAdoptsHeapsOfExitedThreads);
+
+void TestThreadCachingPoolProducerConsumer()
+{
+    thrust::mr::new_delete_resource upstream;
+    Pool pool(&upstream);
+
+    const std::size_t num_threads = 8;
+    const std::size_t num_rounds = 16;
+    const std::size_t num_blocks = 256;
+    const std::size_t sizes[] = { 8, 100, 3000, 2 << 20 };
+
+    std::vector<int> ok(num_threads, 1);
+
+    // in every round, every thread fills blocks with its index, and the next thread checks and frees them
+    for (std::size_t round = 0; round < num_rounds; ++round)
+    {
+        std::vector<std::vector<void *> > blocks(num_threads);
+
+        std::vector<std::thread> producers;
+        for (std::size_t t = 0; t < num_threads; ++t)
+        {
+            producers.emplace_back([&, t]{
+                for (std::size_t i = 0; i < num_blocks; ++i)
+                {
+                    void * p = pool.do_allocate(sizes[i % 4]);
+                    std::memset(p, static_cast<int>(t), sizes[i % 4]);
+                    blocks[t].push_back(p);
+                }
+            });
+        }
+        for (std::size_t t = 0; t < num_threads; ++t)
+        {
+            producers[t].join();
+        }
+
+        std::vector<std::thread> consumers;
+        for (std::size_t t = 0; t < num_threads; ++t)
+        {
+            consumers.emplace_back([&, t]{
+                std::size_t owner = (t + 1) % num_threads;
+                for (std::size_t i = 0; i < num_blocks; ++i)
+                {
+                    unsigned char * p = static_cast<unsigned char *>(blocks[owner][i]);
+                    for (std::size_t j = 0; j < sizes[i % 4]; ++j)
+                    {
+                        if (p[j] != owner)
+                        {
+                            ok[t] = 0;
+                        }
+                    }
+                    pool.do_deallocate(p, sizes[i % 4]);
+                }
+            });
+        }
+        for (std::size_t t = 0; t < num_threads; ++t)
+        {
+            consumers[t].join();
+        }
+    }
+
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+        ASSERT_EQUAL(ok[t], 1);
+    }
+
+    pool.release();
+
+    void * p = pool.do_allocate(100);
+    pool.do_deallocate(p, 100);
+}
+DECLARE_UNITTEST(TestThreadCachingPoolProducerConsumer);
+
+void TestThreadCachingGlobalPool()
+{
+    ASSERT_EQUAL(thrust::mr::get_global_resource<Pool>() != NULL, true);
+}
+DECLARE_UNITTEST(TestThreadCachingGlobalPool);
+#endif
@@ -0,0 +1,65 @@
+#include <unittest/unittest.h>
+
+#include <thrust/detail/config.h>
+
+#if _CCCL_STD_VER >= 2011
+#include <thrust/host_unordered_map.h>
+#include <thrust/host_unordered_set.h>
+#include <thrust/host_vector.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/count.h>
+#include <thrust/functional.h>
+
+void TestOmpHostUnorderedMapInsertOrReduce()
+{
+  const int n = 1 << 20;
+  const int num_keys = 1000;
+
+  thrust::host_vector<long long> keys(n);
+  thrust::host_vector<long long> values(n);
+  for(int i = 0; i < n; ++i)
+  {
+    keys[i] = (i * 7919ll) % num_keys;
+    values[i] = i;
+  }
+
+  // every key is reduced into by many threads at once
+  thrust::host_unordered_map<long long, long long> sums;
+  ASSERT_EQUAL(sums.insert_or_reduce(thrust::omp::par, keys.begin(), keys.end(), values.begin(), thrust::plus<long long>()), static_cast<std::size_t>(num_keys));
+
+  thrust::host_vector<long long> expected(num_keys, 0);
+  for(int i = 0; i < n; ++i)
+  {
+    expected[keys[i]] += values[i];
+  }
+
+  thrust::host_vector<long long> unique_keys(num_keys);
+  thrust::host_vector<long long> totals(num_keys);
+  sums.retrieve_all(thrust::omp::par, unique_keys.begin(), totals.begin());
+
+  for(int i = 0; i < num_keys; ++i)
+  {
+    ASSERT_EQUAL(totals[i], expected[unique_keys[i]]);
+  }
+}
+DECLARE_UNITTEST(TestOmpHostUnorderedMapInsertOrReduce);
+
+void TestOmpHostUnorderedSet()
+{
+  const int n = 1 << 20;
+
+  thrust::host_vector<int> keys(n);
+  for(int i = 0; i < n; ++i)
+  {
+    keys[i] = i / 4;
+  }
+
+  thrust::host_unordered_set<int> set;
+  ASSERT_EQUAL(set.bulk_insert(thrust::omp::par, keys.begin(), keys.end()), static_cast<std::size_t>(n / 4));
+
+  thrust::host_vector<bool> contained(n);
+  set.bulk_contains(thrust::omp::par, keys.begin(), keys.end(), contained.begin());
+  ASSERT_EQUAL(thrust::count(contained.begin(), contained.end(), true), n);
+}
+DECLARE_UNITTEST(TestOmpHostUnorderedSet);
+#endif
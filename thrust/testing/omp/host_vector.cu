@@ -0,0 +1,72 @@
+#include <unittest/unittest.h>
+
+#include <thrust/system/omp/vector.h>
+
+#include <omp.h>
+
+#include <vector>
+
+// records the thread which last constructed or assigned it
+struct written_by
+{
+  int thread;
+
+  written_by() : thread(current()) {}
+
+  written_by(const written_by &) : thread(current()) {}
+
+  written_by &operator=(const written_by &)
+  {
+    thread = current();
+    return *this;
+  }
+
+  static int current()
+  {
+    return omp_in_parallel() ? omp_get_thread_num() : -1;
+  }
+};
+
+// construction, copies and fills are done in parallel
+void TestOmpHostVectorInParallel(void)
+{
+  const int n = 1 << 16;
+
+  if (omp_get_max_threads() < 2)
+  {
+    return;
+  }
+
+  thrust::omp::host_vector<written_by> v(n);
+  ASSERT_EQUAL(v[0].thread, 0);
+  ASSERT_LESS(0, v[n - 1].thread);
+
+  std::vector<written_by> input(n);
+  thrust::omp::host_vector<written_by> copy(input.begin(), input.end());
+  ASSERT_LESS(0, copy[n - 1].thread);
+
+  v.assign(n / 2, written_by());
+  ASSERT_LESS(0, v[n / 2 - 1].thread);
+
+  v = copy;
+  ASSERT_LESS(0, v[n - 1].thread);
+}
+DECLARE_UNITTEST(TestOmpHostVectorInParallel);
+
+void TestOmpHostVector(void)
+{
+  thrust::omp::host_vector<int> v(1000, 7);
+  ASSERT_EQUAL(v[999], 7);
+
+  thrust::host_vector<int> h(v);
+  ASSERT_EQUAL(h[999], 7);
+
+  thrust::omp::host_vector<int> u(2000, thrust::default_init);
+  u = h;
+  ASSERT_EQUAL(u.size(), 1000lu);
+  ASSERT_EQUAL(u[999], 7);
+
+  u.resize(3000, 8);
+  ASSERT_EQUAL(u[2999], 8);
+}
+DECLARE_UNITTEST(TestOmpHostVector);
@@ -0,0 +1,123 @@
+#include <unittest/unittest.h>
+
+#include <thrust/count.h>
+#include <thrust/extrema.h>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/sort.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include <omp.h>
+
+struct record_thread
+{
+  int *thread_of;
+
+  record_thread(int *thread_of) : thread_of(thread_of) {}
+
+  void operator()(int i) const
+  {
+    thread_of[i] = omp_in_parallel() ? omp_get_thread_num() : -1;
+  }
+};
+
+void TestOmpParWithNumThreads(void)
+{
+  const int n = 1 << 16;
+
+  thrust::host_vector<int> thread_of(n);
+  int *raw_thread_of = thrust::raw_pointer_cast(thread_of.data());
+
+  thrust::for_each(thrust::omp::par.with(2, thrust::omp::schedule_static, 1),
+                   thrust::counting_iterator<int>(0),
+                   thrust::counting_iterator<int>(n),
+                   record_thread(raw_thread_of));
+
+  ASSERT_EQUAL(*thrust::min_element(thread_of.begin(), thread_of.end()) >= 0, true);
+  ASSERT_EQUAL(*thrust::max_element(thread_of.begin(), thread_of.end()) < 2, true);
+}
+DECLARE_UNITTEST(TestOmpParWithNumThreads);
+
+void TestOmpParWithMinElementsPerThread(void)
+{
+  const int n = 1 << 16;
+
+  thrust::host_vector<int> thread_of(n);
+  int *raw_thread_of = thrust::raw_pointer_cast(thread_of.data());
+
+  // too few elements for a second thread, so no parallel region is entered
+  thrust::for_each(thrust::omp::par.with(4, thrust::omp::schedule_static, n),
+                   thrust::counting_iterator<int>(0),
+                   thrust::counting_iterator<int>(n),
+                   record_thread(raw_thread_of));
+
+  ASSERT_EQUAL(thrust::count(thread_of.begin(), thread_of.end(), -1), n);
+}
+DECLARE_UNITTEST(TestOmpParWithMinElementsPerThread);
+
+void TestOmpParForEachSmallInput(void)
+{
+  const int n = 64;
+
+  thrust::host_vector<int> thread_of(n);
+  int *raw_thread_of = thrust::raw_pointer_cast(thread_of.data());
+
+  // elementwise loops have no minimum unless the policy asks for one, so
+  // even small inputs of possibly heavy functors run in parallel
+  thrust::for_each(thrust::omp::par,
+                   thrust::counting_iterator<int>(0),
+                   thrust::counting_iterator<int>(n),
+                   record_thread(raw_thread_of));
+
+  if (omp_get_max_threads() > 1)
+  {
+    ASSERT_EQUAL(thrust::count(thread_of.begin(), thread_of.end(), -1), 0);
+  }
+}
+DECLARE_UNITTEST(TestOmpParForEachSmallInput);
+
+template <typename T>
+struct TestOmpParWithAlgorithms
+{
+  void operator()(const size_t n)
+  {
+    thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+
+    T ref_sum = thrust::reduce(thrust::cpp::par, h_data.begin(), h_data.end());
+
+    thrust::host_vector<T> ref_scan(n);
+    thrust::inclusive_scan(thrust::cpp::par, h_data.begin(), h_data.end(), ref_scan.begin());
+
+    thrust::host_vector<T> ref_sorted = h_data;
+    thrust::stable_sort(thrust::cpp::par, ref_sorted.begin(), ref_sorted.end());
+
+    const thrust::omp::schedule_kind schedules[] = {
+      thrust::omp::schedule_static, thrust::omp::schedule_dynamic, thrust::omp::schedule_guided};
+
+    for (int num_threads = 1; num_threads <= 3; ++num_threads)
+    {
+      for (int s = 0; s < 3; ++s)
+      {
+        for (size_t min_elements = 1; min_elements <= 1 << 16; min_elements <<= 8)
+        {
+          T sum = thrust::reduce(
+            thrust::omp::par.with(num_threads, schedules[s], min_elements), h_data.begin(), h_data.end());
+          ASSERT_EQUAL(ref_sum, sum);
+
+          thrust::host_vector<T> scan(n);
+          thrust::inclusive_scan(
+            thrust::omp::par.with(num_threads, schedules[s], min_elements), h_data.begin(), h_data.end(), scan.begin());
+          ASSERT_EQUAL(ref_scan, scan);
+
+          thrust::host_vector<T> sorted = h_data;
+          thrust::stable_sort(
+            thrust::omp::par.with(num_threads, schedules[s], min_elements), sorted.begin(), sorted.end());
+          ASSERT_EQUAL(ref_sorted, sorted);
+        }
+      }
+    }
+  }
+};
+VariableUnitTest<TestOmpParWithAlgorithms, IntegralTypes> TestOmpParWithAlgorithmsInstance;
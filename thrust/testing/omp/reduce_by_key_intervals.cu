@@ -0,0 +1,104 @@
+#include <unittest/unittest.h>
+
+#include <thrust/functional.h>
+#include <thrust/reduce.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/detail/reduce_by_key.h>
+
+// long runs of equal keys, which span several intervals, interrupted by
+// runs of length one
+template<typename Vector>
+void initialize_keys(Vector& keys, const size_t n)
+{
+  thrust::host_vector<unsigned int> r = unittest::random_integers<unsigned int>(n);
+
+  thrust::host_vector<int> h_keys(n);
+  for(size_t i = 0; i < n; ++i)
+  {
+    h_keys[i] = (r[i] % 8 == 0) ? -static_cast<int>(i) : static_cast<int>(i / 25);
+  }
+
+  keys = h_keys;
+}
+
+
+template<typename T>
+struct TestOmpReduceByKeyIntervals
+{
+  void operator()(const size_t n)
+  {
+    using thrust::system::omp::detail::reduce_by_key_detail::reduce_by_key_intervals;
+    using thrust::system::detail::internal::uniform_decomposition;
+
+    thrust::host_vector<int>   h_keys;
+    thrust::device_vector<int> d_keys;
+    initialize_keys(h_keys, n);
+    d_keys = h_keys;
+
+    thrust::host_vector<T>   h_values = unittest::random_integers<T>(n);
+    thrust::device_vector<T> d_values = h_values;
+
+    thrust::host_vector<int>   h_keys_output(n);
+    thrust::device_vector<int> d_keys_output(n);
+    thrust::host_vector<T>     h_values_output(n);
+    thrust::device_vector<T>   d_values_output(n);
+
+    thrust::system::omp::tag omp_tag;
+    uniform_decomposition<size_t> decomp(n, 3, 100);
+
+    typedef typename thrust::host_vector<int>::iterator   HostKeyIterator;
+    typedef typename thrust::host_vector<T>::iterator     HostValueIterator;
+    typedef typename thrust::device_vector<int>::iterator DeviceKeyIterator;
+    typedef typename thrust::device_vector<T>::iterator   DeviceValueIterator;
+
+    thrust::pair<HostKeyIterator,HostValueIterator> h_last =
+      thrust::reduce_by_key(h_keys.begin(), h_keys.end(), h_values.begin(),
+                            h_keys_output.begin(), h_values_output.begin(),
+                            thrust::equal_to<int>(), thrust::plus<T>());
+
+    thrust::pair<DeviceKeyIterator,DeviceValueIterator> d_last =
+      reduce_by_key_intervals(omp_tag, d_keys.begin(), d_values.begin(),
+                              d_keys_output.begin(), d_values_output.begin(),
+                              thrust::equal_to<int>(), thrust::plus<T>(), decomp);
+
+    ASSERT_EQUAL(h_last.first  - h_keys_output.begin(),   d_last.first  - d_keys_output.begin());
+    ASSERT_EQUAL(h_last.second - h_values_output.begin(), d_last.second - d_values_output.begin());
+
+    h_keys_output.resize(h_last.first - h_keys_output.begin());
+    d_keys_output.resize(d_last.first - d_keys_output.begin());
+    h_values_output.resize(h_last.second - h_values_output.begin());
+    d_values_output.resize(d_last.second - d_values_output.begin());
+
+    ASSERT_EQUAL(h_keys_output,   d_keys_output);
+    ASSERT_EQUAL(h_values_output, d_values_output);
+  }
+};
+VariableUnitTest<TestOmpReduceByKeyIntervals, IntegralTypes> TestOmpReduceByKeyIntervalsInstance;
+
+
+void TestOmpReduceByKeyIntervalsSingleSegment(void)
+{
+  using thrust::system::omp::detail::reduce_by_key_detail::reduce_by_key_intervals;
+  using thrust::system::detail::internal::uniform_decomposition;
+
+  const size_t n = 1000;
+
+  thrust::device_vector<int> d_keys(n, 7);
+  thrust::device_vector<int> d_values(n, 1);
+  thrust::device_vector<int> d_keys_output(n);
+  thrust::device_vector<int> d_values_output(n);
+
+  thrust::system::omp::tag omp_tag;
+  uniform_decomposition<size_t> decomp(n, 3, 64);
+
+  thrust::pair<thrust::device_vector<int>::iterator, thrust::device_vector<int>::iterator> last =
+    reduce_by_key_intervals(omp_tag, d_keys.begin(), d_values.begin(),
+                            d_keys_output.begin(), d_values_output.begin(),
+                            thrust::equal_to<int>(), thrust::plus<int>(), decomp);
+
+  ASSERT_EQUAL(last.first  - d_keys_output.begin(),   1);
+  ASSERT_EQUAL(last.second - d_values_output.begin(), 1);
+  ASSERT_EQUAL(d_keys_output[0],   7);
+  ASSERT_EQUAL(d_values_output[0], 1000);
+}
+DECLARE_UNITTEST(TestOmpReduceByKeyIntervalsSingleSegment);
@@ -103,3 +103,43 @@ struct TestOmpReduceIntervals
 };
 VariableUnitTest<TestOmpReduceIntervals, IntegralTypes> TestOmpReduceIntervalsInstance;
 
+
+
+template<typename T, typename BinaryFunction>
+void TestOmpReduceIntervalsWithOperator(const size_t n, BinaryFunction binary_op)
+{
+  using thrust::system::omp::detail::reduce_intervals;
+  using thrust::system::detail::internal::uniform_decomposition;
+
+  thrust::host_vector<T>   h_input = unittest::random_integers<T>(n);
+  thrust::device_vector<T> d_input = h_input;
+
+  // intervals of every length around the number of accumulators
+  for(size_t num_intervals = 1; num_intervals <= 37; num_intervals += 6)
+  {
+    uniform_decomposition<size_t> decomp(n, 1, num_intervals);
+
+    thrust::host_vector<T>   h_output(decomp.size());
+    thrust::device_vector<T> d_output(decomp.size());
+
+    ::reduce_intervals(h_input.begin(), h_output.begin(), binary_op, decomp);
+    thrust::system::omp::tag omp_tag;
+    reduce_intervals(omp_tag, d_input.begin(), d_output.begin(), binary_op, decomp);
+
+    ASSERT_EQUAL(h_output, d_output);
+  }
+}
+
+
+template<typename T>
+struct TestOmpReduceIntervalsCommutativeOperators
+{
+  void operator()(const size_t n)
+  {
+    TestOmpReduceIntervalsWithOperator<T>(n, thrust::plus<T>());
+    TestOmpReduceIntervalsWithOperator<T>(n, thrust::minimum<T>());
+    TestOmpReduceIntervalsWithOperator<T>(n, thrust::maximum<T>());
+    TestOmpReduceIntervalsWithOperator<T>(n, thrust::bit_xor<T>());
+  }
+};
+VariableUnitTest<TestOmpReduceIntervalsCommutativeOperators, IntegralTypes> TestOmpReduceIntervalsCommutativeOperatorsInstance;
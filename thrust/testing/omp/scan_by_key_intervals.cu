@@ -0,0 +1,91 @@
+#include <unittest/unittest.h>
+
+#include <thrust/functional.h>
+#include <thrust/scan.h>
+#include <thrust/sequence.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/detail/scan_by_key.h>
+
+// long runs of equal keys, which span several intervals, interrupted by
+// runs of length one
+template<typename Vector>
+void initialize_keys(Vector& keys, const size_t n)
+{
+  thrust::host_vector<unsigned int> r = unittest::random_integers<unsigned int>(n);
+
+  thrust::host_vector<int> h_keys(n);
+  for(size_t i = 0; i < n; ++i)
+  {
+    h_keys[i] = (r[i] % 8 == 0) ? -static_cast<int>(i) : static_cast<int>(i / 25);
+  }
+
+  keys = h_keys;
+}
+
+
+template<typename T>
+struct TestOmpScanByKeyIntervals
+{
+  void operator()(const size_t n)
+  {
+    using thrust::system::omp::detail::scan_by_key_detail::inclusive_scan_by_key_intervals;
+    using thrust::system::omp::detail::scan_by_key_detail::exclusive_scan_by_key_intervals;
+    using thrust::system::detail::internal::uniform_decomposition;
+
+    thrust::host_vector<int>   h_keys;
+    thrust::device_vector<int> d_keys;
+    initialize_keys(h_keys, n);
+    d_keys = h_keys;
+
+    thrust::host_vector<T>   h_input = unittest::random_integers<T>(n);
+    thrust::device_vector<T> d_input = h_input;
+
+    thrust::host_vector<T>   h_output(n);
+    thrust::device_vector<T> d_output(n);
+
+    thrust::system::omp::tag omp_tag;
+    uniform_decomposition<size_t> decomp(n, 3, 100);
+
+    thrust::inclusive_scan_by_key(h_keys.begin(), h_keys.end(), h_input.begin(), h_output.begin(),
+                                  thrust::equal_to<int>(), thrust::plus<T>());
+    inclusive_scan_by_key_intervals(omp_tag, d_keys.begin(), d_input.begin(), d_output.begin(),
+                                    thrust::equal_to<int>(), thrust::plus<T>(), decomp);
+    ASSERT_EQUAL(h_output, d_output);
+
+    thrust::exclusive_scan_by_key(h_keys.begin(), h_keys.end(), h_input.begin(), h_output.begin(),
+                                  T(13), thrust::equal_to<int>(), thrust::plus<T>());
+    exclusive_scan_by_key_intervals(omp_tag, d_keys.begin(), d_input.begin(), d_output.begin(),
+                                    T(13), thrust::equal_to<int>(), thrust::plus<T>(), decomp);
+    ASSERT_EQUAL(h_output, d_output);
+
+    // in-place
+    exclusive_scan_by_key_intervals(omp_tag, d_keys.begin(), d_input.begin(), d_input.begin(),
+                                    T(13), thrust::equal_to<int>(), thrust::plus<T>(), decomp);
+    ASSERT_EQUAL(h_output, d_input);
+  }
+};
+VariableUnitTest<TestOmpScanByKeyIntervals, IntegralTypes> TestOmpScanByKeyIntervalsInstance;
+
+
+void TestOmpScanByKeyIntervalsSingleSegment(void)
+{
+  using thrust::system::omp::detail::scan_by_key_detail::inclusive_scan_by_key_intervals;
+  using thrust::system::detail::internal::uniform_decomposition;
+
+  const size_t n = 1000;
+
+  thrust::device_vector<int> d_keys(n, 7);
+  thrust::device_vector<int> d_input(n, 1);
+  thrust::device_vector<int> d_output(n);
+
+  thrust::system::omp::tag omp_tag;
+  uniform_decomposition<size_t> decomp(n, 3, 64);
+
+  inclusive_scan_by_key_intervals(omp_tag, d_keys.begin(), d_input.begin(), d_output.begin(),
+                                  thrust::equal_to<int>(), thrust::plus<int>(), decomp);
+
+  thrust::device_vector<int> ref(n);
+  thrust::sequence(ref.begin(), ref.end(), 1);
+  ASSERT_EQUAL(ref, d_output);
+}
+DECLARE_UNITTEST(TestOmpScanByKeyIntervalsSingleSegment);
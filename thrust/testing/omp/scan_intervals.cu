@@ -0,0 +1,92 @@
+#include <unittest/unittest.h>
+
+#include <thrust/functional.h>
+#include <thrust/scan.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/detail/scan.h>
+
+// an associative but non-commutative operator:
+// composition of the affine maps x -> a * x + b
+struct compose_affine
+{
+  typedef thrust::pair<unsigned int, unsigned int> affine;
+
+  __host__ __device__
+  affine operator()(const affine &f, const affine &g) const
+  {
+    return affine(f.first * g.first, f.second * g.first + g.second);
+  }
+};
+
+
+template<typename T>
+struct TestOmpScanIntervals
+{
+  void operator()(const size_t n)
+  {
+    using thrust::system::omp::detail::scan_detail::inclusive_scan_intervals;
+    using thrust::system::omp::detail::scan_detail::exclusive_scan_intervals;
+    using thrust::system::detail::internal::uniform_decomposition;
+
+    thrust::host_vector<T>   h_input = unittest::random_integers<T>(n);
+    thrust::device_vector<T> d_input = h_input;
+
+    thrust::host_vector<T>   h_output(n);
+    thrust::device_vector<T> d_output(n);
+
+    thrust::system::omp::tag omp_tag;
+    uniform_decomposition<size_t> decomp(n, 7, 100);
+
+    thrust::inclusive_scan(h_input.begin(), h_input.end(), h_output.begin(), thrust::plus<T>());
+    inclusive_scan_intervals(omp_tag, d_input.begin(), d_output.begin(), thrust::plus<T>(), decomp);
+    ASSERT_EQUAL(h_output, d_output);
+
+    thrust::exclusive_scan(h_input.begin(), h_input.end(), h_output.begin(), T(13), thrust::plus<T>());
+    exclusive_scan_intervals(omp_tag, d_input.begin(), d_output.begin(), T(13), thrust::plus<T>(), decomp);
+    ASSERT_EQUAL(h_output, d_output);
+
+    // in-place
+    exclusive_scan_intervals(omp_tag, d_input.begin(), d_input.begin(), T(13), thrust::plus<T>(), decomp);
+    ASSERT_EQUAL(h_output, d_input);
+  }
+};
+VariableUnitTest<TestOmpScanIntervals, IntegralTypes> TestOmpScanIntervalsInstance;
+
+
+void TestOmpScanIntervalsNonCommutative(void)
+{
+  using thrust::system::omp::detail::scan_detail::inclusive_scan_intervals;
+  using thrust::system::omp::detail::scan_detail::exclusive_scan_intervals;
+  using thrust::system::detail::internal::uniform_decomposition;
+
+  typedef compose_affine::affine T;
+
+  const size_t n = 1000;
+
+  thrust::host_vector<unsigned int> a = unittest::random_integers<unsigned int>(n);
+  thrust::host_vector<unsigned int> b = unittest::random_integers<unsigned int>(n);
+
+  thrust::host_vector<T> h_input(n);
+  for(size_t i = 0; i < n; ++i)
+  {
+    h_input[i] = T(a[i], b[i]);
+  }
+
+  thrust::device_vector<T> d_input = h_input;
+
+  thrust::host_vector<T>   h_output(n);
+  thrust::device_vector<T> d_output(n);
+
+  thrust::system::omp::tag omp_tag;
+  uniform_decomposition<size_t> decomp(n, 3, 64);
+
+  thrust::inclusive_scan(h_input.begin(), h_input.end(), h_output.begin(), compose_affine());
+  inclusive_scan_intervals(omp_tag, d_input.begin(), d_output.begin(), compose_affine(), decomp);
+  ASSERT_EQUAL(h_output == d_output, true);
+
+  thrust::exclusive_scan(h_input.begin(), h_input.end(), h_output.begin(), T(1u, 0u), compose_affine());
+  exclusive_scan_intervals(omp_tag, d_input.begin(), d_output.begin(), T(1u, 0u), compose_affine(), decomp);
+  ASSERT_EQUAL(h_output == d_output, true);
+}
+DECLARE_UNITTEST(TestOmpScanIntervalsNonCommutative);
+
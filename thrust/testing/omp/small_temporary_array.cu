@@ -0,0 +1,98 @@
+#include <unittest/unittest.h>
+
+#include <thrust/detail/small_temporary_array.h>
+#include <thrust/system/omp/execution_policy.h>
+
+void TestOmpSmallTemporaryArray(void)
+{
+  thrust::omp::tag omp_tag;
+
+  thrust::detail::small_temporary_array<int, thrust::omp::tag, 4> inline_array(omp_tag, 3);
+  ASSERT_EQUAL(inline_array.is_inline(), true);
+  ASSERT_EQUAL(inline_array.size(), 3u);
+  ASSERT_EQUAL(inline_array.end() - inline_array.begin(), 3);
+
+  // elements are value-initialized
+  ASSERT_EQUAL(inline_array[0], 0);
+  ASSERT_EQUAL(inline_array[2], 0);
+
+  thrust::detail::small_temporary_array<int, thrust::omp::tag, 4> heap_array(omp_tag, 5);
+  ASSERT_EQUAL(heap_array.is_inline(), false);
+  ASSERT_EQUAL(heap_array.size(), 5u);
+
+  heap_array[4] = 13;
+  ASSERT_EQUAL(heap_array.data()[4], 13);
+}
+DECLARE_UNITTEST(TestOmpSmallTemporaryArray);
+
+struct large_element
+{
+  char bytes[512];
+};
+
+void TestOmpSmallTemporaryArrayByteBudget(void)
+{
+  thrust::omp::tag omp_tag;
+
+  typedef thrust::detail::small_temporary_array<large_element, thrust::omp::tag> array_type;
+
+  // large elements are kept inline only up to the byte budget
+  ASSERT_EQUAL(array_type::inline_capacity * sizeof(large_element) <= thrust::detail::small_temporary_array_max_inline_bytes, true);
+
+  array_type heap_array(omp_tag, array_type::inline_capacity + 1);
+  ASSERT_EQUAL(heap_array.is_inline(), false);
+  ASSERT_EQUAL(sizeof(array_type) < 2 * thrust::detail::small_temporary_array_max_inline_bytes, true);
+}
+DECLARE_UNITTEST(TestOmpSmallTemporaryArrayByteBudget);
+
+struct huge_element
+{
+  char bytes[2048];
+};
+
+void TestOmpSmallTemporaryArrayHugeElements(void)
+{
+  thrust::omp::tag omp_tag;
+
+  typedef thrust::detail::small_temporary_array<huge_element, thrust::omp::tag> array_type;
+
+  // elements larger than the byte budget are never kept inline, and take
+  // no room in the array itself
+  ASSERT_EQUAL(array_type::inline_capacity, 0u);
+  ASSERT_EQUAL(sizeof(array_type) < thrust::detail::small_temporary_array_max_inline_bytes, true);
+
+  array_type heap_array(omp_tag, 1);
+  ASSERT_EQUAL(heap_array.is_inline(), false);
+  heap_array[0].bytes[2047] = 7;
+  ASSERT_EQUAL(heap_array.data()[0].bytes[2047], 7);
+}
+DECLARE_UNITTEST(TestOmpSmallTemporaryArrayHugeElements);
+
+#if _CCCL_STD_VER >= 2011
+#include <thrust/mr/statistics.h>
+#include <thrust/mr/new.h>
+#include <thrust/mr/allocator.h>
+#include <thrust/host_vector.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+
+void TestOmpSmallTemporaryArrayAvoidsAllocations(void)
+{
+  typedef thrust::mr::statistics_resource<thrust::mr::new_delete_resource> Stats;
+
+  Stats stats;
+  thrust::mr::allocator<char, Stats> alloc(&stats);
+
+  thrust::host_vector<int> v(100000, 1);
+
+  stats.reset();
+
+  // the per-thread partial sums and carries are kept inline
+  ASSERT_EQUAL(thrust::reduce(thrust::omp::par(alloc), v.begin(), v.end()), 100000);
+  thrust::inclusive_scan(thrust::omp::par(alloc), v.begin(), v.end(), v.begin());
+  ASSERT_EQUAL(v.back(), 100000);
+
+  ASSERT_EQUAL(stats.statistics().allocations, 0u);
+}
+DECLARE_UNITTEST(TestOmpSmallTemporaryArrayAvoidsAllocations);
+#endif
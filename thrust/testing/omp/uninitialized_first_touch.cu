@@ -0,0 +1,43 @@
+#include <unittest/unittest.h>
+
+#include <thrust/extrema.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/uninitialized_copy.h>
+#include <thrust/uninitialized_fill.h>
+
+#include <omp.h>
+
+#include <cstdlib>
+#include <vector>
+
+// records the thread which constructed it
+struct touched_by
+{
+  int thread;
+
+  touched_by() : thread(-1) {}
+
+  touched_by(const touched_by &) : thread(omp_in_parallel() ? omp_get_thread_num() : -1) {}
+};
+
+// uninitialized storage is first touched by the threads which process it in later algorithms
+void TestOmpUninitializedFillAndCopyInParallel(void)
+{
+  const int n = 1 << 16;
+
+  touched_by *storage = static_cast<touched_by *>(std::malloc(n * sizeof(touched_by)));
+
+  thrust::uninitialized_fill(thrust::omp::par.with(2, thrust::omp::schedule_static, 1), storage, storage + n, touched_by());
+
+  ASSERT_EQUAL(storage[0].thread, 0);
+  ASSERT_EQUAL(storage[n - 1].thread, 1);
+
+  std::vector<touched_by> input(n);
+  thrust::uninitialized_copy(thrust::omp::par.with(2, thrust::omp::schedule_static, 1), input.begin(), input.end(), storage);
+
+  ASSERT_EQUAL(storage[0].thread, 0);
+  ASSERT_EQUAL(storage[n - 1].thread, 1);
+
+  std::free(storage);
+}
+DECLARE_UNITTEST(TestOmpUninitializedFillAndCopyInParallel);
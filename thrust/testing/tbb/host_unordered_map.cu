@@ -0,0 +1,39 @@
+#include <unittest/unittest.h>
+
+#include <thrust/detail/config.h>
+
+#if _CCCL_STD_VER >= 2011
+#include <thrust/host_unordered_map.h>
+#include <thrust/host_vector.h>
+#include <thrust/system/tbb/execution_policy.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/functional.h>
+
+void TestTbbHostUnorderedMapInsertOrReduce()
+{
+  const int n = 1 << 20;
+  const int num_keys = 1000;
+
+  thrust::host_vector<int> keys(n);
+  thrust::host_vector<int> values(n, 1);
+  for(int i = 0; i < n; ++i)
+  {
+    keys[i] = static_cast<int>((i * 7919ll) % num_keys);
+  }
+
+  thrust::host_unordered_map<int, int> counts;
+  counts.insert_or_reduce(thrust::tbb::par, keys.begin(), keys.end(), values.begin(), thrust::plus<int>());
+  ASSERT_EQUAL(counts.size(), static_cast<std::size_t>(num_keys));
+
+  thrust::host_vector<int> found(num_keys);
+  thrust::host_vector<int> expected(num_keys, n / num_keys);
+  for(int i = 0; i < n % num_keys; ++i)
+  {
+    ++expected[keys[i]];
+  }
+
+  counts.bulk_find(thrust::tbb::par, thrust::counting_iterator<int>(0), thrust::counting_iterator<int>(num_keys), found.begin());
+  ASSERT_EQUAL(found, expected);
+}
+DECLARE_UNITTEST(TestTbbHostUnorderedMapInsertOrReduce);
+#endif
@@ -0,0 +1,25 @@
+#include <unittest/unittest.h>
+
+#include <thrust/system/tbb/vector.h>
+#include <thrust/sequence.h>
+
+void TestTbbHostVector(void)
+{
+  thrust::tbb::host_vector<int> v(100000, 7);
+  ASSERT_EQUAL(v[99999], 7);
+
+  thrust::host_vector<int> h(100000);
+  thrust::sequence(h.begin(), h.end());
+
+  thrust::tbb::host_vector<int> copy(h.begin(), h.end());
+  ASSERT_EQUAL(copy, h);
+
+  thrust::tbb::host_vector<int> u(200000, thrust::default_init);
+  u = h;
+  ASSERT_EQUAL(u, h);
+
+  u.assign(50000, 3);
+  ASSERT_EQUAL(u.size(), 50000lu);
+  ASSERT_EQUAL(u[49999], 3);
+}
+DECLARE_UNITTEST(TestTbbHostVector);
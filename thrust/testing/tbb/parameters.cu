@@ -0,0 +1,131 @@
+#include <unittest/unittest.h>
+
+#include <thrust/copy.h>
+#include <thrust/extrema.h>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/merge.h>
+#include <thrust/partition.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/sort.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
+
+struct record_concurrency
+{
+  int *concurrency_of;
+
+  record_concurrency(int *concurrency_of) : concurrency_of(concurrency_of) {}
+
+  void operator()(int i) const
+  {
+    concurrency_of[i] = ::tbb::this_task_arena::max_concurrency();
+  }
+};
+
+void TestTbbParOnArena(void)
+{
+  const int n = 1 << 16;
+
+  ::tbb::task_arena arena(2);
+
+  thrust::host_vector<int> concurrency_of(n);
+  int *raw_concurrency_of = thrust::raw_pointer_cast(concurrency_of.data());
+
+  thrust::for_each(thrust::tbb::par.on(arena),
+                   thrust::counting_iterator<int>(0),
+                   thrust::counting_iterator<int>(n),
+                   record_concurrency(raw_concurrency_of));
+
+  ASSERT_EQUAL(*thrust::min_element(concurrency_of.begin(), concurrency_of.end()), 2);
+  ASSERT_EQUAL(*thrust::max_element(concurrency_of.begin(), concurrency_of.end()), 2);
+}
+DECLARE_UNITTEST(TestTbbParOnArena);
+
+template <typename T>
+struct is_even
+{
+  _CCCL_HOST_DEVICE bool operator()(T x) const
+  {
+    return ((int) x % 2) == 0;
+  }
+};
+
+template <typename T, typename ExecutionPolicy>
+void CheckTbbParWithAlgorithms(ExecutionPolicy exec, const thrust::host_vector<T> &h_data)
+{
+  const size_t n = h_data.size();
+
+  ASSERT_EQUAL(thrust::reduce(thrust::cpp::par, h_data.begin(), h_data.end()),
+               thrust::reduce(exec, h_data.begin(), h_data.end()));
+
+  thrust::host_vector<T> ref(n), result(n);
+  thrust::inclusive_scan(thrust::cpp::par, h_data.begin(), h_data.end(), ref.begin());
+  thrust::inclusive_scan(exec, h_data.begin(), h_data.end(), result.begin());
+  ASSERT_EQUAL(ref, result);
+
+  ref.resize(thrust::copy_if(thrust::cpp::par, h_data.begin(), h_data.end(), ref.begin(), is_even<T>()) - ref.begin());
+  result.resize(n);
+  result.resize(thrust::copy_if(exec, h_data.begin(), h_data.end(), result.begin(), is_even<T>()) - result.begin());
+  ASSERT_EQUAL(ref, result);
+
+  ref = h_data;
+  thrust::stable_partition(thrust::cpp::par, ref.begin(), ref.end(), is_even<T>());
+  result = h_data;
+  thrust::stable_partition(exec, result.begin(), result.end(), is_even<T>());
+  ASSERT_EQUAL(ref, result);
+
+  ref = h_data;
+  thrust::stable_sort(thrust::cpp::par, ref.begin(), ref.end(), thrust::greater<T>());
+  result = h_data;
+  thrust::stable_sort(exec, result.begin(), result.end(), thrust::greater<T>());
+  ASSERT_EQUAL(ref, result);
+
+  thrust::host_vector<T> ref_merged(2 * n), merged(2 * n);
+  thrust::merge(
+    thrust::cpp::par, ref.begin(), ref.end(), ref.begin(), ref.end(), ref_merged.begin(), thrust::greater<T>());
+  thrust::merge(exec, ref.begin(), ref.end(), ref.begin(), ref.end(), merged.begin(), thrust::greater<T>());
+  ASSERT_EQUAL(ref_merged, merged);
+
+  ref = h_data;
+  thrust::stable_sort(thrust::cpp::par, ref.begin(), ref.end());
+  result = h_data;
+  thrust::stable_sort(exec, result.begin(), result.end());
+  ASSERT_EQUAL(ref, result);
+}
+
+template <typename T>
+struct TestTbbParWithAlgorithms
+{
+  void operator()(const size_t n)
+  {
+    thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+
+    ::tbb::task_arena arena(2);
+    ::tbb::affinity_partitioner ap;
+
+    const thrust::tbb::partitioner_kind partitioners[] = {
+      thrust::tbb::partition_auto, thrust::tbb::partition_affinity, thrust::tbb::partition_static};
+
+    for (int p = 0; p < 3; ++p)
+    {
+      for (size_t grain_size = 0; grain_size <= 1 << 12; grain_size = 2 * grain_size + 1)
+      {
+        CheckTbbParWithAlgorithms<T>(
+          thrust::tbb::par.with_partitioner(partitioners[p]).with_grain_size(grain_size), h_data);
+        CheckTbbParWithAlgorithms<T>(
+          thrust::tbb::par.on(arena).with_partitioner(partitioners[p]).with_grain_size(grain_size), h_data);
+      }
+    }
+
+    // the affinity state is replayed across calls
+    for (int i = 0; i < 3; ++i)
+    {
+      CheckTbbParWithAlgorithms<T>(thrust::tbb::par.on(arena).with_affinity(ap), h_data);
+    }
+  }
+};
+VariableUnitTest<TestTbbParWithAlgorithms, IntegralTypes> TestTbbParWithAlgorithmsInstance;
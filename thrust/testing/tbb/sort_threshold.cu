@@ -0,0 +1,76 @@
+#include <unittest/unittest.h>
+
+#include <thrust/functional.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+template <typename T>
+struct less_div_10
+{
+  _CCCL_HOST_DEVICE bool operator()(const T& lhs, const T& rhs) const
+  {
+    return ((int) lhs) / 10 < ((int) rhs) / 10;
+  }
+};
+
+template <typename T>
+void TestTbbSortWithSortThreshold(const size_t n)
+{
+  thrust::host_vector<T> h_keys = unittest::random_integers<T>(n);
+
+  // arithmetic keys with thrust::less take the radix sort path
+  thrust::host_vector<T> h_ref = h_keys;
+  thrust::stable_sort(thrust::cpp::par, h_ref.begin(), h_ref.end());
+
+  for (size_t threshold = 1; threshold <= 1 << 12; threshold <<= 6)
+  {
+    thrust::host_vector<T> h_result = h_keys;
+    thrust::stable_sort(thrust::tbb::par.with_sort_threshold(threshold), h_result.begin(), h_result.end());
+
+    ASSERT_EQUAL(h_ref, h_result);
+  }
+
+  // other comparators take the merge sort path
+  h_ref = h_keys;
+  thrust::stable_sort(thrust::cpp::par, h_ref.begin(), h_ref.end(), less_div_10<T>());
+
+  for (size_t threshold = 1; threshold <= 1 << 12; threshold <<= 6)
+  {
+    thrust::host_vector<T> h_result = h_keys;
+    thrust::stable_sort(
+      thrust::tbb::par.with_sort_threshold(threshold), h_result.begin(), h_result.end(), less_div_10<T>());
+
+    ASSERT_EQUAL(h_ref, h_result);
+  }
+}
+DECLARE_VARIABLE_UNITTEST(TestTbbSortWithSortThreshold);
+
+template <typename T>
+void TestTbbSortByKeyWithSortThreshold(const size_t n)
+{
+  thrust::host_vector<T> h_keys = unittest::random_integers<T>(n);
+  thrust::host_vector<int> h_values(n);
+  thrust::sequence(h_values.begin(), h_values.end());
+
+  thrust::host_vector<T> h_ref_keys     = h_keys;
+  thrust::host_vector<int> h_ref_values = h_values;
+  thrust::stable_sort_by_key(
+    thrust::cpp::par, h_ref_keys.begin(), h_ref_keys.end(), h_ref_values.begin(), thrust::greater<T>());
+
+  for (size_t threshold = 1; threshold <= 1 << 12; threshold <<= 6)
+  {
+    thrust::host_vector<T> h_result_keys     = h_keys;
+    thrust::host_vector<int> h_result_values = h_values;
+    thrust::stable_sort_by_key(
+      thrust::tbb::par.with_sort_threshold(threshold),
+      h_result_keys.begin(),
+      h_result_keys.end(),
+      h_result_values.begin(),
+      thrust::greater<T>());
+
+    ASSERT_EQUAL(h_ref_keys, h_result_keys);
+    ASSERT_EQUAL(h_ref_values, h_result_values);
+  }
+}
+DECLARE_VARIABLE_UNITTEST(TestTbbSortByKeyWithSortThreshold);
@@ -3,12 +3,14 @@
 #include <thrust/detail/config.h>
 #include <thrust/sequence.h>
 #include <thrust/device_malloc_allocator.h>
+#include <thrust/type_traits/is_trivially_relocatable.h>
 
 #if _CCCL_STD_VER >= 2011
 #include <initializer_list>
 #endif
 #include <vector>
 #include <list>
+#include <string>
 #include <limits>
 #include <utility>
 
@@ -639,6 +641,43 @@ void TestVectorResizing(void)
 DECLARE_VECTOR_UNITTEST(TestVectorResizing);
 
 
+template <class Vector>
+void TestVectorDefaultInit(void)
+{
+    typedef typename Vector::value_type T;
+
+    Vector v(10, thrust::default_init);
+    ASSERT_EQUAL(v.size(), 10lu);
+
+    thrust::sequence(v.begin(), v.end());
+
+    // the elements which are kept are untouched
+    v.resize(20, thrust::default_init);
+    ASSERT_EQUAL(v.size(), 20lu);
+    ASSERT_EQUAL(v[0], T(0));
+    ASSERT_EQUAL(v[9], T(9));
+
+    // growing past the capacity moves them
+    v.resize(v.capacity() + 1, thrust::default_init);
+    ASSERT_EQUAL(v[9], T(9));
+
+    v.resize(5, thrust::default_init);
+    ASSERT_EQUAL(v.size(), 5lu);
+    ASSERT_EQUAL(v[4], T(4));
+}
+DECLARE_VECTOR_UNITTEST(TestVectorDefaultInit);
+
+void TestVectorDefaultInitConstructsClassTypes(void)
+{
+    thrust::host_vector<std::string> v(3, thrust::default_init);
+    ASSERT_EQUAL(v[2], std::string());
+
+    v.resize(10, thrust::default_init);
+    ASSERT_EQUAL(v[9], std::string());
+}
+DECLARE_UNITTEST(TestVectorDefaultInitConstructsClassTypes);
+
+
 
 template <class Vector>
 void TestVectorReserving(void)
@@ -670,6 +709,105 @@ void TestVectorReserving(void)
 DECLARE_VECTOR_UNITTEST(TestVectorReserving)
 
 
+template <class Vector>
+void TestVectorPushBack(void)
+{
+    typedef typename Vector::value_type T;
+
+    Vector v;
+
+    for(size_t i = 0; i < 1000; ++i)
+    {
+        v.push_back(T(i % 100));
+    }
+
+    ASSERT_EQUAL(v.size(), 1000lu);
+    ASSERT_GEQUAL(v.capacity(), 1000lu);
+    ASSERT_LESS(v.capacity(), 2048lu);
+
+    for(size_t i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQUAL(v[i], T(i % 100));
+    }
+
+    // appending an element of the vector itself when it has to grow
+    v.resize(v.capacity());
+    v[0] = T(7);
+    v.push_back(v[0]);
+
+    ASSERT_EQUAL(v.back(), T(7));
+}
+DECLARE_VECTOR_UNITTEST(TestVectorPushBack);
+
+
+// trivially relocatable, although its copy constructor isn't trivial
+struct copy_counting
+{
+    static size_t copies;
+
+    int value;
+
+    copy_counting(int v = 0) : value(v) {}
+
+    copy_counting(const copy_counting &other) : value(other.value)
+    {
+        ++copies;
+    }
+
+    copy_counting &operator=(const copy_counting &other)
+    {
+        value = other.value;
+        return *this;
+    }
+};
+
+size_t copy_counting::copies = 0;
+
+THRUST_PROCLAIM_TRIVIALLY_RELOCATABLE(copy_counting);
+
+void TestVectorReservingRelocates(void)
+{
+    thrust::host_vector<copy_counting> v;
+
+    for(int i = 0; i < 100; ++i)
+    {
+        v.push_back(copy_counting(i));
+    }
+
+    // growing the storage relocates the elements bitwise rather than copying them
+    size_t copies = copy_counting::copies;
+    v.reserve(1000);
+
+    ASSERT_EQUAL(copy_counting::copies, copies);
+    ASSERT_EQUAL(v.capacity(), 1000lu);
+    for(int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQUAL(v[i].value, i);
+    }
+}
+DECLARE_UNITTEST(TestVectorReservingRelocates);
+
+#if _CCCL_STD_VER >= 2011
+void TestVectorEmplaceBack(void)
+{
+    thrust::host_vector<std::pair<int, std::string> > v;
+
+    for(int i = 0; i < 100; ++i)
+    {
+        v.emplace_back(i, std::string(50, static_cast<char>('a' + i % 26)));
+    }
+
+    ASSERT_EQUAL(v.size(), 100lu);
+    for(int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQUAL(v[i].first, i);
+        ASSERT_EQUAL(v[i].second, std::string(50, static_cast<char>('a' + i % 26)));
+    }
+}
+DECLARE_UNITTEST(TestVectorEmplaceBack);
+#endif
+
+
 
 template <class Vector>
 void TestVectorUninitialisedCopy(void)
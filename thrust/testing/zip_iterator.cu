@@ -4,6 +4,12 @@
 #include <thrust/sequence.h>
 #include <thrust/copy.h>
 #include <thrust/transform.h>
+#include <thrust/for_each.h>
+#include <thrust/reduce.h>
+#include <thrust/memory.h>
+#include <thrust/iterator/detail/contiguous_zip_iterator.h>
+
+#include <type_traits>
 
 using namespace unittest;
 
@@ -295,6 +301,139 @@ void TestZipIteratorCopy(void)
 DECLARE_VECTOR_UNITTEST(TestZipIteratorCopy);
 
 
+template <typename Vector>
+void TestZipIteratorCopyColumns(void)
+{
+  using namespace thrust;
+  using T = typename Vector::value_type;
+
+  const size_t n = 50;
+
+  Vector input0(n), input1(n), input2(n);
+  Vector output0(n), output1(n);
+  thrust::host_vector<long long> output2(n);
+
+  sequence(input0.begin(), input0.end(), T{0});
+  sequence(input1.begin(), input1.end(), T{13});
+  sequence(input2.begin(), input2.end(), T{42});
+
+  // columns of different types and nested zips are copied column by column
+  auto result = thrust::copy_n(
+    make_zip_iterator(make_tuple(input0.begin(), make_zip_iterator(make_tuple(input1.begin(), input2.begin())))),
+    n,
+    make_zip_iterator(make_tuple(output0.begin(), make_zip_iterator(make_tuple(output1.begin(), output2.begin())))));
+
+  ASSERT_EQUAL(get<0>(result.get_iterator_tuple()) - output0.begin(), static_cast<std::ptrdiff_t>(n));
+  ASSERT_EQUAL(input0, output0);
+  ASSERT_EQUAL(input1, output1);
+  ASSERT_EQUAL(output2[0], 42);
+  ASSERT_EQUAL(output2[n - 1], static_cast<long long>(T(42 + n - 1)));
+
+  // flat zips of contiguous columns are copied in one loop over chunks of all columns
+  thrust::host_vector<long long> wide(n);
+  thrust::copy(make_zip_iterator(make_tuple(input1.begin(), input0.begin())),
+               make_zip_iterator(make_tuple(input1.end(),   input0.end())),
+               make_zip_iterator(make_tuple(output0.begin(), wide.begin())));
+
+  ASSERT_EQUAL(input1, output0);
+  ASSERT_EQUAL(wide[0], 0);
+  ASSERT_EQUAL(wide[n - 1], static_cast<long long>(T(n - 1)));
+
+  // zips with columns which aren't contiguous are copied element by element
+  thrust::copy(make_zip_iterator(make_tuple(counting_iterator<T>(0), input1.begin())),
+               make_zip_iterator(make_tuple(counting_iterator<T>(0), input1.begin())) + n,
+               make_zip_iterator(make_tuple(output1.begin(), output0.begin())));
+
+  ASSERT_EQUAL(input0, output1);
+  ASSERT_EQUAL(input1, output0);
+}
+DECLARE_INTEGRAL_VECTOR_UNITTEST(TestZipIteratorCopyColumns);
+
+
+struct not_host_system : thrust::execution_policy<not_host_system> {};
+
+void TestZipIteratorUnwrapsHostIteratorsOnly(void)
+{
+  typedef thrust::pointer<int, not_host_system>                      other_pointer;
+  typedef thrust::zip_iterator<thrust::tuple<other_pointer, int *> > mixed_zip;
+
+  // contiguous iterators of host systems are unwrapped to raw pointers...
+  static_assert(std::is_same<thrust::detail::try_unwrap_zipped_contiguous_iterator_return_t<thrust::host_vector<int>::iterator>,
+                             int *>::value, "");
+
+  // ...but those of other systems, whose memory the host may not access, are kept
+  static_assert(std::is_same<thrust::detail::try_unwrap_zipped_contiguous_iterator_return_t<other_pointer>,
+                             other_pointer>::value, "");
+  static_assert(std::is_same<thrust::detail::try_unwrap_zipped_contiguous_iterator_return_t<mixed_zip>,
+                             mixed_zip>::value, "");
+}
+DECLARE_UNITTEST(TestZipIteratorUnwrapsHostIteratorsOnly);
+
+
+struct IncrementTwoTuple
+{
+  template<typename Tuple>
+  __host__ __device__
+  void operator()(Tuple x) const
+  {
+    thrust::get<0>(x) += thrust::get<1>(x);
+    thrust::get<1>(x) += 1;
+  }
+}; // end IncrementTwoTuple
+
+
+template<typename Tuple>
+struct PlusTwoTuple
+{
+  __host__ __device__
+  Tuple operator()(Tuple x, Tuple y) const
+  {
+    return thrust::make_tuple(thrust::get<0>(x) + thrust::get<0>(y),
+                              thrust::get<1>(x) + thrust::get<1>(y));
+  }
+}; // end PlusTwoTuple
+
+
+template <typename Vector>
+void TestZipIteratorForEachAndReduce(void)
+{
+  using namespace thrust;
+  using T = typename Vector::value_type;
+
+  const size_t n = 50;
+
+  Vector data0(n), data1(n);
+  sequence(data0.begin(), data0.end(), T{0});
+  sequence(data1.begin(), data1.end(), T{1});
+
+  // the functor writes through the references of the zip
+  thrust::for_each(make_zip_iterator(make_tuple(data0.begin(), data1.begin())),
+                   make_zip_iterator(make_tuple(data0.end(),   data1.end())),
+                   IncrementTwoTuple());
+
+  ASSERT_EQUAL(data0[0], T(1));
+  ASSERT_EQUAL(data1[0], T(2));
+  ASSERT_EQUAL(data0[n - 1], T(2 * n - 1));
+  ASSERT_EQUAL(data1[n - 1], T(n + 1));
+
+  // the same as reducing each column on its own
+  tuple<T,T> sums = thrust::reduce(make_zip_iterator(make_tuple(data0.begin(), data1.begin())),
+                                   make_zip_iterator(make_tuple(data0.end(),   data1.end())),
+                                   tuple<T,T>(0, 0),
+                                   PlusTwoTuple<tuple<T,T> >());
+
+  ASSERT_EQUAL(get<0>(sums), thrust::reduce(data0.begin(), data0.end(), T(0)));
+  ASSERT_EQUAL(get<1>(sums), thrust::reduce(data1.begin(), data1.end(), T(0)));
+
+  // empty ranges are left alone
+  thrust::for_each(make_zip_iterator(make_tuple(data0.end(), data1.end())),
+                   make_zip_iterator(make_tuple(data0.end(), data1.end())),
+                   IncrementTwoTuple());
+  ASSERT_EQUAL(data1[n - 1], T(n + 1));
+}
+DECLARE_INTEGRAL_VECTOR_UNITTEST(TestZipIteratorForEachAndReduce);
+
+
 struct SumTwoTuple
 {
   template<typename Tuple>
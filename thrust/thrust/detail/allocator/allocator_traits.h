@@ -63,6 +63,8 @@ __THRUST_DEFINE_HAS_NESTED_TYPE(has_propagate_on_container_move_assignment, prop
 __THRUST_DEFINE_HAS_NESTED_TYPE(has_propagate_on_container_swap, propagate_on_container_swap)
 __THRUST_DEFINE_HAS_NESTED_TYPE(has_system_type, system_type)
 __THRUST_DEFINE_HAS_NESTED_TYPE(has_is_always_equal, is_always_equal)
+__THRUST_DEFINE_HAS_NESTED_TYPE(has_zero_filled_memory, zero_filled_memory)
+__THRUST_DEFINE_HAS_NESTED_TYPE(has_reallocatable_memory, reallocatable_memory)
 __THRUST_DEFINE_HAS_MEMBER_FUNCTION(has_member_system_impl, system)
 
 template<typename Alloc, typename U>
@@ -174,6 +176,18 @@ template<typename T>
   typedef typename T::is_always_equal type;
 };
 
+template<typename T>
+  struct nested_zero_filled_memory
+{
+  typedef typename T::zero_filled_memory type;
+};
+
+template<typename T>
+  struct nested_reallocatable_memory
+{
+  typedef typename T::reallocatable_memory type;
+};
+
 template<typename T>
   struct nested_system_type
 {
@@ -346,6 +360,22 @@ template<typename Alloc>
     is_empty<allocator_type>
   >::type is_always_equal;
 
+  // not a standard trait: true if the memory allocated by the allocator reads as zeros until it's written to, which
+  // makes value-initializing objects whose zero value is all zero bits in freshly allocated memory redundant
+  typedef typename eval_if<
+    allocator_traits_detail::has_zero_filled_memory<allocator_type>::value,
+    allocator_traits_detail::nested_zero_filled_memory<allocator_type>,
+    identity_<false_type>
+  >::type zero_filled_memory;
+
+  // not a standard trait: true if the allocator has a member function reallocate(p, old_n, new_n), which grows or
+  // shrinks storage by moving its contents bitwise, and returns null when it can't
+  typedef typename eval_if<
+    allocator_traits_detail::has_reallocatable_memory<allocator_type>::value,
+    allocator_traits_detail::nested_reallocatable_memory<allocator_type>,
+    identity_<false_type>
+  >::type reallocatable_memory;
+
   typedef typename eval_if<
     allocator_traits_detail::has_system_type<allocator_type>::value,
     allocator_traits_detail::nested_system_type<allocator_type>,
@@ -85,6 +85,10 @@ public:
   using reference = typename thrust::detail::pointer_traits<pointer>::reference;
   using const_reference = typename thrust::detail::pointer_traits<const_pointer>::reference;
 
+  // std::allocator hands out memory with unspecified contents.
+  using zero_filled_memory = false_type;
+  using reallocatable_memory = false_type;
+
   template <typename U>
   using rebind_alloc = std::allocator<U>;
   template <typename U>
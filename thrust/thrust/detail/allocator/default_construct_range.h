@@ -36,6 +36,19 @@ _CCCL_HOST_DEVICE
 inline void default_construct_range(Allocator &a, Pointer p, Size n);
 
 
+// like default_construct_range, but p must point to memory that has just been allocated from a, and not been written to
+template<typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE
+inline void default_construct_allocated_range(Allocator &a, Pointer p, Size n);
+
+
+// default-initializes rather than value-initializes: leaves T uninitialized if its default constructor is trivial and
+// the allocator doesn't construct it
+template<typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE
+inline void default_initialize_range(Allocator &a, Pointer p, Size n);
+
+
 } // end detail
 THRUST_NAMESPACE_END
 
@@ -104,6 +104,75 @@ _CCCL_HOST_DEVICE
 }
 
 
+// value-initializing T in memory which reads as zeros can be skipped if the value of T() is all zero bits
+template<typename Allocator, typename T>
+  struct can_skip_default_construct_in_zero_filled_memory
+    : thrust::detail::and_<
+        typename allocator_traits<Allocator>::zero_filled_memory,
+        thrust::detail::not_<needs_default_construct_via_allocator<Allocator,T> >,
+        thrust::detail::or_<
+          thrust::detail::is_arithmetic<T>,
+          thrust::detail::is_pointer<T>
+        >
+      >
+{};
+
+
+template<typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE
+  typename enable_if<
+    can_skip_default_construct_in_zero_filled_memory<
+      Allocator,
+      typename pointer_element<Pointer>::type
+    >::value
+  >::type
+    default_construct_allocated_range(Allocator &, Pointer, Size)
+{
+}
+
+
+template<typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE
+  typename disable_if<
+    can_skip_default_construct_in_zero_filled_memory<
+      Allocator,
+      typename pointer_element<Pointer>::type
+    >::value
+  >::type
+    default_construct_allocated_range(Allocator &a, Pointer p, Size n)
+{
+  allocator_traits_detail::default_construct_range(a, p, n);
+}
+
+
+template<typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE
+  typename enable_if<
+    needs_default_construct_via_allocator<
+      Allocator,
+      typename pointer_element<Pointer>::type
+    >::value
+  >::type
+    default_initialize_range(Allocator &a, Pointer p, Size n)
+{
+  allocator_traits_detail::default_construct_range(a, p, n);
+}
+
+
+template<typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE
+  typename disable_if<
+    needs_default_construct_via_allocator<
+      Allocator,
+      typename pointer_element<Pointer>::type
+    >::value
+  >::type
+    default_initialize_range(Allocator &, Pointer, Size)
+{
+  // no op
+}
+
+
 } // end allocator_traits_detail
 
 
@@ -115,6 +184,22 @@ _CCCL_HOST_DEVICE
 }
 
 
+template<typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE
+  void default_construct_allocated_range(Allocator &a, Pointer p, Size n)
+{
+  return allocator_traits_detail::default_construct_allocated_range(a,p,n);
+}
+
+
+template<typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE
+  void default_initialize_range(Allocator &a, Pointer p, Size n)
+{
+  return allocator_traits_detail::default_initialize_range(a,p,n);
+}
+
+
 } // end detail
 THRUST_NAMESPACE_END
 
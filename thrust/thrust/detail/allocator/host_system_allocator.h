@@ -0,0 +1,103 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/type_traits.h>
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+THRUST_NAMESPACE_BEGIN
+namespace detail
+{
+
+// allocates ordinary host memory like std::allocator, with raw pointers, but has System as its system: containers
+// using it construct, destroy, copy and fill their elements with the algorithms of System rather than with those of
+// the host system
+template<typename T, typename System>
+  class host_system_allocator
+{
+  public:
+    typedef T                 value_type;
+    typedef T*                pointer;
+    typedef const T*          const_pointer;
+    typedef T&                reference;
+    typedef const T&          const_reference;
+    typedef std::size_t       size_type;
+    typedef std::ptrdiff_t    difference_type;
+    typedef System            system_type;
+    typedef true_type         is_always_equal;
+
+    template<typename U>
+      struct rebind
+    {
+      typedef host_system_allocator<U,System> other;
+    }; // end rebind
+
+    _CCCL_HOST_DEVICE
+    host_system_allocator() {}
+
+    template<typename U>
+    _CCCL_HOST_DEVICE
+    host_system_allocator(const host_system_allocator<U,System> &) {}
+
+    THRUST_NODISCARD
+    _CCCL_HOST
+    pointer allocate(size_type n)
+    {
+      return std::allocator<T>().allocate(n);
+    }
+
+    _CCCL_HOST
+    void deallocate(pointer p, size_type n)
+    {
+      std::allocator<T>().deallocate(p, n);
+    }
+
+    size_type max_size() const
+    {
+      return (std::numeric_limits<size_type>::max)() / sizeof(T);
+    }
+};
+
+template<typename T1, typename T2, typename System>
+_CCCL_HOST_DEVICE
+bool operator==(const host_system_allocator<T1,System> &, const host_system_allocator<T2,System> &)
+{
+  return true;
+}
+
+template<typename T1, typename T2, typename System>
+_CCCL_HOST_DEVICE
+bool operator!=(const host_system_allocator<T1,System> &, const host_system_allocator<T2,System> &)
+{
+  return false;
+}
+
+} // end detail
+THRUST_NAMESPACE_END
+
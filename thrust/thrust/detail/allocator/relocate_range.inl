@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/detail/allocator/relocate_range.h>
+#include <thrust/detail/allocator/allocator_traits.h>
+#include <thrust/detail/allocator/copy_construct_range.h>
+#include <thrust/detail/allocator/destroy_range.h>
+#include <thrust/detail/type_traits/pointer_traits.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/sequential/trivial_copy.h>
+#include <thrust/type_traits/is_trivially_relocatable.h>
+#include <thrust/detail/memory_wrapper.h>
+
+#if _CCCL_STD_VER >= 2011
+#include <type_traits>
+#include <utility>
+#endif
+
+THRUST_NAMESPACE_BEGIN
+namespace detail
+{
+namespace allocator_traits_detail
+{
+
+
+// relocate_range_n has three cases:
+// if the storage is raw memory, and Allocator has no effectful member functions construct and destroy:
+//   1. if T is trivially relocatable but not trivially copyable, relocate the range bitwise
+//   2. if T isn't trivially relocatable nor trivially copyable, but nothrow move constructible, move construct the range
+//      and destroy the source
+// else
+//   3. copy construct the range and destroy the source; for trivially copyable types this is already a bitwise copy,
+//      done by the algorithms of the allocator's system
+
+template<typename Allocator, typename T>
+  struct has_effectful_member_construct
+    : has_member_construct2<Allocator,T,T>
+{};
+
+// std::allocator::construct's only effect is to invoke T's constructor
+template<typename U, typename T>
+  struct has_effectful_member_construct<std::allocator<U>, T>
+    : thrust::detail::false_type
+{};
+
+template<typename Allocator, typename Pointer>
+  struct can_relocate_in_raw_memory
+    : integral_constant<
+        bool,
+        is_pointer<Pointer>::value &&
+        !has_trivial_copy_constructor<typename pointer_element<Pointer>::type>::value &&
+        !has_effectful_member_construct<Allocator, typename pointer_element<Pointer>::type>::value &&
+        !has_effectful_member_destroy<Allocator, typename pointer_element<Pointer>::type>::value
+      >
+{};
+
+template<typename Allocator, typename Pointer>
+  struct is_relocate_range_case1
+    : integral_constant<
+        bool,
+        can_relocate_in_raw_memory<Allocator,Pointer>::value &&
+        is_trivially_relocatable<typename pointer_element<Pointer>::type>::value
+      >
+{};
+
+#if _CCCL_STD_VER >= 2011
+template<typename Allocator, typename Pointer>
+  struct is_relocate_range_case2
+    : integral_constant<
+        bool,
+        can_relocate_in_raw_memory<Allocator,Pointer>::value &&
+        !is_trivially_relocatable<typename pointer_element<Pointer>::type>::value &&
+        std::is_nothrow_move_constructible<typename pointer_element<Pointer>::type>::value
+      >
+{};
+#else
+template<typename Allocator, typename Pointer>
+  struct is_relocate_range_case2
+    : thrust::detail::false_type
+{};
+#endif
+
+
+// relocate_range_n case 1: bitwise relocation
+template<typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE
+  typename enable_if<
+    is_relocate_range_case1<Allocator,Pointer>::value,
+    Pointer
+  >::type
+    relocate_range_n(Allocator &, Pointer first, Size n, Pointer result)
+{
+  typedef typename pointer_element<Pointer>::type T;
+
+  // copied as bytes, since T may have non-trivial copy operations
+  thrust::system::detail::sequential::trivial_copy_n(reinterpret_cast<const unsigned char *>(first),
+                                                     n * sizeof(T),
+                                                     reinterpret_cast<unsigned char *>(result));
+  return result + n;
+}
+
+
+#if _CCCL_STD_VER >= 2011
+// relocate_range_n case 2: move construction, which can't throw
+_CCCL_EXEC_CHECK_DISABLE
+template<typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE
+  typename enable_if<
+    is_relocate_range_case2<Allocator,Pointer>::value,
+    Pointer
+  >::type
+    relocate_range_n(Allocator &a, Pointer first, Size n, Pointer result)
+{
+  for(Size i = 0; i < n; ++i, ++first, ++result)
+  {
+    allocator_traits<Allocator>::construct(a, result, std::move(*first));
+    allocator_traits<Allocator>::destroy(a, first);
+  }
+
+  return result;
+}
+#endif
+
+
+// relocate_range_n case 3: copy construction
+template<typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE
+  typename enable_if<
+    !is_relocate_range_case1<Allocator,Pointer>::value &&
+    !is_relocate_range_case2<Allocator,Pointer>::value,
+    Pointer
+  >::type
+    relocate_range_n(Allocator &a, Pointer first, Size n, Pointer result)
+{
+  typename thrust::iterator_system<Pointer>::type from_system;
+
+  result = thrust::detail::copy_construct_range_n(from_system, a, first, n, result);
+  thrust::detail::destroy_range(a, first, n);
+
+  return result;
+}
+
+
+} // end allocator_traits_detail
+
+
+template<typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE
+  Pointer relocate_range_n(Allocator &a, Pointer first, Size n, Pointer result)
+{
+  return allocator_traits_detail::relocate_range_n(a,first,n,result);
+}
+
+
+} // end detail
+THRUST_NAMESPACE_END
+
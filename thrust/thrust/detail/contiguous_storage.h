@@ -123,9 +123,25 @@ template<typename T, typename Alloc>
     _CCCL_HOST_DEVICE
     void default_construct_n(iterator first, size_type n);
 
+    // like default_construct_n, for elements which haven't been written to since the storage was allocated
+    _CCCL_HOST_DEVICE
+    void default_construct_allocated_n(iterator first, size_type n);
+
+    // default-initializes rather than value-initializes
+    _CCCL_HOST_DEVICE
+    void default_init_n(iterator first, size_type n);
+
     _CCCL_HOST_DEVICE
     void uninitialized_fill_n(iterator first, size_type n, const value_type &value);
 
+    // copy to and fill elements which have already been constructed, with the algorithms of the allocator's system
+    template<typename InputIterator>
+    _CCCL_HOST_DEVICE
+    iterator copy_assign(InputIterator first, InputIterator last, iterator result);
+
+    _CCCL_HOST_DEVICE
+    iterator fill_assign_n(iterator first, size_type n, const value_type &value);
+
     template<typename InputIterator>
     _CCCL_HOST_DEVICE
     iterator uninitialized_copy(InputIterator first, InputIterator last, iterator result);
@@ -148,9 +164,28 @@ template<typename T, typename Alloc>
                                   Size n,
                                   iterator result);
 
+    // moves [first, last) to the uninitialized storage at result, which must not overlap it, and ends the lifetime of
+    // the elements in [first, last)
+    _CCCL_HOST_DEVICE
+    iterator uninitialized_relocate(iterator first, iterator last, iterator result);
+
+    // constructs a single element; directly, rather than through an algorithm, when the storage is raw memory
+    _CCCL_HOST_DEVICE
+    void construct_one(iterator p, const value_type &x);
+
+#if _CCCL_STD_VER >= 2011
+    template<typename... Args>
+    _CCCL_HOST_DEVICE
+    void emplace_one(iterator p, Args&&... args);
+#endif // _CCCL_STD_VER >= 2011
+
     _CCCL_HOST_DEVICE
     void destroy(iterator first, iterator last);
 
+    // grows or shrinks the storage to n elements in place, moving its contents bitwise, when the allocator can
+    // reallocate and the elements are trivially relocatable; returns false, leaving the storage untouched, otherwise
+    bool try_reallocate(size_type n);
+
     _CCCL_HOST_DEVICE
     void deallocate_on_allocator_mismatch(const contiguous_storage &other);
 
@@ -181,6 +216,20 @@ template<typename T, typename Alloc>
 #endif // _CCCL_STD_VER >= 2011
 
   private:
+    // the system copies into the storage are dispatched on: the allocator's system if it can read the input, like a
+    // parallel host system reading from sequential host iterators, and the input's system otherwise
+    template<typename InputIterator>
+      struct copy_system
+        : eval_if<
+            is_convertible<
+              typename allocator_system<Alloc>::type,
+              typename thrust::iterator_system<InputIterator>::type
+            >::value,
+            allocator_system<Alloc>,
+            thrust::iterator_system<InputIterator>
+          >
+    {};
+
     // XXX we could inherit from this to take advantage of empty base class optimization
     allocator_type m_allocator;
 
@@ -191,6 +240,26 @@ template<typename T, typename Alloc>
     // disallow assignment
     contiguous_storage &operator=(const contiguous_storage &x);
 
+    _CCCL_HOST_DEVICE
+    void construct_one_dispatch(true_type, iterator p, const value_type &x);
+
+    _CCCL_HOST_DEVICE
+    void construct_one_dispatch(false_type, iterator p, const value_type &x);
+
+#if _CCCL_STD_VER >= 2011
+    template<typename... Args>
+    _CCCL_HOST_DEVICE
+    void emplace_one_dispatch(true_type, iterator p, Args&&... args);
+
+    template<typename... Args>
+    _CCCL_HOST_DEVICE
+    void emplace_one_dispatch(false_type, iterator p, Args&&... args);
+#endif // _CCCL_STD_VER >= 2011
+
+    bool try_reallocate_dispatch(true_type, size_type n);
+
+    bool try_reallocate_dispatch(false_type, size_type n);
+
     _CCCL_HOST_DEVICE
     void swap_allocators(true_type, const allocator_type &);
 
@@ -32,6 +32,11 @@
 #include <thrust/detail/allocator/default_construct_range.h>
 #include <thrust/detail/allocator/destroy_range.h>
 #include <thrust/detail/allocator/fill_construct_range.h>
+#include <thrust/detail/allocator/relocate_range.h>
+#include <thrust/detail/copy.h>
+#include <thrust/fill.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/type_traits/is_trivially_relocatable.h>
 
 #include <nv/target>
 
@@ -264,6 +269,22 @@ _CCCL_HOST_DEVICE
   default_construct_range(m_allocator, first.base(), n);
 } // end contiguous_storage::default_construct_n()
 
+template<typename T, typename Alloc>
+_CCCL_HOST_DEVICE
+  void contiguous_storage<T,Alloc>
+    ::default_construct_allocated_n(iterator first, size_type n)
+{
+  default_construct_allocated_range(m_allocator, first.base(), n);
+} // end contiguous_storage::default_construct_allocated_n()
+
+template<typename T, typename Alloc>
+_CCCL_HOST_DEVICE
+  void contiguous_storage<T,Alloc>
+    ::default_init_n(iterator first, size_type n)
+{
+  default_initialize_range(m_allocator, first.base(), n);
+} // end contiguous_storage::default_init_n()
+
 template<typename T, typename Alloc>
 _CCCL_HOST_DEVICE
   void contiguous_storage<T,Alloc>
@@ -272,6 +293,27 @@ _CCCL_HOST_DEVICE
   fill_construct_range(m_allocator, first.base(), n, x);
 } // end contiguous_storage::uninitialized_fill()
 
+template<typename T, typename Alloc>
+  template<typename InputIterator>
+  _CCCL_HOST_DEVICE
+    typename contiguous_storage<T,Alloc>::iterator
+      contiguous_storage<T,Alloc>
+        ::copy_assign(InputIterator first, InputIterator last, iterator result)
+{
+  typename copy_system<InputIterator>::type from_system;
+
+  return thrust::detail::two_system_copy(from_system, allocator_system<Alloc>::get(m_allocator), first, last, result);
+} // end contiguous_storage::copy_assign()
+
+template<typename T, typename Alloc>
+_CCCL_HOST_DEVICE
+  typename contiguous_storage<T,Alloc>::iterator
+    contiguous_storage<T,Alloc>
+      ::fill_assign_n(iterator first, size_type n, const value_type &x)
+{
+  return thrust::fill_n(allocator_system<Alloc>::get(m_allocator), first, n, x);
+} // end contiguous_storage::fill_assign_n()
+
 template<typename T, typename Alloc>
   template<typename System, typename InputIterator>
   _CCCL_HOST_DEVICE
@@ -290,7 +332,7 @@ template<typename T, typename Alloc>
         ::uninitialized_copy(InputIterator first, InputIterator last, iterator result)
 {
   // XXX assumes InputIterator's associated System is default-constructible
-  typename thrust::iterator_system<InputIterator>::type from_system;
+  typename copy_system<InputIterator>::type from_system;
 
   return iterator(copy_construct_range(from_system, m_allocator, first, last, result.base()));
 } // end contiguous_storage::uninitialized_copy()
@@ -313,11 +355,74 @@ template<typename T, typename Alloc>
         ::uninitialized_copy_n(InputIterator first, Size n, iterator result)
 {
   // XXX assumes InputIterator's associated System is default-constructible
-  typename thrust::iterator_system<InputIterator>::type from_system;
+  typename copy_system<InputIterator>::type from_system;
 
   return iterator(copy_construct_range_n(from_system, m_allocator, first, n, result.base()));
 } // end contiguous_storage::uninitialized_copy_n()
 
+template<typename T, typename Alloc>
+_CCCL_HOST_DEVICE
+  typename contiguous_storage<T,Alloc>::iterator
+    contiguous_storage<T,Alloc>
+      ::uninitialized_relocate(iterator first, iterator last, iterator result)
+{
+  return iterator(relocate_range_n(m_allocator, first.base(), last - first, result.base()));
+} // end contiguous_storage::uninitialized_relocate()
+
+template<typename T, typename Alloc>
+_CCCL_HOST_DEVICE
+  void contiguous_storage<T,Alloc>
+    ::construct_one(iterator p, const value_type &x)
+{
+  construct_one_dispatch(typename is_pointer<pointer>::type(), p, x);
+} // end contiguous_storage::construct_one()
+
+template<typename T, typename Alloc>
+_CCCL_HOST_DEVICE
+  void contiguous_storage<T,Alloc>
+    ::construct_one_dispatch(true_type, iterator p, const value_type &x)
+{
+  alloc_traits::construct(m_allocator, p.base(), x);
+} // end contiguous_storage::construct_one_dispatch()
+
+template<typename T, typename Alloc>
+_CCCL_HOST_DEVICE
+  void contiguous_storage<T,Alloc>
+    ::construct_one_dispatch(false_type, iterator p, const value_type &x)
+{
+  fill_construct_range(m_allocator, p.base(), 1, x);
+} // end contiguous_storage::construct_one_dispatch()
+
+#if _CCCL_STD_VER >= 2011
+template<typename T, typename Alloc>
+  template<typename... Args>
+  _CCCL_HOST_DEVICE
+    void contiguous_storage<T,Alloc>
+      ::emplace_one(iterator p, Args&&... args)
+{
+  emplace_one_dispatch(typename is_pointer<pointer>::type(), p, std::forward<Args>(args)...);
+} // end contiguous_storage::emplace_one()
+
+template<typename T, typename Alloc>
+  template<typename... Args>
+  _CCCL_HOST_DEVICE
+    void contiguous_storage<T,Alloc>
+      ::emplace_one_dispatch(true_type, iterator p, Args&&... args)
+{
+  alloc_traits::construct(m_allocator, p.base(), std::forward<Args>(args)...);
+} // end contiguous_storage::emplace_one_dispatch()
+
+template<typename T, typename Alloc>
+  template<typename... Args>
+  _CCCL_HOST_DEVICE
+    void contiguous_storage<T,Alloc>
+      ::emplace_one_dispatch(false_type, iterator p, Args&&... args)
+{
+  // the element can't be constructed in place in memory which isn't accessible here, so it's copied from a temporary
+  fill_construct_range(m_allocator, p.base(), 1, value_type(std::forward<Args>(args)...));
+} // end contiguous_storage::emplace_one_dispatch()
+#endif // _CCCL_STD_VER >= 2011
+
 template<typename T, typename Alloc>
 _CCCL_HOST_DEVICE
   void contiguous_storage<T,Alloc>
@@ -326,6 +431,45 @@ _CCCL_HOST_DEVICE
   destroy_range(m_allocator, first.base(), last - first);
 } // end contiguous_storage::destroy()
 
+template<typename T, typename Alloc>
+  bool contiguous_storage<T,Alloc>
+    ::try_reallocate(size_type n)
+{
+  return try_reallocate_dispatch(
+    integral_constant<
+      bool,
+      alloc_traits::reallocatable_memory::value && is_trivially_relocatable<T>::value
+    >(),
+    n);
+} // end contiguous_storage::try_reallocate()
+
+template<typename T, typename Alloc>
+  bool contiguous_storage<T,Alloc>
+    ::try_reallocate_dispatch(true_type, size_type n)
+{
+  if(size() == 0 || n == 0)
+  {
+    return false;
+  }
+
+  pointer p = m_allocator.reallocate(m_begin.base(), size(), n);
+  if(p == pointer(static_cast<T*>(0)))
+  {
+    return false;
+  }
+
+  m_begin = iterator(p);
+  m_size = n;
+  return true;
+} // end contiguous_storage::try_reallocate_dispatch()
+
+template<typename T, typename Alloc>
+  bool contiguous_storage<T,Alloc>
+    ::try_reallocate_dispatch(false_type, size_type)
+{
+  return false;
+} // end contiguous_storage::try_reallocate_dispatch()
+
 template<typename T, typename Alloc>
 _CCCL_HOST_DEVICE
   void contiguous_storage<T,Alloc>
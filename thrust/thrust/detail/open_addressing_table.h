@@ -0,0 +1,478 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file open_addressing_table.h
+ *  \brief The open addressing hash table shared by host_unordered_map and
+ *         host_unordered_set.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp11_required.h>
+
+#if _CCCL_STD_VER >= 2011
+
+#include <thrust/host_vector.h>
+#include <thrust/pair.h>
+#include <thrust/detail/execution_policy.h>
+#include <thrust/detail/allocator/allocator_traits.h>
+
+#include <cuda/std/atomic>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+THRUST_NAMESPACE_BEGIN
+namespace detail
+{
+namespace open_addressing_detail
+{
+
+
+// the states of a slot. a slot is busy while the thread which claimed it
+// writes its key and value; threads probing for the same key wait for it
+// to become full
+enum slot_state
+{
+  empty_slot = 0,
+  busy_slot  = 1,
+  full_slot  = 2
+};
+
+
+// the outcomes of claiming a slot for a key
+enum claim_result
+{
+  found_key    = 0,
+  claimed_slot = 1,
+  table_full   = 2
+};
+
+
+// the mapped type of the tables of sets, which keep no values
+struct no_mapped_value {};
+
+
+// waits a little before a thread polls a busy slot again: it pauses the
+// cpu for the first polls, and then yields, so that a thread which was
+// preempted while it held the slot gets to run when threads outnumber cores
+inline void backoff(unsigned int polls)
+{
+  // 64 pauses take a few microseconds, far longer than a slot is ever held
+  // unless its holder was preempted
+  const unsigned int max_pause_polls = 64;
+
+  if(polls >= max_pause_polls)
+  {
+    std::this_thread::yield();
+    return;
+  }
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+  __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+
+// the finalizer of MurmurHash3, which spreads the bits of hashes such as
+// the identity hashes of integers over the low bits used to pick a slot
+inline std::size_t mix(std::size_t h)
+{
+  std::uint64_t x = h;
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  x *= 0xc4ceb93fe53b87cdull;
+  x ^= x >> 33;
+  return static_cast<std::size_t>(x);
+}
+
+
+// the slots of a table, as raw pointers which the functors below carry
+// into the threads of a parallel algorithm. Mapped values are kept in a
+// separate array from keys, so probing only touches states and keys.
+// values is null for sets. claims are counted in *size, which they may
+// not take past max_size
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual>
+struct table_view
+{
+  typedef Key    key_type;
+  typedef Mapped mapped_type;
+
+  unsigned char *states;
+  Key           *keys;
+  Mapped        *values;
+  std::size_t   *size;
+  std::size_t    max_size;
+  std::size_t    mask;
+  Hash           hash;
+  KeyEqual       equal;
+
+  std::size_t capacity() const
+  {
+    return mask + 1;
+  }
+
+  // claims an empty slot for key, or finds the slot it's already in. the
+  // thread which claims a slot must initialize its value and publish it.
+  // a key which would take the table past max_size keys isn't claimed,
+  // and the result is table_full. probing is lock-free, except that
+  // threads looking for a key whose slot is being claimed wait until it's
+  // published
+  std::size_t claim(const Key &key, claim_result &result) const
+  {
+    ::cuda::std::atomic_ref<std::size_t> num_claimed(*size);
+
+    for(std::size_t i = mix(hash(key)) & mask; ; i = (i + 1) & mask)
+    {
+      ::cuda::std::atomic_ref<unsigned char> state(states[i]);
+      unsigned char s = state.load(::cuda::std::memory_order_acquire);
+
+      if(s == empty_slot)
+      {
+        if(num_claimed.fetch_add(1, ::cuda::std::memory_order_relaxed) >= max_size)
+        {
+          num_claimed.fetch_sub(1, ::cuda::std::memory_order_relaxed);
+          result = table_full;
+          return capacity();
+        }
+
+        if(state.compare_exchange_strong(s, static_cast<unsigned char>(busy_slot), ::cuda::std::memory_order_acq_rel))
+        {
+          keys[i] = key;
+          result = claimed_slot;
+          return i;
+        }
+
+        num_claimed.fetch_sub(1, ::cuda::std::memory_order_relaxed);
+      }
+
+      for(unsigned int polls = 0; s == busy_slot; ++polls)
+      {
+        backoff(polls);
+        s = state.load(::cuda::std::memory_order_acquire);
+      }
+
+      if(equal(keys[i], key))
+      {
+        result = found_key;
+        return i;
+      }
+    }
+  }
+
+  void publish(std::size_t i) const
+  {
+    ::cuda::std::atomic_ref<unsigned char>(states[i]).store(static_cast<unsigned char>(full_slot), ::cuda::std::memory_order_release);
+  }
+
+  // returns the slot of key, or capacity() if it's absent. lookups don't
+  // run concurrently with insertions, so they don't synchronize
+  std::size_t find(const Key &key) const
+  {
+    for(std::size_t i = mix(hash(key)) & mask; states[i] != empty_slot; i = (i + 1) & mask)
+    {
+      if(equal(keys[i], key))
+      {
+        return i;
+      }
+    }
+
+    return capacity();
+  }
+};
+
+
+// inserts the i-th key and value, and returns the claim_result
+template<typename View, typename KeyIterator, typename ValueIterator>
+struct insert_functor
+{
+  View          view;
+  KeyIterator   keys_first;
+  ValueIterator values_first;
+
+  unsigned char operator()(std::size_t i) const
+  {
+    claim_result result = found_key;
+    std::size_t slot = view.claim(keys_first[i], result);
+
+    if(result == claimed_slot)
+    {
+      if(view.values)
+      {
+        view.values[slot] = values_first[i];
+      }
+
+      view.publish(slot);
+    }
+
+    return static_cast<unsigned char>(result);
+  }
+};
+
+
+// inserts the i-th key and value, or combines the value with the value
+// already mapped to the key, and returns the claim_result
+template<typename View, typename KeyIterator, typename ValueIterator, typename BinaryFunction>
+struct insert_or_reduce_functor
+{
+  View           view;
+  KeyIterator    keys_first;
+  ValueIterator  values_first;
+  BinaryFunction binary_op;
+
+  unsigned char operator()(std::size_t i) const
+  {
+    claim_result result = found_key;
+    std::size_t slot = view.claim(keys_first[i], result);
+
+    if(result == claimed_slot)
+    {
+      view.values[slot] = values_first[i];
+      view.publish(slot);
+    }
+    else if(result == found_key)
+    {
+      typedef typename View::mapped_type mapped_type;
+
+      ::cuda::std::atomic_ref<mapped_type> value(view.values[slot]);
+      mapped_type x = values_first[i];
+      mapped_type old = value.load(::cuda::std::memory_order_relaxed);
+      while(!value.compare_exchange_weak(old, binary_op(old, x), ::cuda::std::memory_order_relaxed))
+      {
+      }
+    }
+
+    return static_cast<unsigned char>(result);
+  }
+};
+
+
+// moves the entry in slot i of a table into another table
+template<typename View>
+struct rehash_functor
+{
+  View from;
+  View to;
+
+  void operator()(std::size_t i) const
+  {
+    if(from.states[i] == full_slot)
+    {
+      // the new table has room for every key
+      claim_result result = found_key;
+      std::size_t slot = to.claim(from.keys[i], result);
+
+      if(to.values)
+      {
+        to.values[slot] = from.values[i];
+      }
+
+      to.publish(slot);
+    }
+  }
+};
+
+
+template<typename View>
+struct contains_functor
+{
+  View view;
+
+  template<typename Key>
+  bool operator()(const Key &key) const
+  {
+    return view.find(key) != view.capacity();
+  }
+};
+
+
+template<typename View>
+struct find_functor
+{
+  typedef typename View::mapped_type Mapped;
+
+  View   view;
+  Mapped not_found;
+
+  template<typename Key>
+  Mapped operator()(const Key &key) const
+  {
+    std::size_t slot = view.find(key);
+    return slot != view.capacity() ? view.values[slot] : not_found;
+  }
+};
+
+
+struct is_full_slot
+{
+  bool operator()(unsigned char state) const
+  {
+    return state == full_slot;
+  }
+};
+
+
+struct fits_table
+{
+  bool operator()(unsigned char result) const
+  {
+    return result != table_full;
+  }
+};
+
+
+struct is_table_full
+{
+  bool operator()(unsigned char result) const
+  {
+    return result == table_full;
+  }
+};
+
+
+} // end open_addressing_detail
+
+
+// an open addressing hash table with linear probing, which keeps its slot
+// states, keys and values in separate host_vectors and inserts and looks up
+// many keys at once with the parallel algorithms of an execution policy.
+// it's never more than half full: the keys which don't fit in a bulk
+// insertion are inserted again after the table grows, so that its capacity
+// follows the number of distinct keys rather than the number inserted
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  class open_addressing_table
+{
+  private:
+    typedef thrust::detail::allocator_traits<Allocator> alloc_traits;
+
+    static const bool has_values = !thrust::detail::is_same<Mapped, open_addressing_detail::no_mapped_value>::value;
+
+  public:
+    typedef Key         key_type;
+    typedef Mapped      mapped_type;
+    typedef Hash        hasher;
+    typedef KeyEqual    key_equal;
+    typedef Allocator   allocator_type;
+    typedef std::size_t size_type;
+
+    open_addressing_table(size_type n, const Hash &hash, const KeyEqual &equal, const Allocator &alloc);
+
+    size_type size() const { return m_size; }
+
+    size_type capacity() const { return m_states.size(); }
+
+    void clear();
+
+    template<typename DerivedPolicy>
+    void reserve(const thrust::detail::execution_policy_base<DerivedPolicy> &exec, size_type n);
+
+    template<typename DerivedPolicy, typename KeyIterator, typename ValueIterator>
+    size_type insert(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                     KeyIterator keys_first,
+                     KeyIterator keys_last,
+                     ValueIterator values_first);
+
+    template<typename DerivedPolicy, typename KeyIterator, typename ValueIterator, typename BinaryFunction>
+    size_type insert_or_reduce(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                               KeyIterator keys_first,
+                               KeyIterator keys_last,
+                               ValueIterator values_first,
+                               BinaryFunction binary_op);
+
+    template<typename DerivedPolicy, typename KeyIterator, typename OutputIterator>
+    OutputIterator contains(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                            KeyIterator keys_first,
+                            KeyIterator keys_last,
+                            OutputIterator result) const;
+
+    template<typename DerivedPolicy, typename KeyIterator, typename OutputIterator>
+    OutputIterator find(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                        KeyIterator keys_first,
+                        KeyIterator keys_last,
+                        OutputIterator result,
+                        const Mapped &not_found) const;
+
+    template<typename DerivedPolicy, typename KeyOutputIterator>
+    KeyOutputIterator retrieve_keys(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                    KeyOutputIterator keys_result) const;
+
+    template<typename DerivedPolicy, typename KeyOutputIterator, typename ValueOutputIterator>
+    thrust::pair<KeyOutputIterator,ValueOutputIterator>
+    retrieve(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+             KeyOutputIterator keys_result,
+             ValueOutputIterator values_result) const;
+
+  private:
+    typedef open_addressing_detail::table_view<Key,Mapped,Hash,KeyEqual> view_type;
+
+    typedef thrust::host_vector<unsigned char, typename alloc_traits::template rebind_alloc<unsigned char> > state_vector;
+    typedef thrust::host_vector<Key,           typename alloc_traits::template rebind_alloc<Key> >           key_vector;
+    typedef thrust::host_vector<Mapped,        typename alloc_traits::template rebind_alloc<Mapped> >        mapped_vector;
+
+    // the smallest capacity of a table; tables smaller than this aren't worth the allocation
+    static const size_type min_capacity = 16;
+
+    // tables are kept at most 1 / max_load_divisor full, since linear probes
+    // grow long quickly as a table fills up past one half
+    static const size_type max_load_divisor = 2;
+
+    // returns the smallest power of two capacity which keeps n keys at most half full
+    static size_type capacity_for(size_type n);
+
+    view_type view() const;
+
+    // inserts the keys with the given indices with f, growing the table
+    // until every one fits, and returns the number of new keys
+    template<typename DerivedPolicy, typename Function>
+    size_type insert_with(const thrust::detail::execution_policy_base<DerivedPolicy> &exec, size_type n, Function f);
+
+    template<typename DerivedPolicy>
+    void rehash(const thrust::detail::execution_policy_base<DerivedPolicy> &exec, size_type new_capacity);
+
+    state_vector  m_states;
+    key_vector    m_keys;
+    mapped_vector m_values;
+    size_type     m_size;
+    Hash          m_hash;
+    KeyEqual      m_equal;
+};
+
+
+} // end detail
+THRUST_NAMESPACE_END
+
+#include <thrust/detail/open_addressing_table.inl>
+
+#endif // _CCCL_STD_VER >= 2011
@@ -0,0 +1,305 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/open_addressing_table.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/distance.h>
+#include <thrust/fill.h>
+#include <thrust/for_each.h>
+#include <thrust/transform.h>
+#include <thrust/count.h>
+#include <thrust/remove.h>
+#include <thrust/copy.h>
+#include <thrust/functional.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace detail
+{
+
+
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>
+    ::open_addressing_table(size_type n, const Hash &hash, const KeyEqual &equal, const Allocator &alloc)
+      : m_states(capacity_for(n), typename state_vector::allocator_type(alloc)),
+        m_keys(capacity_for(n), typename key_vector::allocator_type(alloc)),
+        m_values(has_values ? capacity_for(n) : 0, typename mapped_vector::allocator_type(alloc)),
+        m_size(0),
+        m_hash(hash),
+        m_equal(equal)
+{
+} // end open_addressing_table::open_addressing_table()
+
+
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  void open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>
+    ::clear()
+{
+  thrust::fill(m_states.begin(), m_states.end(), static_cast<unsigned char>(open_addressing_detail::empty_slot));
+  m_size = 0;
+} // end open_addressing_table::clear()
+
+
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy>
+    void open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>
+      ::reserve(const thrust::detail::execution_policy_base<DerivedPolicy> &exec, size_type n)
+{
+  size_type new_capacity = capacity_for(n);
+
+  if(new_capacity > capacity())
+  {
+    rehash(exec, new_capacity);
+  }
+} // end open_addressing_table::reserve()
+
+
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy, typename KeyIterator, typename ValueIterator>
+    typename open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>::size_type
+      open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>
+        ::insert(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 KeyIterator keys_first,
+                 KeyIterator keys_last,
+                 ValueIterator values_first)
+{
+  open_addressing_detail::insert_functor<view_type,KeyIterator,ValueIterator> f = {view(), keys_first, values_first};
+
+  return insert_with(exec, thrust::distance(keys_first, keys_last), f);
+} // end open_addressing_table::insert()
+
+
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy, typename KeyIterator, typename ValueIterator, typename BinaryFunction>
+    typename open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>::size_type
+      open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>
+        ::insert_or_reduce(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                           KeyIterator keys_first,
+                           KeyIterator keys_last,
+                           ValueIterator values_first,
+                           BinaryFunction binary_op)
+{
+  open_addressing_detail::insert_or_reduce_functor<view_type,KeyIterator,ValueIterator,BinaryFunction> f = {view(), keys_first, values_first, binary_op};
+
+  return insert_with(exec, thrust::distance(keys_first, keys_last), f);
+} // end open_addressing_table::insert_or_reduce()
+
+
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy, typename KeyIterator, typename OutputIterator>
+    OutputIterator open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>
+      ::contains(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 KeyIterator keys_first,
+                 KeyIterator keys_last,
+                 OutputIterator result) const
+{
+  open_addressing_detail::contains_functor<view_type> f = {view()};
+
+  return thrust::transform(exec, keys_first, keys_last, result, f);
+} // end open_addressing_table::contains()
+
+
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy, typename KeyIterator, typename OutputIterator>
+    OutputIterator open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>
+      ::find(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+             KeyIterator keys_first,
+             KeyIterator keys_last,
+             OutputIterator result,
+             const Mapped &not_found) const
+{
+  open_addressing_detail::find_functor<view_type> f = {view(), not_found};
+
+  return thrust::transform(exec, keys_first, keys_last, result, f);
+} // end open_addressing_table::find()
+
+
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy, typename KeyOutputIterator>
+    KeyOutputIterator open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>
+      ::retrieve_keys(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                      KeyOutputIterator keys_result) const
+{
+  return thrust::copy_if(exec, m_keys.begin(), m_keys.end(), m_states.begin(), keys_result, open_addressing_detail::is_full_slot());
+} // end open_addressing_table::retrieve_keys()
+
+
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy, typename KeyOutputIterator, typename ValueOutputIterator>
+    thrust::pair<KeyOutputIterator,ValueOutputIterator>
+      open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>
+        ::retrieve(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   KeyOutputIterator keys_result,
+                   ValueOutputIterator values_result) const
+{
+  thrust::zip_iterator<thrust::tuple<KeyOutputIterator,ValueOutputIterator> > result_end =
+    thrust::copy_if(exec,
+                    thrust::make_zip_iterator(thrust::make_tuple(m_keys.begin(), m_values.begin())),
+                    thrust::make_zip_iterator(thrust::make_tuple(m_keys.end(), m_values.end())),
+                    m_states.begin(),
+                    thrust::make_zip_iterator(thrust::make_tuple(keys_result, values_result)),
+                    open_addressing_detail::is_full_slot());
+
+  return thrust::make_pair(thrust::get<0>(result_end.get_iterator_tuple()),
+                           thrust::get<1>(result_end.get_iterator_tuple()));
+} // end open_addressing_table::retrieve()
+
+
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  typename open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>::size_type
+    open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>
+      ::capacity_for(size_type n)
+{
+  size_type capacity = min_capacity;
+  while(capacity < max_load_divisor * n)
+  {
+    capacity *= 2;
+  }
+
+  return capacity;
+} // end open_addressing_table::capacity_for()
+
+
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  typename open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>::view_type
+    open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>
+      ::view() const
+{
+  // lookups only read through the view
+  view_type result = {
+    const_cast<unsigned char*>(thrust::raw_pointer_cast(m_states.data())),
+    const_cast<Key*>(thrust::raw_pointer_cast(m_keys.data())),
+    has_values ? const_cast<Mapped*>(thrust::raw_pointer_cast(m_values.data())) : static_cast<Mapped*>(0),
+    const_cast<size_type*>(&m_size),
+    capacity() / max_load_divisor,
+    capacity() - 1,
+    m_hash,
+    m_equal
+  };
+
+  return result;
+} // end open_addressing_table::view()
+
+
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy, typename Function>
+    typename open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>::size_type
+      open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>
+        ::insert_with(const thrust::detail::execution_policy_base<DerivedPolicy> &exec, size_type n, Function f)
+{
+  DerivedPolicy &policy = thrust::detail::derived_cast(thrust::detail::strip_const(exec));
+
+  const size_type old_size = m_size;
+  size_type pass_size = m_size;
+
+  // the claim_result of every key of a pass
+  thrust::detail::temporary_array<unsigned char,DerivedPolicy> results(0, policy, n);
+
+  f.view = view();
+  thrust::transform(policy,
+                    thrust::counting_iterator<size_type>(0),
+                    thrust::counting_iterator<size_type>(n),
+                    results.begin(),
+                    f);
+
+  size_type num_left = thrust::count_if(policy, results.begin(), results.end(), open_addressing_detail::is_table_full());
+
+  if(num_left > 0)
+  {
+    // the indices of the keys which didn't fit
+    thrust::detail::temporary_array<size_type,DerivedPolicy> left(0, policy, num_left);
+    thrust::copy_if(policy,
+                    thrust::counting_iterator<size_type>(0),
+                    thrust::counting_iterator<size_type>(n),
+                    results.begin(),
+                    left.begin(),
+                    open_addressing_detail::is_table_full());
+
+    size_type num_decided = n - num_left;
+
+    while(num_left > 0)
+    {
+      // estimate the number of new keys left from the fraction of new keys
+      // among the keys the last pass decided, and grow to fit them. the
+      // table at least doubles, and never grows past room for every key left
+      size_type num_claimed = m_size - pass_size;
+      size_type estimate = num_decided == 0 ? num_left :
+        static_cast<size_type>(static_cast<double>(num_left) * num_claimed / num_decided);
+
+      size_type new_capacity = (std::max)(capacity_for(m_size + estimate), 2 * capacity());
+      new_capacity = (std::min)(new_capacity, capacity_for(m_size + num_left));
+
+      if(new_capacity > capacity())
+      {
+        rehash(policy, new_capacity);
+      }
+
+      pass_size = m_size;
+
+      f.view = view();
+      thrust::transform(policy, left.begin(), left.begin() + num_left, results.begin(), f);
+
+      size_type still_left = thrust::remove_if(policy,
+                                               left.begin(),
+                                               left.begin() + num_left,
+                                               results.begin(),
+                                               open_addressing_detail::fits_table()) - left.begin();
+
+      num_decided = num_left - still_left;
+      num_left = still_left;
+    }
+  }
+
+  return m_size - old_size;
+} // end open_addressing_table::insert_with()
+
+
+template<typename Key, typename Mapped, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy>
+    void open_addressing_table<Key,Mapped,Hash,KeyEqual,Allocator>
+      ::rehash(const thrust::detail::execution_policy_base<DerivedPolicy> &exec, size_type new_capacity)
+{
+  // capacities are powers of two, so this table has exactly new_capacity slots
+  open_addressing_table other(new_capacity / 2, m_hash, m_equal, Allocator(m_states.get_allocator()));
+
+  open_addressing_detail::rehash_functor<view_type> f = {view(), other.view()};
+
+  thrust::for_each(exec,
+                   thrust::counting_iterator<size_type>(0),
+                   thrust::counting_iterator<size_type>(capacity()),
+                   f);
+
+  m_states.swap(other.m_states);
+  m_keys.swap(other.m_keys);
+  m_values.swap(other.m_values);
+} // end open_addressing_table::rehash()
+
+
+} // end detail
+THRUST_NAMESPACE_END
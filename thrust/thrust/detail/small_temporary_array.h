@@ -0,0 +1,147 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file small_temporary_array.h
+ *  \brief Temporary storage for host algorithms which keeps a few elements inline.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/raw_pointer_cast.h>
+
+#include <cstddef>
+#include <new>
+
+THRUST_NAMESPACE_BEGIN
+namespace detail
+{
+
+
+// the number of elements small_temporary_array keeps inline by default:
+// one element per thread of hosts with up to 64 hardware threads
+const std::size_t small_temporary_array_default_capacity = 64;
+
+
+// the most bytes small_temporary_array keeps inline, whatever its capacity:
+// a small part of the smallest stacks threads commonly get, so that arrays
+// of large elements don't take up the frames of the algorithms
+const std::size_t small_temporary_array_max_inline_bytes = 1024;
+
+
+// a temporary_array for the per-thread bookkeeping of the host systems,
+// whose size is bounded by the number of threads: up to N elements are
+// kept inline, up to small_temporary_array_max_inline_bytes, and only
+// larger arrays are allocated through System.
+// the elements are value-initialized, like those of temporary_array, and
+// are accessed through raw pointers, so System must be a host system
+template<typename T, typename System, std::size_t N = small_temporary_array_default_capacity>
+  class small_temporary_array
+{
+  public:
+    typedef T           value_type;
+    typedef T&          reference;
+    typedef const T&    const_reference;
+    typedef T*          pointer;
+    typedef const T*    const_pointer;
+    typedef T*          iterator;
+    typedef const T*    const_iterator;
+    typedef std::size_t size_type;
+
+    // the number of elements kept inline
+    static const size_type inline_capacity =
+      N * sizeof(T) <= small_temporary_array_max_inline_bytes ? N : small_temporary_array_max_inline_bytes / sizeof(T);
+
+    small_temporary_array(thrust::execution_policy<System> &system, size_type n)
+      : m_heap(system, n <= inline_capacity ? 0 : n),
+        m_size(n)
+    {
+      if(n <= inline_capacity)
+      {
+        m_begin = reinterpret_cast<T*>(m_buffer);
+
+        for(size_type i = 0; i < n; ++i)
+        {
+          ::new(static_cast<void*>(m_begin + i)) T();
+        }
+      }
+      else
+      {
+        m_begin = thrust::raw_pointer_cast(m_heap.data());
+      }
+    }
+
+    // provide a kill-switch to explicitly avoid initialization
+    small_temporary_array(int uninit, thrust::execution_policy<System> &system, size_type n)
+      : m_heap(uninit, system, n <= inline_capacity ? 0 : n),
+        m_size(n)
+    {
+      m_begin = n <= inline_capacity ? reinterpret_cast<T*>(m_buffer) : thrust::raw_pointer_cast(m_heap.data());
+    }
+
+    ~small_temporary_array()
+    {
+      // the heap array destroys its own elements
+      if(m_size <= inline_capacity)
+      {
+        for(size_type i = 0; i < m_size; ++i)
+        {
+          m_begin[i].~T();
+        }
+      }
+    }
+
+    size_type size() const { return m_size; }
+
+    // true when the elements are kept inline
+    bool is_inline() const { return m_size <= inline_capacity; }
+
+    pointer data() { return m_begin; }
+    const_pointer data() const { return m_begin; }
+
+    iterator begin() { return m_begin; }
+    const_iterator begin() const { return m_begin; }
+
+    iterator end() { return m_begin + m_size; }
+    const_iterator end() const { return m_begin + m_size; }
+
+    reference operator[](size_type i) { return m_begin[i]; }
+    const_reference operator[](size_type i) const { return m_begin[i]; }
+
+  private:
+    // the inline storage points into the array itself
+    small_temporary_array(const small_temporary_array &);
+    small_temporary_array &operator=(const small_temporary_array &);
+
+    alignas(T) unsigned char m_buffer[inline_capacity > 0 ? inline_capacity * sizeof(T) : 1];
+    temporary_array<T,System> m_heap;
+    size_type m_size;
+    T *m_begin;
+}; // end small_temporary_array
+
+
+} // end detail
+THRUST_NAMESPACE_END
@@ -43,6 +43,21 @@
 
 THRUST_NAMESPACE_BEGIN
 
+/*! \p default_init_t is the type of \p default_init.
+ */
+struct default_init_t
+{
+  _CCCL_HOST_DEVICE
+  constexpr default_init_t() {}
+};
+
+/*! \p default_init selects default-initialization, rather than value-initialization, of the new elements of a vector
+ *  when passed to its constructors and to \p resize: elements of types with trivial default constructors, like
+ *  arithmetic types, are left uninitialized instead of being set to zero, which saves writing memory that's about to be
+ *  overwritten. Elements of other types are default constructed as usual.
+ */
+THRUST_INLINE_CONSTANT default_init_t default_init;
+
 namespace detail
 {
 
@@ -91,6 +106,21 @@ template<typename T, typename Alloc>
      */
     explicit vector_base(size_type n, const Alloc &alloc);
 
+    /*! This constructor creates a vector_base with default-initialized
+     *  elements, which are left uninitialized if their default constructor
+     *  is trivial.
+     *  \param n The number of elements to create.
+     */
+    vector_base(size_type n, default_init_t);
+
+    /*! This constructor creates a vector_base with default-initialized
+     *  elements, which are left uninitialized if their default constructor
+     *  is trivial.
+     *  \param n The number of elements to create.
+     *  \param alloc The allocator to use by this vector_base.
+     */
+    vector_base(size_type n, default_init_t, const Alloc &alloc);
+
     /*! This constructor creates a vector_base with copies
      *  of an exemplar element.
      *  \param n The number of elements to initially create.
@@ -229,6 +259,18 @@ template<typename T, typename Alloc>
      */
     void resize(size_type new_size, const value_type &x);
 
+    /*! \brief Resizes this vector_base to the specified number of elements.
+     *  \param new_size Number of elements this vector_base should contain.
+     *  \throw std::length_error If n exceeds max_size().
+     *
+     *  This method will resize this vector_base to the specified number of
+     *  elements. If the number is smaller than this vector_base's current
+     *  size this vector_base is truncated, otherwise this vector_base is
+     *  extended and new elements are default-initialized, which leaves them
+     *  uninitialized if their default constructor is trivial.
+     */
+    void resize(size_type new_size, default_init_t);
+
     /*! Returns the number of elements in this vector_base.
      */
     _CCCL_HOST_DEVICE
@@ -423,6 +465,15 @@ template<typename T, typename Alloc>
      */
     void push_back(const value_type &x);
 
+  #if _CCCL_STD_VER >= 2011
+    /*! This method appends an element constructed in place from the given
+     *  arguments to the end of this vector_base.
+     *  \param args The arguments to construct the element from.
+     */
+    template<typename... Args>
+      void emplace_back(Args&&... args);
+  #endif
+
     /*! This method erases the last element of this vector_base, invalidating
      *  all iterators and references to it.
      */
@@ -523,6 +574,8 @@ template<typename T, typename Alloc>
 
     void default_init(size_type n);
 
+    void default_initialized_init(size_type n);
+
     void fill_init(size_type n, const T &x);
 
     // these methods resolve the ambiguity of the insert() template of form (iterator, InputIterator, InputIterator)
@@ -533,8 +586,15 @@ template<typename T, typename Alloc>
     template<typename InputIteratorOrIntegralType>
       void insert_dispatch(iterator position, InputIteratorOrIntegralType n, InputIteratorOrIntegralType x, true_type);
 
-    // this method appends n default-constructed elements at the end
-    void append(size_type n);
+    // this method moves the elements to storage for new_capacity elements, growing the current storage in place
+    // when the allocator can
+    void relocate_storage(size_type new_capacity);
+
+    // this method returns the capacity to grow to for appending n elements
+    size_type grown_capacity(size_type n) const;
+
+    // this method appends n value-initialized elements at the end, or default-initialized ones if not value_init
+    void append(size_type n, bool value_init = true);
 
     // this method performs insertion from a fill value
     void fill_insert(iterator position, size_type n, const T &x);
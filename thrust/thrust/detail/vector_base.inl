@@ -79,6 +79,24 @@ template<typename T, typename Alloc>
   default_init(n);
 } // end vector_base::vector_base()
 
+template<typename T, typename Alloc>
+  vector_base<T,Alloc>
+    ::vector_base(size_type n, default_init_t)
+      :m_storage(),
+       m_size(0)
+{
+  default_initialized_init(n);
+} // end vector_base::vector_base()
+
+template<typename T, typename Alloc>
+  vector_base<T,Alloc>
+    ::vector_base(size_type n, default_init_t, const Alloc &alloc)
+      :m_storage(alloc),
+       m_size(0)
+{
+  default_initialized_init(n);
+} // end vector_base::vector_base()
+
 template<typename T, typename Alloc>
   vector_base<T,Alloc>
     ::vector_base(size_type n, const value_type &value)
@@ -250,10 +268,23 @@ template<typename T, typename Alloc>
     m_storage.allocate(n);
     m_size = n;
 
-    m_storage.default_construct_n(begin(), size());
+    m_storage.default_construct_allocated_n(begin(), size());
   } // end if
 } // end vector_base::default_init()
 
+template<typename T, typename Alloc>
+  void vector_base<T,Alloc>
+    ::default_initialized_init(size_type n)
+{
+  if(n > 0)
+  {
+    m_storage.allocate(n);
+    m_size = n;
+
+    m_storage.default_init_n(begin(), size());
+  } // end if
+} // end vector_base::default_initialized_init()
+
 template<typename T, typename Alloc>
   void vector_base<T,Alloc>
     ::fill_init(size_type n, const T &x)
@@ -374,6 +405,22 @@ template<typename T, typename Alloc>
   } // end else
 } // end vector_base::resize()
 
+template<typename T, typename Alloc>
+  void vector_base<T,Alloc>
+    ::resize(size_type new_size, default_init_t)
+{
+  if(new_size < size())
+  {
+    iterator new_end = begin();
+    thrust::advance(new_end, new_size);
+    erase(new_end, end());
+  } // end if
+  else
+  {
+    append(new_size - size(), false);
+  } // end else
+} // end vector_base::resize()
+
 template<typename T, typename Alloc>
   _CCCL_HOST_DEVICE
   typename vector_base<T,Alloc>::size_type
@@ -398,38 +445,8 @@ template<typename T, typename Alloc>
 {
   if(n > capacity())
   {
-    // compute the new capacity after the allocation
-    size_type new_capacity = n;
-
     // do not exceed maximum storage
-    new_capacity = thrust::min THRUST_PREVENT_MACRO_SUBSTITUTION <size_type>(new_capacity, max_size());
-
-    // create new storage
-    storage_type new_storage(copy_allocator_t(), m_storage, new_capacity);
-
-    // record how many constructors we invoke in the try block below
-    iterator new_end = new_storage.begin();
-
-    try
-    {
-      // construct copy all elements into the newly allocated storage
-      new_end = m_storage.uninitialized_copy(begin(), end(), new_storage.begin());
-    } // end try
-    catch(...)
-    {
-      // something went wrong, so destroy & deallocate the new storage
-      new_storage.destroy(new_storage.begin(), new_end);
-      new_storage.deallocate();
-
-      // rethrow
-      throw;
-    } // end catch
-
-    // call destructors on the elements in the old storage
-    m_storage.destroy(begin(), end());
-
-    // record the vector's new state
-    m_storage.swap(new_storage);
+    relocate_storage(thrust::min THRUST_PREVENT_MACRO_SUBSTITUTION <size_type>(n, max_size()));
   } // end if
 } // end vector_base::reserve()
 
@@ -666,9 +683,46 @@ template<typename T, typename Alloc>
   void vector_base<T,Alloc>
     ::push_back(const value_type &x)
 {
-  insert(end(), x);
+  if(size() < capacity())
+  {
+    // we've got room; construct the new element in place
+    m_storage.construct_one(end(), x);
+  } // end if
+  else
+  {
+    // x may be an element of this vector, which growing the storage moves
+    value_type copy(x);
+
+    relocate_storage(grown_capacity(1));
+    m_storage.construct_one(end(), copy);
+  } // end else
+
+  ++m_size;
 } // end vector_base::push_back()
 
+#if _CCCL_STD_VER >= 2011
+template<typename T, typename Alloc>
+  template<typename... Args>
+    void vector_base<T,Alloc>
+      ::emplace_back(Args&&... args)
+{
+  if(size() < capacity())
+  {
+    m_storage.emplace_one(end(), std::forward<Args>(args)...);
+  } // end if
+  else
+  {
+    // the arguments may refer to elements of this vector, which growing the storage moves
+    value_type x(std::forward<Args>(args)...);
+
+    relocate_storage(grown_capacity(1));
+    m_storage.emplace_one(end(), std::move(x));
+  } // end else
+
+  ++m_size;
+} // end vector_base::emplace_back()
+#endif
+
 template<typename T, typename Alloc>
   void vector_base<T,Alloc>
     ::pop_back(void)
@@ -925,7 +979,55 @@ template<typename T, typename Alloc>
 
 template<typename T, typename Alloc>
   void vector_base<T,Alloc>
-    ::append(size_type n)
+    ::relocate_storage(size_type new_capacity)
+{
+  // first try to grow the storage in place, which moves the elements with it
+  if(m_storage.try_reallocate(new_capacity))
+  {
+    return;
+  } // end if
+
+  // create new storage
+  storage_type new_storage(copy_allocator_t(), m_storage, new_capacity);
+
+  try
+  {
+    // move all elements into the newly allocated storage; they're left in the old storage if this throws
+    m_storage.uninitialized_relocate(begin(), end(), new_storage.begin());
+  } // end try
+  catch(...)
+  {
+    // something went wrong, so deallocate the new storage
+    new_storage.deallocate();
+
+    // rethrow
+    throw;
+  } // end catch
+
+  // record the vector's new state
+  m_storage.swap(new_storage);
+} // end vector_base::relocate_storage()
+
+template<typename T, typename Alloc>
+  typename vector_base<T,Alloc>::size_type
+    vector_base<T,Alloc>
+      ::grown_capacity(size_type n) const
+{
+  const size_type old_size = size();
+
+  // compute the new capacity after the allocation
+  size_type new_capacity = old_size + thrust::max THRUST_PREVENT_MACRO_SUBSTITUTION (old_size, n);
+
+  // allocate exponentially larger new storage
+  new_capacity = thrust::max THRUST_PREVENT_MACRO_SUBSTITUTION <size_type>(new_capacity, 2 * capacity());
+
+  // do not exceed maximum storage
+  return thrust::min THRUST_PREVENT_MACRO_SUBSTITUTION <size_type>(new_capacity, max_size());
+} // end vector_base::grown_capacity()
+
+template<typename T, typename Alloc>
+  void vector_base<T,Alloc>
+    ::append(size_type n, bool value_init)
 {
   if(n != 0)
   {
@@ -934,7 +1036,14 @@ template<typename T, typename Alloc>
       // we've got room for all of them
 
       // default construct new elements at the end of the vector
-      m_storage.default_construct_n(end(), n);
+      if(value_init)
+      {
+        m_storage.default_construct_n(end(), n);
+      } // end if
+      else
+      {
+        m_storage.default_init_n(end(), n);
+      } // end else
 
       // extend the size
       m_size += n;
@@ -942,47 +1051,58 @@ template<typename T, typename Alloc>
     else
     {
       const size_type old_size = size();
+      const size_type old_capacity = capacity();
+      const size_type new_capacity = grown_capacity(n);
 
-      // compute the new capacity after the allocation
-      size_type new_capacity = old_size + thrust::max THRUST_PREVENT_MACRO_SUBSTITUTION (old_size, n);
-
-      // allocate exponentially larger new storage
-      new_capacity = thrust::max THRUST_PREVENT_MACRO_SUBSTITUTION <size_type>(new_capacity, 2 * capacity());
-
-      // do not exceed maximum storage
-      new_capacity = thrust::min THRUST_PREVENT_MACRO_SUBSTITUTION <size_type>(new_capacity, max_size());
-
-      // create new storage
-      storage_type new_storage(copy_allocator_t(), m_storage, new_capacity);
-
-      // record how many constructors we invoke in the try block below
-      iterator new_end = new_storage.begin();
-
-      try
+      if(m_storage.try_reallocate(new_capacity))
       {
-        // construct copy all elements into the newly allocated storage
-        new_end = m_storage.uninitialized_copy(begin(), end(), new_storage.begin());
-
-        // construct new elements to insert
-        new_storage.default_construct_n(new_end, n);
-        new_end += n;
-      } // end try
-      catch(...)
+        // the storage grew in place; the elements past the old capacity haven't been written to, but the ones
+        // between the old size and the old capacity may have been
+        if(value_init)
+        {
+          m_storage.default_construct_n(end(), old_capacity - old_size);
+          m_storage.default_construct_allocated_n(begin() + old_capacity, n - (old_capacity - old_size));
+        } // end if
+        else
+        {
+          m_storage.default_init_n(end(), n);
+        } // end else
+      } // end if
+      else
       {
-        // something went wrong, so destroy & deallocate the new storage
-        new_storage.destroy(new_storage.begin(), new_end);
-        new_storage.deallocate();
+        // create new storage
+        storage_type new_storage(copy_allocator_t(), m_storage, new_capacity);
 
-        // rethrow
-        throw;
-      } // end catch
-
-      // call destructors on the elements in the old storage
-      m_storage.destroy(begin(), end());
+        // construct new elements to insert
+        if(value_init)
+        {
+          new_storage.default_construct_allocated_n(new_storage.begin() + old_size, n);
+        } // end if
+        else
+        {
+          new_storage.default_init_n(new_storage.begin() + old_size, n);
+        } // end else
+
+        try
+        {
+          // move all elements into the newly allocated storage
+          m_storage.uninitialized_relocate(begin(), end(), new_storage.begin());
+        } // end try
+        catch(...)
+        {
+          // something went wrong, so destroy & deallocate the new storage
+          new_storage.destroy(new_storage.begin() + old_size, new_storage.begin() + old_size + n);
+          new_storage.deallocate();
+
+          // rethrow
+          throw;
+        } // end catch
+
+        // record the vector's new state
+        m_storage.swap(new_storage);
+      } // end else
 
-      // record the vector's new state
-      m_storage.swap(new_storage);
-      m_size    = old_size + n;
+      m_size = old_size + n;
     } // end else
   } // end if
 } // end vector_base::append()
@@ -1156,7 +1276,7 @@ template<typename T, typename Alloc>
   else if(size() >= n)
   {
     // we can already accomodate the new range
-    iterator new_end = thrust::copy(first, last, begin());
+    iterator new_end = m_storage.copy_assign(first, last, begin());
 
     // destroy the elements we don't need
     m_storage.destroy(new_end, end());
@@ -1175,7 +1295,7 @@ template<typename T, typename Alloc>
     // copy to elements which already exist
     RandomAccessIterator mid = first;
     thrust::advance(mid, size());
-    thrust::copy(first, mid, begin());
+    m_storage.copy_assign(first, mid, begin());
 
     // uninitialize_copy to elements which must be constructed
     m_storage.uninitialized_copy(mid, last, end());
@@ -1199,7 +1319,7 @@ template<typename T, typename Alloc>
   else if(n > size())
   {
     // fill to existing elements
-    thrust::fill(begin(), end(), x);
+    m_storage.fill_assign_n(begin(), size(), x);
 
     // construct uninitialized elements
     m_storage.uninitialized_fill_n(end(), n - size(), x);
@@ -1210,7 +1330,7 @@ template<typename T, typename Alloc>
   else
   {
     // fill to existing elements
-    iterator new_end = thrust::fill_n(begin(), n, x);
+    iterator new_end = m_storage.fill_assign_n(begin(), n, x);
 
     // erase the elements after the fill
     erase(new_end, end());
@@ -103,6 +103,23 @@ template<typename T, typename Alloc = thrust::device_allocator<T> >
     explicit device_vector(size_type n, const Alloc &alloc)
       :Parent(n,alloc) {}
 
+    /*! This constructor creates a \p device_vector with the given
+     *  size, whose elements are default-initialized: they are left
+     *  uninitialized if their default constructor is trivial.
+     *  \param n The number of elements to initially create.
+     */
+    device_vector(size_type n, default_init_t)
+      :Parent(n,default_init_t()) {}
+
+    /*! This constructor creates a \p device_vector with the given
+     *  size, whose elements are default-initialized: they are left
+     *  uninitialized if their default constructor is trivial.
+     *  \param n The number of elements to initially create.
+     *  \param alloc The allocator to use by this device_vector.
+     */
+    device_vector(size_type n, default_init_t, const Alloc &alloc)
+      :Parent(n,default_init_t(),alloc) {}
+
     /*! This constructor creates a \p device_vector with copies
      *  of an exemplar element.
      *  \param n The number of elements to initially create.
@@ -257,6 +274,18 @@ template<typename T, typename Alloc = thrust::device_allocator<T> >
      */
     void resize(size_type new_size, const value_type &x = value_type());
 
+    /*! \brief Resizes this vector to the specified number of elements.
+     *  \param new_size Number of elements this vector should contain.
+     *  \throw std::length_error If n exceeds max_size().
+     *
+     *  This method will resize this vector to the specified number of
+     *  elements.  If the number is smaller than this vector's current
+     *  size this vector is truncated, otherwise this vector is
+     *  extended and new elements are default-initialized, which leaves
+     *  them uninitialized if their default constructor is trivial.
+     */
+    void resize(size_type new_size, default_init_t);
+
     /*! Returns the number of elements in this vector.
      */
     size_type size(void) const;
@@ -427,6 +456,13 @@ template<typename T, typename Alloc = thrust::device_allocator<T> >
      */
     void push_back(const value_type &x);
 
+    /*! This method appends an element constructed in place from the given
+     *  arguments to the end of this vector.
+     *  \param args The arguments to construct the element from.
+     */
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+
     /*! This method erases the last element of this vector, invalidating
      *  all iterators and references to it.
      */
@@ -0,0 +1,271 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file host_unordered_map.h
+ *  \brief A hash map which resides in memory accessible to hosts, and which
+ *         inserts and looks up many keys at once in parallel.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp11_required.h>
+
+#if _CCCL_STD_VER >= 2011
+
+#include <thrust/detail/open_addressing_table.h>
+#include <thrust/functional.h>
+#include <thrust/pair.h>
+
+#include <functional>
+#include <memory>
+
+THRUST_NAMESPACE_BEGIN
+
+/*! \addtogroup container_classes Container Classes
+ *  \addtogroup host_containers Host Containers
+ *  \ingroup container_classes
+ *  \{
+ */
+
+/*! A \p host_unordered_map is a hash map whose keys and mapped values reside
+ *  in memory accessible to hosts. Instead of inserting and looking up one key
+ *  at a time, it inserts and looks up ranges of keys with the parallel
+ *  algorithms of an execution policy, such as \p thrust::omp::par or
+ *  \p thrust::tbb::par, so that hash based grouping and deduplication can
+ *  replace sorting followed by \p reduce_by_key or \p unique.
+ *
+ *  The map uses open addressing with linear probing. Slot states, keys and
+ *  mapped values are kept in separate arrays, and threads claim slots with
+ *  atomic operations on their states, so concurrent insertions don't take
+ *  locks. The map is never more than half full: the keys of a bulk insertion
+ *  which don't fit are inserted again after the map grows, so that its
+ *  capacity follows the number of distinct keys rather than the number of
+ *  keys inserted. Insertions and lookups must not run concurrently with each
+ *  other.
+ *
+ *  The key ranges passed to bulk operations must be random access.
+ *
+ *  \tparam Key The type of keys, which must be default constructible and
+ *          copy assignable.
+ *  \tparam T The type of mapped values. \p insert_or_reduce requires it to be
+ *          trivially copyable.
+ *  \tparam Hash The hash function of keys. Its results are mixed, so that the
+ *          identity hashes of integers work well.
+ *  \tparam KeyEqual The equality of keys.
+ *  \tparam Allocator The allocator, which is rebound to allocate the arrays
+ *          of slots.
+ *
+ *  \see host_unordered_set
+ *  \see reduce_by_key
+ */
+template<typename Key,
+         typename T,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = thrust::equal_to<Key>,
+         typename Allocator = std::allocator<thrust::pair<const Key, T> > >
+  class host_unordered_map
+{
+  private:
+    typedef detail::open_addressing_table<Key,T,Hash,KeyEqual,Allocator> table_type;
+
+  public:
+    typedef Key         key_type;
+    typedef T           mapped_type;
+    typedef Hash        hasher;
+    typedef KeyEqual    key_equal;
+    typedef Allocator   allocator_type;
+    typedef std::size_t size_type;
+
+    /*! This constructor creates an empty \p host_unordered_map with room for
+     *  \p n keys.
+     *
+     *  \param n The number of keys to make room for.
+     *  \param hash The hash function.
+     *  \param equal The equality of keys.
+     *  \param alloc The allocator.
+     */
+    explicit host_unordered_map(size_type n = 0,
+                                const Hash &hash = Hash(),
+                                const KeyEqual &equal = KeyEqual(),
+                                const Allocator &alloc = Allocator())
+      : m_table(n, hash, equal, alloc) {}
+
+    /*! Returns the number of keys in this \p host_unordered_map.
+     */
+    size_type size() const { return m_table.size(); }
+
+    /*! Returns true if this \p host_unordered_map has no keys.
+     */
+    bool empty() const { return size() == 0; }
+
+    /*! Returns the number of slots of this \p host_unordered_map.
+     */
+    size_type capacity() const { return m_table.capacity(); }
+
+    /*! Removes all keys from this \p host_unordered_map, keeping its slots.
+     */
+    void clear() { m_table.clear(); }
+
+    /*! Makes room for \p n keys, rehashing the keys already in this
+     *  \p host_unordered_map in parallel if it has to grow.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param n The number of keys to make room for.
+     */
+    template<typename DerivedPolicy>
+    void reserve(const thrust::detail::execution_policy_base<DerivedPolicy> &exec, size_type n)
+    {
+      m_table.reserve(exec, n);
+    }
+
+    /*! Inserts the keys of <tt>[keys_first, keys_last)</tt>, mapped to the
+     *  corresponding values of the range beginning at \p values_first. Keys
+     *  which are already in this \p host_unordered_map keep their values; of
+     *  keys which occur several times in the input, one is inserted.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param keys_first The beginning of the keys.
+     *  \param keys_last The end of the keys.
+     *  \param values_first The beginning of the values.
+     *  \return The number of keys inserted.
+     */
+    template<typename DerivedPolicy, typename KeyIterator, typename ValueIterator>
+    size_type bulk_insert(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          KeyIterator keys_first,
+                          KeyIterator keys_last,
+                          ValueIterator values_first)
+    {
+      return m_table.insert(exec, keys_first, keys_last, values_first);
+    }
+
+    /*! Inserts the keys of <tt>[keys_first, keys_last)</tt> like
+     *  \p bulk_insert, but combines the value of every key which is already
+     *  in this \p host_unordered_map, or inserted earlier by the same call,
+     *  with the value mapped to it: the value becomes
+     *  <tt>binary_op(value, x)</tt>. The values are combined with atomic
+     *  operations, in an unspecified order, so \p binary_op should be
+     *  associative and commutative.
+     *
+     *  For example, summing values by key in one pass, where
+     *  \p reduce_by_key would need the keys to be sorted first:
+     *
+     *  \code
+     *  #include <thrust/host_unordered_map.h>
+     *  #include <thrust/system/omp/execution_policy.h>
+     *  ...
+     *  thrust::host_unordered_map<int, float> sums;
+     *  sums.insert_or_reduce(thrust::omp::par, keys.begin(), keys.end(), values.begin(), thrust::plus<float>());
+     *
+     *  thrust::host_vector<int>   unique_keys(sums.size());
+     *  thrust::host_vector<float> totals(sums.size());
+     *  sums.retrieve_all(thrust::omp::par, unique_keys.begin(), totals.begin());
+     *  \endcode
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param keys_first The beginning of the keys.
+     *  \param keys_last The end of the keys.
+     *  \param values_first The beginning of the values.
+     *  \param binary_op The function which combines values.
+     *  \return The number of keys inserted.
+     */
+    template<typename DerivedPolicy, typename KeyIterator, typename ValueIterator, typename BinaryFunction>
+    size_type insert_or_reduce(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                               KeyIterator keys_first,
+                               KeyIterator keys_last,
+                               ValueIterator values_first,
+                               BinaryFunction binary_op)
+    {
+      return m_table.insert_or_reduce(exec, keys_first, keys_last, values_first, binary_op);
+    }
+
+    /*! Looks up the keys of <tt>[keys_first, keys_last)</tt>, and writes the
+     *  value mapped to each to the range beginning at \p result, or
+     *  \p not_found for the keys which aren't in this \p host_unordered_map.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param keys_first The beginning of the keys.
+     *  \param keys_last The end of the keys.
+     *  \param result The beginning of the output.
+     *  \param not_found The value written for missing keys.
+     *  \return The end of the output.
+     */
+    template<typename DerivedPolicy, typename KeyIterator, typename OutputIterator>
+    OutputIterator bulk_find(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                             KeyIterator keys_first,
+                             KeyIterator keys_last,
+                             OutputIterator result,
+                             const T &not_found = T()) const
+    {
+      return m_table.find(exec, keys_first, keys_last, result, not_found);
+    }
+
+    /*! Looks up the keys of <tt>[keys_first, keys_last)</tt>, and writes
+     *  whether each is in this \p host_unordered_map to the range beginning
+     *  at \p result.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param keys_first The beginning of the keys.
+     *  \param keys_last The end of the keys.
+     *  \param result The beginning of the output.
+     *  \return The end of the output.
+     */
+    template<typename DerivedPolicy, typename KeyIterator, typename OutputIterator>
+    OutputIterator bulk_contains(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                 KeyIterator keys_first,
+                                 KeyIterator keys_last,
+                                 OutputIterator result) const
+    {
+      return m_table.contains(exec, keys_first, keys_last, result);
+    }
+
+    /*! Copies the keys of this \p host_unordered_map, in an unspecified
+     *  order, to the range beginning at \p keys_result, and the values
+     *  mapped to them to the range beginning at \p values_result. Both
+     *  ranges must have room for \p size() elements.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param keys_result The beginning of the output keys.
+     *  \param values_result The beginning of the output values.
+     *  \return The ends of the output ranges.
+     */
+    template<typename DerivedPolicy, typename KeyOutputIterator, typename ValueOutputIterator>
+    thrust::pair<KeyOutputIterator,ValueOutputIterator>
+    retrieve_all(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 KeyOutputIterator keys_result,
+                 ValueOutputIterator values_result) const
+    {
+      return m_table.retrieve(exec, keys_result, values_result);
+    }
+
+  private:
+    table_type m_table;
+}; // end host_unordered_map
+
+/*! \} // host_containers
+ */
+
+THRUST_NAMESPACE_END
+
+#endif // _CCCL_STD_VER >= 2011
@@ -0,0 +1,189 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file host_unordered_set.h
+ *  \brief A hash set which resides in memory accessible to hosts, and which
+ *         inserts and looks up many keys at once in parallel.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp11_required.h>
+
+#if _CCCL_STD_VER >= 2011
+
+#include <thrust/detail/open_addressing_table.h>
+#include <thrust/functional.h>
+
+#include <functional>
+#include <memory>
+
+THRUST_NAMESPACE_BEGIN
+
+/*! \addtogroup container_classes Container Classes
+ *  \addtogroup host_containers Host Containers
+ *  \ingroup container_classes
+ *  \{
+ */
+
+/*! A \p host_unordered_set is a hash set whose keys reside in memory
+ *  accessible to hosts. Like \p host_unordered_map, it inserts and looks up
+ *  ranges of keys with the parallel algorithms of an execution policy, so
+ *  that hash based deduplication can replace sorting followed by \p unique.
+ *  Insertions and lookups must not run concurrently with each other.
+ *
+ *  The key ranges passed to bulk operations must be random access.
+ *
+ *  \tparam Key The type of keys, which must be default constructible and
+ *          copy assignable.
+ *  \tparam Hash The hash function of keys.
+ *  \tparam KeyEqual The equality of keys.
+ *  \tparam Allocator The allocator, which is rebound to allocate the arrays
+ *          of slots.
+ *
+ *  \see host_unordered_map
+ *  \see unique
+ */
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = thrust::equal_to<Key>,
+         typename Allocator = std::allocator<Key> >
+  class host_unordered_set
+{
+  private:
+    typedef detail::open_addressing_detail::no_mapped_value no_mapped_value;
+    typedef detail::open_addressing_table<Key,no_mapped_value,Hash,KeyEqual,Allocator> table_type;
+
+  public:
+    typedef Key         key_type;
+    typedef Key         value_type;
+    typedef Hash        hasher;
+    typedef KeyEqual    key_equal;
+    typedef Allocator   allocator_type;
+    typedef std::size_t size_type;
+
+    /*! This constructor creates an empty \p host_unordered_set with room for
+     *  \p n keys.
+     *
+     *  \param n The number of keys to make room for.
+     *  \param hash The hash function.
+     *  \param equal The equality of keys.
+     *  \param alloc The allocator.
+     */
+    explicit host_unordered_set(size_type n = 0,
+                                const Hash &hash = Hash(),
+                                const KeyEqual &equal = KeyEqual(),
+                                const Allocator &alloc = Allocator())
+      : m_table(n, hash, equal, alloc) {}
+
+    /*! Returns the number of keys in this \p host_unordered_set.
+     */
+    size_type size() const { return m_table.size(); }
+
+    /*! Returns true if this \p host_unordered_set has no keys.
+     */
+    bool empty() const { return size() == 0; }
+
+    /*! Returns the number of slots of this \p host_unordered_set.
+     */
+    size_type capacity() const { return m_table.capacity(); }
+
+    /*! Removes all keys from this \p host_unordered_set, keeping its slots.
+     */
+    void clear() { m_table.clear(); }
+
+    /*! Makes room for \p n keys, rehashing the keys already in this
+     *  \p host_unordered_set in parallel if it has to grow.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param n The number of keys to make room for.
+     */
+    template<typename DerivedPolicy>
+    void reserve(const thrust::detail::execution_policy_base<DerivedPolicy> &exec, size_type n)
+    {
+      m_table.reserve(exec, n);
+    }
+
+    /*! Inserts the keys of <tt>[keys_first, keys_last)</tt> which aren't in
+     *  this \p host_unordered_set yet.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param keys_first The beginning of the keys.
+     *  \param keys_last The end of the keys.
+     *  \return The number of keys inserted.
+     */
+    template<typename DerivedPolicy, typename KeyIterator>
+    size_type bulk_insert(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          KeyIterator keys_first,
+                          KeyIterator keys_last)
+    {
+      // sets keep no values, so there are none to read
+      return m_table.insert(exec, keys_first, keys_last, static_cast<const no_mapped_value*>(0));
+    }
+
+    /*! Looks up the keys of <tt>[keys_first, keys_last)</tt>, and writes
+     *  whether each is in this \p host_unordered_set to the range beginning
+     *  at \p result.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param keys_first The beginning of the keys.
+     *  \param keys_last The end of the keys.
+     *  \param result The beginning of the output.
+     *  \return The end of the output.
+     */
+    template<typename DerivedPolicy, typename KeyIterator, typename OutputIterator>
+    OutputIterator bulk_contains(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                 KeyIterator keys_first,
+                                 KeyIterator keys_last,
+                                 OutputIterator result) const
+    {
+      return m_table.contains(exec, keys_first, keys_last, result);
+    }
+
+    /*! Copies the keys of this \p host_unordered_set, in an unspecified
+     *  order, to the range beginning at \p result, which must have room for
+     *  \p size() elements.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param result The beginning of the output.
+     *  \return The end of the output.
+     */
+    template<typename DerivedPolicy, typename OutputIterator>
+    OutputIterator retrieve_all(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                OutputIterator result) const
+    {
+      return m_table.retrieve_keys(exec, result);
+    }
+
+  private:
+    table_type m_table;
+}; // end host_unordered_set
+
+/*! \} // host_containers
+ */
+
+THRUST_NAMESPACE_END
+
+#endif // _CCCL_STD_VER >= 2011
@@ -109,6 +109,25 @@ template<typename T, typename Alloc = std::allocator<T> >
     explicit host_vector(size_type n, const Alloc &alloc)
       :Parent(n,alloc) {}
 
+    /*! This constructor creates a \p host_vector with the given
+     *  size, whose elements are default-initialized: they are left
+     *  uninitialized if their default constructor is trivial.
+     *  \param n The number of elements to initially create.
+     */
+    _CCCL_HOST
+    host_vector(size_type n, default_init_t)
+      :Parent(n,default_init_t()) {}
+
+    /*! This constructor creates a \p host_vector with the given
+     *  size, whose elements are default-initialized: they are left
+     *  uninitialized if their default constructor is trivial.
+     *  \param n The number of elements to initially create.
+     *  \param alloc The allocator to use by this host_vector.
+     */
+    _CCCL_HOST
+    host_vector(size_type n, default_init_t, const Alloc &alloc)
+      :Parent(n,default_init_t(),alloc) {}
+
     /*! This constructor creates a \p host_vector with copies
      *  of an exemplar element.
      *  \param n The number of elements to initially create.
@@ -280,6 +299,18 @@ template<typename T, typename Alloc = std::allocator<T> >
      */
     void resize(size_type new_size, const value_type &x = value_type());
 
+    /*! \brief Resizes this vector to the specified number of elements.
+     *  \param new_size Number of elements this vector should contain.
+     *  \throw std::length_error If n exceeds max_size().
+     *
+     *  This method will resize this vector to the specified number of
+     *  elements.  If the number is smaller than this vector's current
+     *  size this vector is truncated, otherwise this vector is
+     *  extended and new elements are default-initialized, which leaves
+     *  them uninitialized if their default constructor is trivial.
+     */
+    void resize(size_type new_size, default_init_t);
+
     /*! Returns the number of elements in this vector.
      */
     size_type size(void) const;
@@ -293,6 +324,11 @@ template<typename T, typename Alloc = std::allocator<T> >
      *         Otherwise, this method is a request for allocation of additional memory. If
      *         the request is successful, then capacity() is greater than or equal to
      *         n; otherwise, capacity() is unchanged. In either case, size() is unchanged.
+     *
+     *         Elements are moved to the new storage; bitwise when they are trivially
+     *         relocatable, in which case storage allocated through an \p mr::allocator
+     *         whose resource can reallocate (like \p mr::mmap_memory_resource) is
+     *         grown in place when possible.
      *  \throw std::length_error If n exceeds max_size().
      */
     void reserve(size_type n);
@@ -450,6 +486,13 @@ template<typename T, typename Alloc = std::allocator<T> >
      */
     void push_back(const value_type &x);
 
+    /*! This method appends an element constructed in place from the given
+     *  arguments to the end of this vector.
+     *  \param args The arguments to construct the element from.
+     */
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+
     /*! This method erases the last element of this vector, invalidating
      *  all iterators and references to it.
      */
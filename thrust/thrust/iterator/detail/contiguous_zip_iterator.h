@@ -0,0 +1,126 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+#include <thrust/type_traits/integer_sequence.h>
+#include <thrust/type_traits/logical_metafunctions.h>
+#include <thrust/tuple.h>
+#include <thrust/system/cpp/detail/execution_policy.h>
+
+#include <type_traits>
+
+THRUST_NAMESPACE_BEGIN
+namespace detail
+{
+
+// Whether Iterator is a zip_iterator of contiguous iterators only, i.e. a
+// structure of arrays.
+template <typename Iterator>
+struct is_contiguous_zip_iterator : false_type {};
+
+template <typename... Iterators>
+struct is_contiguous_zip_iterator<thrust::zip_iterator<thrust::tuple<Iterators...>>>
+  : thrust::conjunction<thrust::is_contiguous_iterator<Iterators>...> {};
+
+// The number of iterators zipped together by a zip_iterator.
+template <typename Iterator>
+struct zip_iterator_size;
+
+template <typename... Iterators>
+struct zip_iterator_size<thrust::zip_iterator<thrust::tuple<Iterators...>>>
+  : integral_constant<std::size_t, sizeof...(Iterators)> {};
+
+// Whether a copy from InputIterator to OutputIterator can copy column by
+// column: both are zips of the same number of contiguous iterators.
+template <typename InputIterator, typename OutputIterator>
+struct is_contiguous_zip_copy : false_type {};
+
+template <typename... InputIterators, typename... OutputIterators>
+struct is_contiguous_zip_copy<thrust::zip_iterator<thrust::tuple<InputIterators...>>,
+                              thrust::zip_iterator<thrust::tuple<OutputIterators...>>>
+  : integral_constant<bool,
+      sizeof...(InputIterators) == sizeof...(OutputIterators) &&
+      is_contiguous_zip_iterator<thrust::zip_iterator<thrust::tuple<InputIterators...>>>::value &&
+      is_contiguous_zip_iterator<thrust::zip_iterator<thrust::tuple<OutputIterators...>>>::value> {};
+
+// Whether Iterator is contiguous and its memory can be accessed through raw
+// pointers on the host, because its system is a host system. The policies of
+// the host systems derive from those of the cpp system.
+template <typename Iterator>
+struct is_host_contiguous_iterator
+  : integral_constant<bool,
+      is_contiguous_iterator<Iterator>::value &&
+      std::is_base_of<thrust::system::cpp::detail::execution_policy<typename thrust::iterator_system<Iterator>::type>,
+                      typename thrust::iterator_system<Iterator>::type>::value> {};
+
+// Unwraps contiguous iterators of host systems like
+// try_unwrap_contiguous_iterator, and those zipped together by zip_iterators,
+// at any depth, so that host loops over structures of arrays dereference raw
+// pointers instead of the iterators and reference proxies of a system. The
+// other iterators of a zip, including contiguous iterators of device memory,
+// are kept.
+template <typename Iterator>
+struct try_unwrap_zipped_contiguous_iterator_impl
+  : try_unwrap_contiguous_iterator_impl<Iterator, is_host_contiguous_iterator<Iterator>::value> {};
+
+template <typename... Iterators>
+struct try_unwrap_zipped_contiguous_iterator_impl<thrust::zip_iterator<thrust::tuple<Iterators...>>>
+{
+  using type = thrust::zip_iterator<
+    thrust::tuple<typename try_unwrap_zipped_contiguous_iterator_impl<Iterators>::type...>>;
+
+  static _CCCL_HOST_DEVICE type get(thrust::zip_iterator<thrust::tuple<Iterators...>> it)
+  {
+    return get(it.get_iterator_tuple(), thrust::make_index_sequence<sizeof...(Iterators)>{});
+  }
+
+private:
+  template <std::size_t... Is>
+  static _CCCL_HOST_DEVICE type get(const thrust::tuple<Iterators...> &iterators, thrust::index_sequence<Is...>)
+  {
+    return type(thrust::make_tuple(
+      try_unwrap_zipped_contiguous_iterator_impl<Iterators>::get(thrust::get<Is>(iterators))...));
+  }
+};
+
+template <typename Iterator>
+using try_unwrap_zipped_contiguous_iterator_return_t =
+  typename try_unwrap_zipped_contiguous_iterator_impl<Iterator>::type;
+
+template <typename Iterator>
+_CCCL_HOST_DEVICE
+try_unwrap_zipped_contiguous_iterator_return_t<Iterator>
+try_unwrap_zipped_contiguous_iterator(Iterator it)
+{
+  return try_unwrap_zipped_contiguous_iterator_impl<Iterator>::get(it);
+}
+
+} // namespace detail
+THRUST_NAMESPACE_END
@@ -85,6 +85,10 @@ public:
     typedef detail::true_type propagate_on_container_move_assignment;
     /*! Specifies that the allocator shall be propagated on container swap. */
     typedef detail::true_type propagate_on_container_swap;
+    /*! Specifies whether the memory allocated by this allocator reads as zeros until written to. */
+    typedef typename is_zero_filled_resource<MR>::type zero_filled_memory;
+    /*! Specifies whether this allocator can reallocate the storage it allocated with \p reallocate. */
+    typedef typename is_reallocatable_resource<MR>::type reallocatable_memory;
 
     /*! The \p rebind metafunction provides the type of an \p allocator instantiated with another type.
      *
@@ -148,6 +152,22 @@ public:
         return mem_res->do_deallocate(p, n * sizeof(T), THRUST_ALIGNOF(T));
     }
 
+    /*! Grows or shrinks storage allocated by this allocator, possibly moving it; the contents of the storage are moved
+     *      bitwise. Only available when \p reallocatable_memory is \p true_type.
+     *
+     *  \param p pointer returned by a previous call to \p allocate or \p reallocate
+     *  \param old_n number of elements of the storage pointed to by \p p
+     *  \param new_n number of elements to reallocate the storage to
+     *  \return a pointer to the reallocated storage, which replaces \p p; or null if the storage can't be reallocated,
+     *      in which case \p p is left untouched.
+     */
+    THRUST_NODISCARD
+    _CCCL_HOST
+    pointer reallocate(pointer p, size_type old_n, size_type new_n)
+    {
+        return static_cast<pointer>(mem_res->reallocate(p, old_n * sizeof(T), new_n * sizeof(T), THRUST_ALIGNOF(T)));
+    }
+
     /*! Extracts the memory resource used by this allocator.
      *
      *  \return the memory resource used by this allocator.
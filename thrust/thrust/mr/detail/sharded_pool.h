@@ -0,0 +1,302 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file
+ *  \brief Per-thread shards of cached blocks in front of a mutex-synchronized pool resource.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp11_required.h>
+
+#if _CCCL_STD_VER >= 2011
+
+#include <thrust/detail/algorithm_wrapper.h>
+#include <thrust/detail/integer_math.h>
+#include <thrust/mr/new.h>
+#include <thrust/mr/pool_options.h>
+#include <thrust/mr/detail/size_classes.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+namespace detail
+{
+
+/*! Returns a small integer identifying the calling thread; threads are numbered in the order in which they first
+ *      call this function.
+ */
+inline std::size_t this_thread_shard_index()
+{
+    static std::atomic<std::size_t> next_index(0);
+    static thread_local std::size_t index = next_index++;
+    return index;
+}
+
+/*! Wraps a pool resource, \p Pool, in a mutex, and puts a set of shards in front of it. Each thread is assigned a shard,
+ *      and each shard caches, for every pool of \p Pool, a byte budget's worth of free blocks, and at least a couple of
+ *      blocks of the pools whose blocks exceed the budget, behind its own mutex. Allocations and
+ *      deallocations of pooled blocks only touch the calling thread's shard; the mutex of \p Pool is only taken to move a
+ *      batch of blocks between a shard and \p Pool, when the shard runs out of blocks of a size or holds too many of
+ *      them, and for oversized and overaligned blocks, which always go straight to \p Pool.
+ *
+ *  A block may be deallocated to a different shard than the one it was allocated from. This is fine, because the shards
+ *      don't own any memory: every block belongs to a chunk of \p Pool, and cached blocks are only forgotten, never
+ *      returned upstream, when \p Pool releases its chunks.
+ *
+ *  \tparam Pool the type of the wrapped pool resource
+ */
+template<typename Pool>
+class sharded_pool
+{
+    typedef typename Pool::pointer void_ptr;
+    typedef std::lock_guard<std::mutex> lock_t;
+
+    // the size of a cache line on x86-64 and most ARM cores
+    static const std::size_t shard_alignment = 64;
+
+    // shards are aligned to, and padded to a multiple of, the size of a cache line, so that the mutexes of different
+    // shards don't share cache lines
+    struct alignas(shard_alignment) shard
+    {
+        shard() : rounding_bytes(0)
+        {
+        }
+
+        std::mutex mtx;
+        std::vector<std::vector<void_ptr> > free_blocks;
+        // the bytes by which the blocks allocated through this shard exceed their requests, less the same for the
+        // blocks deallocated through it; only the sum over all shards is meaningful
+        std::size_t rounding_bytes;
+    };
+
+    // shards are allocated with their alignment, which plain new doesn't respect before C++17
+    struct shard_deleter
+    {
+        void operator()(shard * s) const
+        {
+            s->~shard();
+            mr::new_delete_resource().do_deallocate(s, sizeof(shard), alignof(shard));
+        }
+    };
+
+public:
+    /*! Constructor.
+     *
+     *  \param num_shards the number of shards; zero selects the number of hardware threads
+     *  \param options pool options to use
+     *  \param args the arguments to the constructor of \p Pool, which are followed by \p options
+     */
+    template<typename... Args>
+    sharded_pool(std::size_t num_shards, mr::pool_options options, Args &&... args)
+        : m_options(options),
+        m_size_classes(m_options, std::allocator<std::size_t>()),
+        m_pool(std::forward<Args>(args)..., options)
+    {
+        if (num_shards == 0)
+        {
+            num_shards = std::thread::hardware_concurrency();
+        }
+        if (num_shards == 0)
+        {
+            num_shards = 1;
+        }
+
+        std::size_t num_pools = m_size_classes.size();
+
+        m_shards.reserve(num_shards);
+        for (std::size_t i = 0; i < num_shards; ++i)
+        {
+            void * p = mr::new_delete_resource().do_allocate(sizeof(shard), alignof(shard));
+            m_shards.emplace_back(new (p) shard());
+            m_shards.back()->free_blocks.resize(num_pools);
+        }
+    }
+
+    /*! Returns the fragmentation statistics of \p Pool, with the blocks cached in shards counted as free. The result is
+     *      only exact when no other thread is using the pool.
+     */
+    mr::pool_fragmentation_statistics fragmentation_statistics()
+    {
+        std::size_t cached_bytes = 0;
+        std::size_t rounding_bytes = 0;
+        for (std::size_t i = 0; i < m_shards.size(); ++i)
+        {
+            lock_t lock(m_shards[i]->mtx);
+            for (std::size_t j = 0; j < m_shards[i]->free_blocks.size(); ++j)
+            {
+                cached_bytes += m_shards[i]->free_blocks[j].size() * m_size_classes.class_size(j);
+            }
+            rounding_bytes += m_shards[i]->rounding_bytes;
+        }
+
+        lock_t lock(m_mtx);
+        mr::pool_fragmentation_statistics ret = m_pool.fragmentation_statistics();
+
+        // the pool sees blocks cached in shards as allocated, and blocks allocated through shards as requested whole
+        ret.allocated_bytes -= cached_bytes;
+        ret.requested_bytes -= cached_bytes + rounding_bytes;
+        return ret;
+    }
+
+    void release()
+    {
+        for (std::size_t i = 0; i < m_shards.size(); ++i)
+        {
+            lock_t lock(m_shards[i]->mtx);
+            for (std::size_t j = 0; j < m_shards[i]->free_blocks.size(); ++j)
+            {
+                m_shards[i]->free_blocks[j].clear();
+            }
+            m_shards[i]->rounding_bytes = 0;
+        }
+
+        lock_t lock(m_mtx);
+        m_pool.release();
+    }
+
+    void_ptr do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        std::size_t size_class = 0;
+        std::size_t capacity = cache_capacity(bytes, alignment, size_class);
+
+        if (capacity == 0)
+        {
+            lock_t lock(m_mtx);
+            return m_pool.do_allocate(bytes, alignment);
+        }
+
+        shard & s = this_thread_shard();
+        lock_t shard_lock(s.mtx);
+        std::vector<void_ptr> & blocks = s.free_blocks[size_class];
+        std::size_t block_size = m_size_classes.class_size(size_class);
+
+        // refill half of the cache, so that a thread alternating between allocations and deallocations doesn't move
+        // blocks back and forth between the shard and the pool on every call
+        if (blocks.empty())
+        {
+            blocks.reserve(capacity);
+
+            lock_t lock(m_mtx);
+            for (std::size_t i = 0; i < (capacity + 1) / 2; ++i)
+            {
+                blocks.push_back(m_pool.do_allocate(block_size, m_options.alignment));
+            }
+        }
+
+        s.rounding_bytes += block_size - bytes;
+
+        void_ptr ret = blocks.back();
+        blocks.pop_back();
+        return ret;
+    }
+
+    void do_deallocate(void_ptr p, std::size_t n, std::size_t alignment)
+    {
+        std::size_t size_class = 0;
+        std::size_t capacity = cache_capacity(n, alignment, size_class);
+
+        if (capacity == 0)
+        {
+            lock_t lock(m_mtx);
+            m_pool.do_deallocate(p, n, alignment);
+            return;
+        }
+
+        shard & s = this_thread_shard();
+        lock_t shard_lock(s.mtx);
+        std::vector<void_ptr> & blocks = s.free_blocks[size_class];
+        std::size_t block_size = m_size_classes.class_size(size_class);
+
+        s.rounding_bytes -= block_size - n;
+
+        // return half of a full cache to the pool, so that blocks freed by a thread other than the one which allocated
+        // them become available to every thread
+        if (blocks.size() >= capacity)
+        {
+            lock_t lock(m_mtx);
+            while (blocks.size() > capacity / 2)
+            {
+                m_pool.do_deallocate(blocks.back(), block_size, m_options.alignment);
+                blocks.pop_back();
+            }
+        }
+
+        blocks.push_back(p);
+    }
+
+private:
+    // the bytes of a size class a shard caches: enough small blocks that refills are rare, while the shards of idle
+    // threads hold little memory
+    static const std::size_t max_cached_bytes = 16384;
+    // bounds the number of the smallest blocks cached, which a refill takes from the pool under its mutex
+    static const std::size_t max_cached_blocks = 32;
+    // the blocks cached of the size classes larger than the byte budget, so that a thread alternating between
+    // allocating and deallocating a large block doesn't take the mutex of the pool either
+    static const std::size_t min_cached_blocks = 2;
+
+    // the number of blocks the size of a request which a shard may cache, or zero if the request must be forwarded to
+    // the pool; the size class of the request is written to size_class
+    std::size_t cache_capacity(std::size_t bytes, std::size_t alignment, std::size_t & size_class) const
+    {
+        bytes = (std::max)(bytes, m_options.smallest_block_size);
+
+        // oversized and overaligned blocks
+        if (bytes > m_options.largest_block_size || alignment > m_options.alignment)
+        {
+            return 0;
+        }
+
+        size_class = m_size_classes.class_of(bytes);
+
+        std::size_t capacity = max_cached_bytes / m_size_classes.class_size(size_class);
+        return (std::min)((std::max)(capacity, min_cached_blocks), max_cached_blocks);
+    }
+
+    shard & this_thread_shard()
+    {
+        return *m_shards[this_thread_shard_index() % m_shards.size()];
+    }
+
+    mr::pool_options m_options;
+    size_class_table<std::vector<std::size_t> > m_size_classes;
+
+    std::mutex m_mtx;
+    Pool m_pool;
+
+    std::vector<std::unique_ptr<shard, shard_deleter> > m_shards;
+};
+
+} // end detail
+THRUST_NAMESPACE_END
+
+#endif // _CCCL_STD_VER >= 2011
+
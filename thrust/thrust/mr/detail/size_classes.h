@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file
+ *  \brief The table of block sizes of the pools of a pool resource, with a constant time lookup of the pool of a request.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/detail/integer_math.h>
+#include <thrust/detail/raw_reference_cast.h>
+#include <thrust/mr/pool_options.h>
+
+#include <cassert>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+namespace detail
+{
+
+/*! The size classes of a pool resource: the block sizes of its pools, sorted, from \p smallest_block_size to
+ *      \p largest_block_size of its options. Every doubling of the block size is split into
+ *      \p size_classes_per_doubling steps of equal size, which are rounded up to the alignment of the pools; steps that
+ *      round up to the same size share a class.
+ *
+ *  The class of a request is found in constant time: the doubling it falls in and the step within it are computed from
+ *      its size, and a table maps steps to classes.
+ *
+ *  \tparam SizeVector the type of vectors of \p std::size_t the table is kept in
+ */
+template<typename SizeVector>
+class size_class_table
+{
+public:
+    typedef typename SizeVector::allocator_type allocator_type;
+
+    size_class_table(const mr::pool_options & options, const allocator_type & alloc)
+        : m_smallest_block_size(options.smallest_block_size),
+        m_smallest_block_log2(log2_ri(options.smallest_block_size)),
+        m_classes_log2(options.size_classes_per_doubling ? log2_ri(options.size_classes_per_doubling) : 0),
+        m_sizes(alloc),
+        m_class_of_step(alloc)
+    {
+        std::size_t largest_block_log2 = log2_ri(options.largest_block_size);
+
+        std::vector<std::size_t> sizes(1, options.smallest_block_size);
+        std::vector<std::size_t> class_of_step;
+        class_of_step.reserve((largest_block_log2 - m_smallest_block_log2) << m_classes_log2);
+
+        for (std::size_t doubling_log2 = m_smallest_block_log2; doubling_log2 < largest_block_log2; ++doubling_log2)
+        {
+            for (std::size_t step = 1; step <= (static_cast<std::size_t>(1) << m_classes_log2); ++step)
+            {
+                std::size_t size = (static_cast<std::size_t>(1) << doubling_log2)
+                    + (step << (doubling_log2 - m_classes_log2));
+                size = round_i(size, options.alignment);
+
+                if (size != sizes.back())
+                {
+                    sizes.push_back(size);
+                }
+                class_of_step.push_back(sizes.size() - 1);
+            }
+        }
+
+        m_sizes.assign(sizes.begin(), sizes.end());
+        m_class_of_step.assign(class_of_step.begin(), class_of_step.end());
+    }
+
+    /*! Returns the number of size classes.
+     */
+    std::size_t size() const
+    {
+        return m_sizes.size();
+    }
+
+    /*! Returns the block size of a size class.
+     */
+    std::size_t class_size(std::size_t size_class) const
+    {
+        return raw_reference_cast(m_sizes[size_class]);
+    }
+
+    /*! Returns the smallest size class whose blocks fit \p bytes, which must not be bigger than the largest block size.
+     */
+    std::size_t class_of(std::size_t bytes) const
+    {
+        if (bytes <= m_smallest_block_size)
+        {
+            return 0;
+        }
+
+        // bytes is in (2^doubling_log2, 2^(doubling_log2 + 1)], which is split into steps of step_log2 bytes
+        std::size_t doubling_log2 = log2_ri(bytes) - 1;
+        std::size_t step_log2 = doubling_log2 - m_classes_log2;
+        std::size_t step = (bytes - (static_cast<std::size_t>(1) << doubling_log2) - 1) >> step_log2;
+
+        std::size_t size_class = raw_reference_cast(
+            m_class_of_step[((doubling_log2 - m_smallest_block_log2) << m_classes_log2) + step]);
+        assert(class_size(size_class) >= bytes);
+        return size_class;
+    }
+
+private:
+    std::size_t m_smallest_block_size;
+    std::size_t m_smallest_block_log2;
+    std::size_t m_classes_log2;
+
+    SizeVector m_sizes;
+    SizeVector m_class_of_step;
+};
+
+} // end detail
+THRUST_NAMESPACE_END
+
@@ -41,6 +41,7 @@
 #include <thrust/mr/memory_resource.h>
 #include <thrust/mr/allocator.h>
 #include <thrust/mr/pool_options.h>
+#include <thrust/mr/detail/size_classes.h>
 
 #include <cassert>
 
@@ -100,11 +101,13 @@ public:
         ret.largest_block_size = static_cast<std::size_t>(1) << 20;
 
         ret.alignment = THRUST_MR_DEFAULT_ALIGNMENT;
+        ret.size_classes_per_doubling = 1;
 
         ret.cache_oversized = true;
 
         ret.cached_size_cutoff_factor = 16;
         ret.cached_alignment_cutoff_factor = 16;
+        ret.max_cached_oversized_bytes = 0;
 
         return ret;
     }
@@ -120,17 +123,23 @@ public:
         : m_upstream(upstream),
         m_bookkeeper(bookkeeper),
         m_options(options),
-        m_smallest_block_log2(detail::log2_ri(m_options.smallest_block_size)),
+        m_size_classes(m_options, m_bookkeeper),
         m_pools(m_bookkeeper),
         m_allocated(m_bookkeeper),
         m_cached_oversized(m_bookkeeper),
-        m_oversized(m_bookkeeper)
+        m_cached_oversized_by_age(m_bookkeeper),
+        m_oversized(m_bookkeeper),
+        m_cache_clock(0),
+        m_cached_oversized_bytes(0),
+        m_requested_bytes(0),
+        m_allocated_bytes(0),
+        m_pooled_bytes(0)
     {
         assert(m_options.validate());
 
         pointer_vector free(m_bookkeeper);
         pool p(free);
-        m_pools.resize(detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1, p);
+        m_pools.resize(m_size_classes.size(), p);
     }
 
     // TODO: C++11: use delegating constructors
@@ -143,17 +152,23 @@ public:
         : m_upstream(get_global_resource<Upstream>()),
         m_bookkeeper(get_global_resource<Bookkeeper>()),
         m_options(options),
-        m_smallest_block_log2(detail::log2_ri(m_options.smallest_block_size)),
+        m_size_classes(m_options, m_bookkeeper),
         m_pools(m_bookkeeper),
         m_allocated(m_bookkeeper),
         m_cached_oversized(m_bookkeeper),
-        m_oversized(m_bookkeeper)
+        m_cached_oversized_by_age(m_bookkeeper),
+        m_oversized(m_bookkeeper),
+        m_cache_clock(0),
+        m_cached_oversized_bytes(0),
+        m_requested_bytes(0),
+        m_allocated_bytes(0),
+        m_pooled_bytes(0)
     {
         assert(m_options.validate());
 
         pointer_vector free(m_bookkeeper);
         pool p(free);
-        m_pools.resize(detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1, p);
+        m_pools.resize(m_size_classes.size(), p);
     }
 
     /*! Destructor. Releases all held memory to upstream.
@@ -183,6 +198,9 @@ private:
         std::size_t size;
         std::size_t alignment;
         void_ptr pointer;
+        // the value of the cache clock when the block was last cached; orders cached blocks from the least to the most
+        // recently cached
+        std::size_t cached_at;
 
         _CCCL_HOST_DEVICE
         bool operator==(const oversized_block_descriptor & other) const
@@ -193,26 +211,34 @@ private:
         _CCCL_HOST_DEVICE
         bool operator<(const oversized_block_descriptor & other) const
         {
-            return size < other.size || (size == other.size && alignment < other.alignment);
+            return size < other.size || (size == other.size && (alignment < other.alignment
+                || (alignment == other.alignment && cached_at < other.cached_at)));
         }
     };
 
-    struct equal_pointers
+    _CCCL_HOST_DEVICE
+    static detail::intmax_t address_of(void_ptr p)
+    {
+        return reinterpret_cast<detail::intmax_t>(detail::pointer_traits<void_ptr>::get(p));
+    }
+
+    // orders the list of all oversized blocks by address, so that a deallocated block can be found with a binary search
+    struct address_less
     {
-    public:
         _CCCL_HOST_DEVICE
-        equal_pointers(void_ptr p) : p(p)
+        bool operator()(const oversized_block_descriptor & lhs, const oversized_block_descriptor & rhs) const
         {
+            return address_of(lhs.pointer) < address_of(rhs.pointer);
         }
+    };
 
+    struct age_less
+    {
         _CCCL_HOST_DEVICE
-        bool operator()(const oversized_block_descriptor & desc) const
+        bool operator()(const oversized_block_descriptor & lhs, const oversized_block_descriptor & rhs) const
         {
-            return desc.pointer == p;
+            return lhs.cached_at < rhs.cached_at;
         }
-
-    private:
-        void_ptr p;
     };
 
     struct matching_alignment
@@ -275,22 +301,103 @@ private:
         allocator<pool, Bookkeeper>
     > pool_vector;
 
+    typedef thrust::detail::size_class_table<
+        thrust::host_vector<std::size_t, allocator<std::size_t, Bookkeeper> >
+    > size_class_table;
+
     Upstream * m_upstream;
     Bookkeeper * m_bookkeeper;
 
     pool_options m_options;
-    std::size_t m_smallest_block_log2;
+    size_class_table m_size_classes;
 
     // buckets containing free lists for each pooled size
     pool_vector m_pools;
     // list of all allocations from upstream for the above
     chunk_vector m_allocated;
-    // list of all cached oversized/overaligned blocks that have been returned to the pool to cache
+    // list of all cached oversized/overaligned blocks that have been returned to the pool to cache, sorted by size and alignment
     oversized_block_vector m_cached_oversized;
-    // list of all oversized/overaligned allocations from upstream
+    // the same blocks, sorted from the least to the most recently cached
+    oversized_block_vector m_cached_oversized_by_age;
+    // list of all oversized/overaligned allocations from upstream, sorted by address
     oversized_block_vector m_oversized;
+    std::size_t m_cache_clock;
+    std::size_t m_cached_oversized_bytes;
+
+    // the fragmentation statistics of the pools
+    std::size_t m_requested_bytes;
+    std::size_t m_allocated_bytes;
+    std::size_t m_pooled_bytes;
+
+    // finds the descriptor of an oversized/overaligned allocation from upstream
+    typename oversized_block_vector::iterator find_oversized(void_ptr p)
+    {
+        oversized_block_descriptor key;
+        key.size = 0;
+        key.alignment = 0;
+        key.pointer = p;
+        key.cached_at = 0;
+
+        typename oversized_block_vector::iterator it = thrust::lower_bound(
+            thrust::seq,
+            m_oversized.begin(),
+            m_oversized.end(),
+            key,
+            address_less());
+
+        // distinct pointers may share an address, if they point to different memory spaces
+        while (it != m_oversized.end() && !((*it).pointer == p))
+        {
+            ++it;
+        }
+
+        return it;
+    }
+
+    // returns the least recently cached blocks to upstream, until the cached blocks fit in the budget from the options
+    void trim_cached_oversized()
+    {
+        if (m_options.max_cached_oversized_bytes == 0)
+        {
+            return;
+        }
+
+        typename oversized_block_vector::iterator oldest = m_cached_oversized_by_age.begin();
+        while (m_cached_oversized_bytes > m_options.max_cached_oversized_bytes)
+        {
+            oversized_block_descriptor victim = *oldest++;
+
+            typename oversized_block_vector::iterator it = thrust::lower_bound(
+                thrust::seq,
+                m_cached_oversized.begin(),
+                m_cached_oversized.end(),
+                victim);
+            assert(it != m_cached_oversized.end() && (*it).cached_at == victim.cached_at);
+            m_cached_oversized.erase(it);
+
+            it = find_oversized(victim.pointer);
+            assert(it != m_oversized.end());
+            m_oversized.erase(it);
+
+            m_cached_oversized_bytes -= victim.size;
+            m_upstream->do_deallocate(victim.pointer, victim.size, victim.alignment);
+        }
+
+        m_cached_oversized_by_age.erase(m_cached_oversized_by_age.begin(), oldest);
+    }
 
 public:
+    /*! Returns how well the memory in the pools is used; see \p pool_fragmentation_statistics.
+     */
+    pool_fragmentation_statistics fragmentation_statistics() const
+    {
+        pool_fragmentation_statistics ret;
+        ret.requested_bytes = m_requested_bytes;
+        ret.allocated_bytes = m_allocated_bytes;
+        ret.pooled_bytes = m_pooled_bytes;
+        return ret;
+    }
+
     /*! Releases all held memory to upstream.
      */
     void release()
@@ -323,10 +430,17 @@ public:
         m_allocated.clear();
         m_oversized.clear();
         m_cached_oversized.clear();
+        m_cached_oversized_by_age.clear();
+        m_cached_oversized_bytes = 0;
+
+        m_requested_bytes = 0;
+        m_allocated_bytes = 0;
+        m_pooled_bytes = 0;
     }
 
     THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
     {
+        std::size_t requested = bytes;
         bytes = (std::max)(bytes, m_options.smallest_block_size);
         assert(detail::is_power_of_2(alignment));
 
@@ -336,6 +450,7 @@ public:
             oversized_block_descriptor oversized;
             oversized.size = bytes;
             oversized.alignment = alignment;
+            oversized.cached_at = 0;
 
             if (m_options.cache_oversized && !m_cached_oversized.empty())
             {
@@ -376,46 +491,58 @@ public:
 
                 if (it != m_cached_oversized.end())
                 {
-                    oversized.pointer = (*it).pointer;
+                    oversized = *it;
                     m_cached_oversized.erase(it);
+
+                    typename oversized_block_vector::iterator by_age = thrust::lower_bound(
+                        thrust::seq,
+                        m_cached_oversized_by_age.begin(),
+                        m_cached_oversized_by_age.end(),
+                        oversized,
+                        age_less());
+                    assert(by_age != m_cached_oversized_by_age.end() && (*by_age).cached_at == oversized.cached_at);
+                    m_cached_oversized_by_age.erase(by_age);
+
+                    m_cached_oversized_bytes -= oversized.size;
                     return oversized.pointer;
                 }
             }
 
             // no fitting cached block found; allocate a new one that's just up to the specs
             oversized.pointer = m_upstream->do_allocate(bytes, alignment);
-            m_oversized.push_back(oversized);
+            m_oversized.insert(
+                thrust::lower_bound(thrust::seq, m_oversized.begin(), m_oversized.end(), oversized, address_less()),
+                oversized);
 
             return oversized.pointer;
         }
 
         // the request is NOT for oversized and/or overaligned memory
         // allocate a block from an appropriate bucket
-        std::size_t bytes_log2 = thrust::detail::log2_ri(bytes);
-        std::size_t bucket_idx = bytes_log2 - m_smallest_block_log2;
+        std::size_t bucket_idx = m_size_classes.class_of(bytes);
         pool & bucket = m_pools[bucket_idx];
 
+        std::size_t bucket_size = m_size_classes.class_size(bucket_idx);
+
         // if the free list of the bucket has no elements, allocate a new chunk
         // and split it into blocks pushed to the free list
         if (bucket.free_blocks.empty())
         {
-            std::size_t bucket_size = static_cast<std::size_t>(1) << bytes_log2;
-
             std::size_t n = bucket.previous_allocated_count;
             if (n == 0)
             {
                 n = m_options.min_blocks_per_chunk;
-                if (n < (m_options.min_bytes_per_chunk >> bytes_log2))
+                if (n < detail::divide_ri(m_options.min_bytes_per_chunk, bucket_size))
                 {
-                    n = m_options.min_bytes_per_chunk >> bytes_log2;
+                    n = detail::divide_ri(m_options.min_bytes_per_chunk, bucket_size);
                 }
             }
             else
             {
                 n = n * 3 / 2;
-                if (n > (m_options.max_bytes_per_chunk >> bytes_log2))
+                if (n > m_options.max_bytes_per_chunk / bucket_size)
                 {
-                    n = m_options.max_bytes_per_chunk >> bytes_log2;
+                    n = m_options.max_bytes_per_chunk / bucket_size;
                 }
                 if (n > m_options.max_blocks_per_chunk)
                 {
@@ -423,7 +550,7 @@ public:
                 }
             }
 
-            bytes = n << bytes_log2;
+            bytes = n * bucket_size;
 
             assert(n >= m_options.min_blocks_per_chunk);
             assert(n <= m_options.max_blocks_per_chunk);
@@ -435,6 +562,7 @@ public:
             allocated.pointer = m_upstream->do_allocate(bytes, m_options.alignment);
             m_allocated.push_back(allocated);
             bucket.previous_allocated_count = n;
+            m_pooled_bytes += bytes;
 
             for (std::size_t i = 0; i < n; ++i)
             {
@@ -446,6 +574,9 @@ public:
             }
         }
 
+        m_requested_bytes += requested;
+        m_allocated_bytes += bucket_size;
+
         // allocate a block from the front of the bucket's free list
         void_ptr ret = bucket.free_blocks.back();
         bucket.free_blocks.pop_back();
@@ -454,6 +585,7 @@ public:
 
     virtual void do_deallocate(void_ptr p, std::size_t n, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
     {
+        std::size_t requested = n;
         n = (std::max)(n, m_options.smallest_block_size);
         assert(detail::is_power_of_2(alignment));
 
@@ -463,15 +595,21 @@ public:
         // the deallocated block is oversized and/or overaligned
         if (n > m_options.largest_block_size || alignment > m_options.alignment)
         {
-            typename oversized_block_vector::iterator it = find_if(m_oversized.begin(), m_oversized.end(), equal_pointers(p));
+            typename oversized_block_vector::iterator it = find_oversized(p);
             assert(it != m_oversized.end());
 
             oversized_block_descriptor oversized = *it;
 
             if (m_options.cache_oversized)
             {
+                oversized.cached_at = m_cache_clock++;
+
                 typename oversized_block_vector::iterator position = lower_bound(m_cached_oversized.begin(), m_cached_oversized.end(), oversized);
                 m_cached_oversized.insert(position, oversized);
+                m_cached_oversized_by_age.push_back(oversized);
+                m_cached_oversized_bytes += oversized.size;
+
+                trim_cached_oversized();
                 return;
             }
 
@@ -483,10 +621,12 @@ public:
         }
 
         // push the block to the front of the appropriate bucket's free list
-        std::size_t n_log2 = thrust::detail::log2_ri(n);
-        std::size_t bucket_idx = n_log2 - m_smallest_block_log2;
+        std::size_t bucket_idx = m_size_classes.class_of(n);
         pool & bucket = m_pools[bucket_idx];
 
+        m_requested_bytes -= requested;
+        m_allocated_bytes -= m_size_classes.class_size(bucket_idx);
+
         bucket.free_blocks.push_back(p);
     }
 };
@@ -33,9 +33,8 @@
 
 #if _CCCL_STD_VER >= 2011
 
-#include <mutex>
-
 #include <thrust/mr/disjoint_pool.h>
+#include <thrust/mr/detail/sharded_pool.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace mr
@@ -47,6 +46,10 @@ namespace mr
  */
 
 /*! A mutex-synchronized version of \p disjoint_unsynchronized_pool_resource. Uses \p std::mutex, and therefore requires C++11.
+ *
+ *  Like \p synchronized_pool_resource, spreads threads over shards caching a few free blocks of every pool, and only
+ *      locks the pool itself to move a batch of blocks between a shard and the pool, and for oversized and overaligned
+ *      blocks.
  *
  *  \tparam Upstream the type of memory resources that will be used for allocating memory blocks to be handed off to the user
  *  \tparam Bookkeeper the type of memory resources that will be used for allocating bookkeeping memory
@@ -55,7 +58,6 @@ template<typename Upstream, typename Bookkeeper>
 struct disjoint_synchronized_pool_resource : public memory_resource<typename Upstream::pointer>
 {
     typedef disjoint_unsynchronized_pool_resource<Upstream, Bookkeeper> unsync_pool;
-    typedef std::lock_guard<std::mutex> lock_t;
 
     typedef typename Upstream::pointer void_ptr;
 
@@ -74,45 +76,51 @@ public:
      *  \param upstream the upstream memory resource for allocations
      *  \param bookkeeper the upstream memory resource for bookkeeping
      *  \param options pool options to use
+     *  \param num_shards the number of shards threads are spread over; zero selects the number of hardware threads
      */
     disjoint_synchronized_pool_resource(Upstream * upstream, Bookkeeper * bookkeeper,
-        pool_options options = get_default_options())
-        : upstream_pool(upstream, bookkeeper, options)
+        pool_options options = get_default_options(), std::size_t num_shards = 0)
+        : upstream_pool(num_shards, options, upstream, bookkeeper)
     {
     }
 
     /*! Constructor. Upstream and bookkeeping resources are obtained by calling \p get_global_resource for their types.
      *
      *  \param options pool options to use
+     *  \param num_shards the number of shards threads are spread over; zero selects the number of hardware threads
+     */
+    disjoint_synchronized_pool_resource(pool_options options = get_default_options(), std::size_t num_shards = 0)
+        : upstream_pool(num_shards, options, get_global_resource<Upstream>(), get_global_resource<Bookkeeper>())
+    {
+    }
+
+    /*! Returns how well the memory in the pools is used; see \p pool_fragmentation_statistics. Blocks cached in shards
+     *      count as free. The result is only exact when no other thread is using the pool.
      */
-    disjoint_synchronized_pool_resource(pool_options options = get_default_options())
-        : upstream_pool(get_global_resource<Upstream>(), get_global_resource<Bookkeeper>(), options)
+    pool_fragmentation_statistics fragmentation_statistics()
     {
+        return upstream_pool.fragmentation_statistics();
     }
 
     /*! Releases all held memory to upstream.
      */
     void release()
     {
-        lock_t lock(mtx);
         upstream_pool.release();
     }
 
     THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
     {
-        lock_t lock(mtx);
         return upstream_pool.do_allocate(bytes, alignment);
     }
 
     virtual void do_deallocate(void_ptr p, std::size_t n, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
     {
-        lock_t lock(mtx);
         upstream_pool.do_deallocate(p, n, alignment);
     }
 
 private:
-    std::mutex mtx;
-    unsync_pool upstream_pool;
+    thrust::detail::sharded_pool<unsync_pool> upstream_pool;
 };
 
 /*! \} // memory_resources
@@ -48,6 +48,11 @@ namespace mr
 /*! Potentially constructs, if not yet created, and then returns the address of a thread-local
  *      \p disjoint_unsynchronized_pool_resource,
  *
+ *  Memory allocated from the returned pool must be deallocated by the same thread. There is no disjoint counterpart of
+ *      \p thread_caching_pool_resource, which accepts deallocations from any thread but keeps its bookkeeping inside the
+ *      blocks, and so doesn't support upstream memory which isn't accessible from the host;
+ *      \p disjoint_synchronized_pool_resource accepts deallocations from any thread for such memory.
+ *
  *  \tparam Upstream the first template argument to the pool template
  *  \tparam Bookkeeper the second template argument to the pool template
  *  \param upstream the first argument to the constructor, if invoked
@@ -32,6 +32,7 @@
 #endif // no system header
 
 #include <thrust/detail/config/memory_resource.h>
+#include <thrust/detail/type_traits.h>
 #ifdef THRUST_MR_STD_MR_HEADER
 #  include THRUST_MR_STD_MR_HEADER
 #endif
@@ -218,6 +219,30 @@ MR * get_global_resource()
     return &resource;
 }
 
+/*! A trait which tells whether all memory allocated from a memory resource of type \p MR reads as zeros until it's
+ *      written to. Containers using \p mr::allocator skip value-initializing arithmetic and pointer elements in memory
+ *      they have just allocated from such a resource. Specialize it as \p true_type for such resources.
+ *
+ *  \tparam MR the type of a memory resource
+ */
+template<typename MR>
+struct is_zero_filled_resource : thrust::detail::false_type
+{
+};
+
+/*! A trait which tells whether a memory resource of type \p MR can grow or shrink an allocation, possibly moving it, with
+ *      a member function <tt>reallocate(p, old_bytes, new_bytes, alignment)</tt>, which returns the reallocated block, or
+ *      null when it can't reallocate it, in which case the block is left untouched. Vectors using \p mr::allocator with
+ *      such a resource grow by reallocating their storage when their elements are trivially relocatable. Specialize it
+ *      as \p true_type for such resources.
+ *
+ *  \tparam MR the type of a memory resource
+ */
+template<typename MR>
+struct is_reallocatable_resource : thrust::detail::false_type
+{
+};
+
 /*! \} // memory_resource
  */
 
@@ -0,0 +1,317 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file mmap.h
+ *  \brief An anonymous memory mapping-based memory resource, with optional huge page backing.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <thrust/detail/integer_math.h>
+#include <thrust/system/detail/bad_alloc.h>
+
+#include <thrust/mr/memory_resource.h>
+
+#include <cassert>
+#include <cstring>
+#include <cerrno>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#  define MAP_ANONYMOUS MAP_ANON
+#endif
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/** \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! A memory resource that maps a fresh region of anonymous memory for every allocation, and unmaps it on deallocation.
+ *      Meant for large, long-lived host allocations, or as the upstream of a pool resource; every allocation takes at
+ *      least a page and a system call.
+ *
+ *  Large mappings can be backed by huge pages, which cut down on TLB misses and page faults when they are first
+ *      touched:
+ *      - \p transparent_huge_pages maps allocations of at least a huge page aligned to a huge page, and asks the kernel
+ *          to back them with transparent huge pages (<tt>madvise(MADV_HUGEPAGE)</tt>), where that is supported.
+ *      - \p explicit_huge_pages maps allocations from the reserved huge page pool (<tt>MAP_HUGETLB</tt>), and falls back
+ *          to transparent huge pages when the pool is exhausted or the flag isn't supported.
+ *
+ *  Freshly mapped memory reads as zeros, so containers using \p mr::allocator with this resource skip value-initializing
+ *      arithmetic and pointer elements; the pages are only faulted in when they are first written to. \p decommit gives
+ *      the pages of an allocation back to the system without unmapping it, after which it reads as zeros again.
+ */
+class mmap_memory_resource final : public memory_resource<>
+{
+public:
+    /*! Selects whether and how allocations are backed by huge pages.
+     */
+    enum huge_page_mode
+    {
+        no_huge_pages,
+        transparent_huge_pages,
+        explicit_huge_pages
+    };
+
+    /*! Constructor.
+     *
+     *  \param mode whether and how allocations are backed by huge pages
+     */
+    mmap_memory_resource(huge_page_mode mode = transparent_huge_pages) : m_mode(mode)
+    {
+    }
+
+    /*! Returns the huge page mode of this resource.
+     */
+    huge_page_mode mode() const
+    {
+        return m_mode;
+    }
+
+    void * do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        assert(detail::is_power_of_2(alignment));
+
+        std::size_t length = mapping_length(bytes);
+        alignment = mapping_alignment(bytes, alignment);
+
+#if defined(MAP_HUGETLB)
+        // huge page mappings are always aligned to the huge page size
+        if (m_mode == explicit_huge_pages && alignment <= huge_page_size)
+        {
+            void * p = ::mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED)
+            {
+                return p;
+            }
+        }
+#endif
+
+        void * p = map_aligned(length, alignment);
+        advise_huge_pages(p, length);
+
+        return p;
+    }
+
+    void do_deallocate(void * p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        (void) alignment;
+        ::munmap(p, mapping_length(bytes));
+    }
+
+    /*! Grows or shrinks an allocation by remapping its pages (<tt>mremap</tt>), without copying its contents. The
+     *      allocation is extended in place when the address space after it is free, and moved to a fresh range of
+     *      addresses otherwise. The pages added to an allocation read as zeros.
+     *
+     *  Only supported on Linux, and not for \p explicit_huge_pages, whose mappings may or may not be backed by huge
+     *      pages; elsewhere, it always fails.
+     *
+     *  \param p the allocation, as returned by \p allocate or \p reallocate
+     *  \param old_bytes the size of the allocation
+     *  \param new_bytes the size to reallocate it to
+     *  \param alignment the alignment of the allocation
+     *  \return the reallocated allocation, which replaces \p p; or null if it can't be reallocated, in which case \p p
+     *      is left untouched
+     */
+    void * reallocate(void * p, std::size_t old_bytes, std::size_t new_bytes,
+        std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT)
+    {
+        assert(detail::is_power_of_2(alignment));
+
+        std::size_t old_length = mapping_length(old_bytes);
+        std::size_t new_length = mapping_length(new_bytes);
+        if (old_length == new_length)
+        {
+            return p;
+        }
+
+#if defined(MREMAP_MAYMOVE) && defined(MREMAP_FIXED)
+        if (m_mode == explicit_huge_pages)
+        {
+            return NULL;
+        }
+
+        alignment = mapping_alignment(new_bytes, alignment);
+
+        // in place, when the allocation is already aligned as a new one of its size would be
+        if (reinterpret_cast<std::size_t>(p) % alignment == 0
+            && ::mremap(p, old_length, new_length, 0) != MAP_FAILED)
+        {
+            advise_huge_pages(p, new_length);
+            return p;
+        }
+
+        // otherwise, into a fresh aligned range, which the move replaces
+        void * target = map_aligned(new_length, alignment);
+        void * moved = ::mremap(p, old_length, new_length, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+        if (moved == MAP_FAILED)
+        {
+            ::munmap(target, new_length);
+            return NULL;
+        }
+
+        advise_huge_pages(moved, new_length);
+        return moved;
+#else
+        (void) alignment;
+        return NULL;
+#endif
+    }
+
+    /*! Returns the physical memory backing an allocation to the system, while keeping it mapped. The allocation reads as
+     *      zeros afterwards, and new pages are faulted in when it is written to again.
+     *
+     *  \param p the allocation, as returned by \p allocate
+     *  \param bytes the size of the allocation
+     */
+    void decommit(void * p, std::size_t bytes)
+    {
+        ::madvise(p, mapping_length(bytes), MADV_DONTNEED);
+    }
+
+private:
+    // the default huge page size of x86-64 and most AArch64 kernels
+    static const std::size_t huge_page_size = static_cast<std::size_t>(2) << 20;
+
+    static std::size_t page_size()
+    {
+        static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    static std::size_t round_up(std::size_t size, std::size_t granularity)
+    {
+        return (size + granularity - 1) / granularity * granularity;
+    }
+
+    // must only depend on the size, since deallocation is told nothing else; the mapping may be backed by huge pages,
+    // which can only be unmapped whole
+    std::size_t mapping_length(std::size_t bytes) const
+    {
+        bytes = bytes ? bytes : 1;
+
+        if (m_mode == explicit_huge_pages || (m_mode == transparent_huge_pages && bytes >= huge_page_size))
+        {
+            return round_up(bytes, huge_page_size);
+        }
+
+        return round_up(bytes, page_size());
+    }
+
+    std::size_t mapping_alignment(std::size_t bytes, std::size_t alignment) const
+    {
+        if (m_mode != no_huge_pages && bytes >= huge_page_size && alignment < huge_page_size)
+        {
+            alignment = huge_page_size;
+        }
+
+        return alignment;
+    }
+
+    static void * map(std::size_t length)
+    {
+        void * p = ::mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+        {
+            throw thrust::system::detail::bad_alloc(std::strerror(errno));
+        }
+
+        return p;
+    }
+
+    void advise_huge_pages(void * p, std::size_t length) const
+    {
+#if defined(MADV_HUGEPAGE)
+        if (m_mode != no_huge_pages && length >= huge_page_size)
+        {
+            // only a hint; failure just means that the mapping is backed by regular pages
+            ::madvise(p, length, MADV_HUGEPAGE);
+        }
+#else
+        (void) p;
+        (void) length;
+#endif
+    }
+
+    // maps length bytes aligned to alignment, by mapping more and unmapping the misaligned head and the tail
+    static void * map_aligned(std::size_t length, std::size_t alignment)
+    {
+        if (alignment <= page_size())
+        {
+            return map(length);
+        }
+
+        std::size_t padded_length = length + alignment - page_size();
+        char * p = static_cast<char *>(map(padded_length));
+
+        std::size_t head = (alignment - reinterpret_cast<std::size_t>(p) % alignment) % alignment;
+        if (head)
+        {
+            ::munmap(p, head);
+        }
+
+        std::size_t tail = padded_length - head - length;
+        if (tail)
+        {
+            ::munmap(p + head + length, tail);
+        }
+
+        return p + head;
+    }
+
+    huge_page_mode m_mode;
+};
+
+/*! Memory freshly mapped by \p mmap_memory_resource reads as zeros.
+ */
+template<>
+struct is_zero_filled_resource<mmap_memory_resource> : thrust::detail::true_type
+{
+};
+
+/*! \p mmap_memory_resource reallocates by remapping pages.
+ */
+template<>
+struct is_reallocatable_resource<mmap_memory_resource> : thrust::detail::true_type
+{
+};
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
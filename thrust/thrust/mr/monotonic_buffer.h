@@ -0,0 +1,319 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file monotonic_buffer.h
+ *  \brief A memory resource adaptor which hands out memory from chunks allocated from upstream by bumping a pointer,
+ *      and only releases it all at once, or rewinds to a checkpoint.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/detail/algorithm_wrapper.h>
+#include <thrust/detail/integer_math.h>
+#include <thrust/detail/numeric_traits.h>
+
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/validator.h>
+
+#include <cassert>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/** \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! A memory resource adaptor which allocates memory in chunks from \p Upstream, and serves requests by bumping a pointer
+ *      through the current chunk. Deallocation does nothing; memory is only given back by \p release and by the
+ *      destructor, which return all chunks to upstream, and by \p rewind, which makes the memory allocated since a
+ *      \p checkpoint available again while keeping the chunks for reuse.
+ *
+ *  This makes allocation almost free, which suits code that allocates a bounded amount of short-lived memory over and
+ *      over again, like the temporary storage of algorithms invoked with an allocator (<tt>thrust::host(alloc)</tt>,
+ *      <tt>thrust::device(alloc)</tt>) for every request of a service: take a checkpoint before the work, and rewind to it
+ *      afterwards. After the first few rounds, the chunks are big enough to serve a whole round without touching upstream.
+ *
+ *  Chunks start at the size given to the constructor and double in size with each new chunk. Like
+ *      \p unsynchronized_pool_resource, this resource keeps the bookkeeping for every chunk in the chunk itself, so memory
+ *      allocated from \p Upstream must be accessible from the host, possibly through smart references. It is not
+ *      thread-safe.
+ *
+ *  \tparam Upstream the type of memory resources that will be used for allocating chunks
+ */
+template<typename Upstream>
+class monotonic_buffer_resource final
+    : public memory_resource<typename Upstream::pointer>,
+        private validator<Upstream>
+{
+    typedef typename Upstream::pointer void_ptr;
+    typedef thrust::detail::pointer_traits<void_ptr> void_ptr_traits;
+    typedef typename void_ptr_traits::template rebind<char>::other char_ptr;
+
+    struct chunk_descriptor;
+    typedef typename void_ptr_traits::template rebind<chunk_descriptor>::other chunk_descriptor_ptr;
+    typedef thrust::detail::pointer_traits<chunk_descriptor_ptr> chunk_ptr_traits;
+
+    // stored right after the usable memory of every chunk; chunks form a list in the order they were allocated in
+    struct chunk_descriptor
+    {
+        std::size_t size;
+        std::size_t alignment;
+        chunk_descriptor_ptr next;
+    };
+
+public:
+    /*! The state of a \p monotonic_buffer_resource, as returned by \p checkpoint and accepted by \p rewind.
+     */
+    class checkpoint_type
+    {
+        friend class monotonic_buffer_resource;
+
+        chunk_descriptor_ptr chunk;
+        std::size_t offset;
+    };
+
+    /*! Takes a checkpoint of a \p monotonic_buffer_resource on construction, and rewinds the resource to it on
+     *      destruction.
+     */
+    class scoped_rewind
+    {
+    public:
+        /*! Constructor.
+         *
+         *  \param resource the resource to rewind at the end of the scope
+         */
+        explicit scoped_rewind(monotonic_buffer_resource & resource)
+            : m_resource(resource), m_checkpoint(resource.checkpoint())
+        {
+        }
+
+        /*! Destructor. Rewinds the resource to the state it was in when this object was constructed.
+         */
+        ~scoped_rewind()
+        {
+            m_resource.rewind(m_checkpoint);
+        }
+
+    private:
+        scoped_rewind(const scoped_rewind &);
+        scoped_rewind & operator=(const scoped_rewind &);
+
+        monotonic_buffer_resource & m_resource;
+        checkpoint_type m_checkpoint;
+    };
+
+    /*! Constructor.
+     *
+     *  \param upstream the upstream memory resource for allocations
+     *  \param initial_size the size of the first chunk allocated from upstream
+     */
+    monotonic_buffer_resource(Upstream * upstream, std::size_t initial_size = default_initial_size)
+        : m_upstream(upstream),
+        m_first(),
+        m_last(),
+        m_current(),
+        m_offset(0),
+        m_next_chunk_size(round_up_size(initial_size))
+    {
+    }
+
+    /*! Constructor. The upstream resource is obtained by calling \p get_global_resource<Upstream>.
+     *
+     *  \param initial_size the size of the first chunk allocated from upstream
+     */
+    monotonic_buffer_resource(std::size_t initial_size = default_initial_size)
+        : m_upstream(get_global_resource<Upstream>()),
+        m_first(),
+        m_last(),
+        m_current(),
+        m_offset(0),
+        m_next_chunk_size(round_up_size(initial_size))
+    {
+    }
+
+    /*! Destructor. Releases all held memory to upstream.
+     */
+    ~monotonic_buffer_resource()
+    {
+        release();
+    }
+
+    /*! Releases all held memory to upstream. All checkpoints taken before become invalid.
+     */
+    void release()
+    {
+        while (chunk_ptr_traits::get(m_first))
+        {
+            chunk_descriptor_ptr chunk = m_first;
+            chunk_descriptor desc = thrust::raw_reference_cast(*chunk);
+            m_first = desc.next;
+
+            m_upstream->do_deallocate(chunk_begin(chunk, desc), desc.size + sizeof(chunk_descriptor), desc.alignment);
+        }
+
+        m_last = chunk_descriptor_ptr();
+        m_current = chunk_descriptor_ptr();
+        m_offset = 0;
+    }
+
+    /*! Returns the current state of the resource, to be passed to \p rewind.
+     */
+    checkpoint_type checkpoint() const
+    {
+        checkpoint_type ret;
+        ret.chunk = m_current;
+        ret.offset = m_offset;
+        return ret;
+    }
+
+    /*! Makes all memory allocated since \p point was taken available for allocation again. The chunks allocated from
+     *      upstream since then are kept, and reused by later allocations. The memory must no longer be in use, and
+     *      checkpoints taken after \p point become invalid.
+     *
+     *  \param point a checkpoint taken from this resource since it was last released
+     */
+    void rewind(const checkpoint_type & point)
+    {
+        m_current = point.chunk;
+        m_offset = point.offset;
+    }
+
+    THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        assert(detail::is_power_of_2(alignment));
+
+        chunk_descriptor_ptr chunk = m_current;
+        std::size_t offset = m_offset;
+        if (!chunk_ptr_traits::get(chunk))
+        {
+            chunk = m_first;
+            offset = 0;
+        }
+
+        // try the current chunk, and then the chunks kept after it by a rewind
+        while (chunk_ptr_traits::get(chunk))
+        {
+            chunk_descriptor desc = thrust::raw_reference_cast(*chunk);
+            char_ptr begin = static_cast<char_ptr>(chunk_begin(chunk, desc));
+
+            std::size_t misalignment = reinterpret_cast<detail::intmax_t>(
+                void_ptr_traits::get(static_cast<void_ptr>(begin + offset))) % alignment;
+            if (misalignment)
+            {
+                offset += alignment - misalignment;
+            }
+
+            if (offset <= desc.size && bytes <= desc.size - offset)
+            {
+                m_current = chunk;
+                m_offset = offset + bytes;
+                return static_cast<void_ptr>(begin + offset);
+            }
+
+            chunk = desc.next;
+            offset = 0;
+        }
+
+        // nothing fits; allocate a new chunk, big enough for the request, and aligned as requested
+        chunk_descriptor desc;
+        desc.size = (std::max)(m_next_chunk_size, round_up_size(bytes));
+        desc.alignment = (std::max)(alignment, static_cast<std::size_t>(THRUST_MR_DEFAULT_ALIGNMENT));
+        desc.next = chunk_descriptor_ptr();
+
+        void_ptr ret = m_upstream->do_allocate(desc.size + sizeof(chunk_descriptor), desc.alignment);
+
+        chunk = static_cast<chunk_descriptor_ptr>(
+            static_cast<void_ptr>(static_cast<char_ptr>(ret) + desc.size));
+        *chunk = desc;
+
+        if (chunk_ptr_traits::get(m_last))
+        {
+            thrust::raw_reference_cast(*m_last).next = chunk;
+        }
+        else
+        {
+            m_first = chunk;
+        }
+        m_last = chunk;
+
+        m_current = chunk;
+        m_offset = bytes;
+
+        if (m_next_chunk_size < max_chunk_size)
+        {
+            m_next_chunk_size *= chunk_growth_factor;
+        }
+
+        return ret;
+    }
+
+    /*! Does nothing; memory is only reclaimed by \p rewind and \p release.
+     */
+    virtual void do_deallocate(void_ptr, std::size_t, std::size_t = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+    }
+
+private:
+    // a single page
+    static const std::size_t default_initial_size = 4096;
+    // doubling keeps the number of chunks, and so of upstream allocations, logarithmic in the memory used
+    static const std::size_t chunk_growth_factor = 2;
+    // past 1GB, doubling would waste more of the last chunk than fewer allocations save
+    static const std::size_t max_chunk_size = static_cast<std::size_t>(1) << 30;
+
+    // keeps the chunk descriptor that follows the usable memory aligned
+    static std::size_t round_up_size(std::size_t size)
+    {
+        const std::size_t granularity = THRUST_MR_DEFAULT_ALIGNMENT;
+        size = (std::max)(size, granularity);
+        return (size + granularity - 1) / granularity * granularity;
+    }
+
+    static void_ptr chunk_begin(chunk_descriptor_ptr chunk, const chunk_descriptor & desc)
+    {
+        return static_cast<void_ptr>(static_cast<char_ptr>(static_cast<void_ptr>(chunk)) - desc.size);
+    }
+
+    Upstream * m_upstream;
+
+    chunk_descriptor_ptr m_first;
+    chunk_descriptor_ptr m_last;
+    // the chunk allocations are currently served from, and the offset of its first free byte
+    chunk_descriptor_ptr m_current;
+    std::size_t m_offset;
+
+    std::size_t m_next_chunk_size;
+};
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
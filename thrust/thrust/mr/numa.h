@@ -0,0 +1,255 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file numa.h
+ *  \brief A memory resource which places its allocations on the NUMA nodes of the system according to a policy.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#if defined(__linux__)
+
+#include <thrust/mr/mmap.h>
+
+#include <cstdio>
+#include <vector>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/** \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! A memory resource that maps its allocations like \p mmap_memory_resource, and asks the kernel to place their pages on
+ *      the NUMA nodes of the system according to a policy:
+ *      - \p first_touch places every page on the node of the thread which first writes to it. Combined with the
+ *          parallel algorithms of the OpenMP and TBB systems, which initialize containers and temporary storage in
+ *          parallel with the same partitioning as most other algorithms, this keeps pages close to the threads which
+ *          process them.
+ *      - \p interleaved spreads the pages over all online nodes, round-robin, which balances the memory bandwidth of the
+ *          nodes for data that's accessed by all threads.
+ *      - \p preferred_node places pages on the given node while it has free memory, and elsewhere after that.
+ *      - \p bound_to_node places pages only on the given node.
+ *
+ *  The policy is applied with the \p mbind system call, without a dependency on \p libnuma. It is a request to the kernel:
+ *      when the system doesn't support it, allocations are placed on first touch. Like with \p mmap_memory_resource,
+ *      memory allocated from this resource reads as zeros until it's written to.
+ */
+class numa_memory_resource final : public memory_resource<>
+{
+public:
+    /*! Selects how the pages of allocations are placed on the NUMA nodes.
+     */
+    enum placement
+    {
+        first_touch,
+        interleaved,
+        preferred_node,
+        bound_to_node
+    };
+
+    /*! Constructor.
+     *
+     *  \param policy how the pages of allocations are placed on the NUMA nodes
+     *  \param node the node used by \p preferred_node and \p bound_to_node
+     *  \param mode whether and how allocations are backed by huge pages
+     */
+    numa_memory_resource(placement policy = interleaved, std::size_t node = 0,
+        mmap_memory_resource::huge_page_mode mode = mmap_memory_resource::transparent_huge_pages)
+        : m_upstream(mode), m_policy(policy), m_node(node)
+    {
+    }
+
+    /*! Returns the number of NUMA nodes of the system, counting up to the highest numbered online node.
+     */
+    static std::size_t node_count()
+    {
+        return online_nodes().size() * bits_per_word - leading_offline_nodes();
+    }
+
+    void * do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        void * p = m_upstream.do_allocate(bytes, alignment);
+
+        if (m_policy != first_touch)
+        {
+            bind(p, bytes);
+        }
+
+        return p;
+    }
+
+    void do_deallocate(void * p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        m_upstream.do_deallocate(p, bytes, alignment);
+    }
+
+    /*! Grows or shrinks an allocation like \p mmap_memory_resource::reallocate, and places the pages of the reallocated
+     *      allocation according to the policy.
+     */
+    void * reallocate(void * p, std::size_t old_bytes, std::size_t new_bytes,
+        std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT)
+    {
+        void * ret = m_upstream.reallocate(p, old_bytes, new_bytes, alignment);
+
+        if (ret && m_policy != first_touch)
+        {
+            bind(ret, new_bytes);
+        }
+
+        return ret;
+    }
+
+private:
+    static const std::size_t bits_per_word = 8 * sizeof(unsigned long);
+
+    // the values of the memory policy modes from linux/mempolicy.h, which isn't part of every libc
+    enum mempolicy_mode
+    {
+        mpol_preferred = 1,
+        mpol_bind = 2,
+        mpol_interleave = 3
+    };
+
+    void bind(void * p, std::size_t bytes) const
+    {
+        std::vector<unsigned long> nodes;
+        int mode = mpol_interleave;
+
+        if (m_policy == interleaved)
+        {
+            nodes = online_nodes();
+        }
+        else
+        {
+            nodes.resize(m_node / bits_per_word + 1);
+            nodes[m_node / bits_per_word] = 1ul << (m_node % bits_per_word);
+            mode = m_policy == preferred_node ? mpol_preferred : mpol_bind;
+        }
+
+        // only a request; if it fails, the pages are placed on first touch
+        ::syscall(SYS_mbind, p, bytes, mode, nodes.data(), nodes.size() * bits_per_word + 1, 0u);
+    }
+
+    // the mask of online nodes, parsed from a list of ranges like "0-1,4"
+    static const std::vector<unsigned long> & online_nodes()
+    {
+        static const std::vector<unsigned long> nodes = read_online_nodes();
+        return nodes;
+    }
+
+    static std::vector<unsigned long> read_online_nodes()
+    {
+        std::vector<unsigned long> nodes;
+
+        if (std::FILE * file = std::fopen("/sys/devices/system/node/online", "r"))
+        {
+            unsigned long first = 0;
+            while (std::fscanf(file, "%lu", &first) == 1)
+            {
+                unsigned long last = first;
+                int separator = std::fgetc(file);
+                if (separator == '-')
+                {
+                    if (std::fscanf(file, "%lu", &last) != 1)
+                    {
+                        break;
+                    }
+                    separator = std::fgetc(file);
+                }
+
+                for (unsigned long node = first; node <= last; ++node)
+                {
+                    if (nodes.size() <= node / bits_per_word)
+                    {
+                        nodes.resize(node / bits_per_word + 1);
+                    }
+                    nodes[node / bits_per_word] |= 1ul << (node % bits_per_word);
+                }
+
+                if (separator != ',')
+                {
+                    break;
+                }
+            }
+
+            std::fclose(file);
+        }
+
+        // no NUMA support; everything is on node 0
+        if (nodes.empty())
+        {
+            nodes.push_back(1);
+        }
+
+        return nodes;
+    }
+
+    // the number of unset bits above the highest online node in the mask
+    static std::size_t leading_offline_nodes()
+    {
+        unsigned long highest_word = online_nodes().back();
+        std::size_t count = 0;
+        for (std::size_t bit = bits_per_word; bit > 0 && !(highest_word & (1ul << (bit - 1))); --bit)
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    mmap_memory_resource m_upstream;
+    placement m_policy;
+    std::size_t m_node;
+};
+
+/*! Memory freshly mapped by \p numa_memory_resource reads as zeros.
+ */
+template<>
+struct is_zero_filled_resource<numa_memory_resource> : thrust::detail::true_type
+{
+};
+
+/*! \p numa_memory_resource reallocates by remapping pages.
+ */
+template<>
+struct is_reallocatable_resource<numa_memory_resource> : thrust::detail::true_type
+{
+};
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
+#endif // defined(__linux__)
+
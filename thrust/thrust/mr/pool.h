@@ -39,6 +39,7 @@
 #include <thrust/mr/memory_resource.h>
 #include <thrust/mr/allocator.h>
 #include <thrust/mr/pool_options.h>
+#include <thrust/mr/detail/size_classes.h>
 
 #include <cassert>
 
@@ -95,11 +96,13 @@ public:
         ret.largest_block_size = static_cast<std::size_t>(1) << 20;
 
         ret.alignment = THRUST_MR_DEFAULT_ALIGNMENT;
+        ret.size_classes_per_doubling = 1;
 
         ret.cache_oversized = true;
 
         ret.cached_size_cutoff_factor = 16;
         ret.cached_alignment_cutoff_factor = 16;
+        ret.max_cached_oversized_bytes = 0;
 
         return ret;
     }
@@ -112,16 +115,23 @@ public:
     unsynchronized_pool_resource(Upstream * upstream, pool_options options = get_default_options())
         : m_upstream(upstream),
         m_options(options),
-        m_smallest_block_log2(detail::log2_ri(m_options.smallest_block_size)),
+        m_size_classes(m_options, upstream),
         m_pools(upstream),
         m_allocated(),
         m_oversized(),
-        m_cached_oversized()
+        m_cached_oversized(upstream),
+        m_newest_cached_oversized(),
+        m_oldest_cached_oversized(),
+        m_cached_oversized_bytes(0),
+        m_requested_bytes(0),
+        m_allocated_bytes(0),
+        m_pooled_bytes(0)
     {
         assert(m_options.validate());
 
         pool p = { block_descriptor_ptr(), 0 };
-        m_pools.resize(detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1, p);
+        m_pools.resize(m_size_classes.size(), p);
+        m_cached_oversized.resize(num_oversized_classes, oversized_block_descriptor_ptr());
     }
 
     // TODO: C++11: use delegating constructors
@@ -133,16 +143,23 @@ public:
     unsynchronized_pool_resource(pool_options options = get_default_options())
         : m_upstream(get_global_resource<Upstream>()),
         m_options(options),
-        m_smallest_block_log2(detail::log2_ri(m_options.smallest_block_size)),
+        m_size_classes(m_options, get_global_resource<Upstream>()),
         m_pools(get_global_resource<Upstream>()),
         m_allocated(),
         m_oversized(),
-        m_cached_oversized()
+        m_cached_oversized(get_global_resource<Upstream>()),
+        m_newest_cached_oversized(),
+        m_oldest_cached_oversized(),
+        m_cached_oversized_bytes(0),
+        m_requested_bytes(0),
+        m_allocated_bytes(0),
+        m_pooled_bytes(0)
     {
         assert(m_options.validate());
 
         pool p = { block_descriptor_ptr(), 0 };
-        m_pools.resize(detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1, p);
+        m_pools.resize(m_size_classes.size(), p);
+        m_cached_oversized.resize(num_oversized_classes, oversized_block_descriptor_ptr());
     }
 
     /*! Destructor. Releases all held memory to upstream.
@@ -179,23 +196,25 @@ private:
 
     // this was originally a forward list, but I made it a doubly linked list
     // because that way deallocation when not caching is faster and doesn't require
-    // traversal of a linked list (it's still a forward list for the cached list,
-    // because allocation from that list already traverses)
+    // traversal of a linked list
     //
-    // TODO: investigate whether it's better to have this be a doubly-linked list
-    // with fast do_deallocate when !m_options.cache_oversized, or to have this be
-    // a forward list and require traversal in do_deallocate
+    // cached blocks are additionally linked into two more doubly linked lists: the
+    // list of cached blocks of their size class, searched by allocations, and the
+    // list of all cached blocks in the order they were cached, trimmed from its
+    // least recently cached end; both need to unlink blocks from the middle
     //
-    // I assume that it is better this way, but the additional pointer could
-    // potentially hurt? these are supposed to be oversized and/or overaligned,
-    // so they are kinda memory intensive already
+    // these are supposed to be oversized and/or overaligned, so they are kinda
+    // memory intensive already, and the additional pointers shouldn't hurt
     struct oversized_block_descriptor
     {
         std::size_t size;
         std::size_t alignment;
         oversized_block_descriptor_ptr prev;
         oversized_block_descriptor_ptr next;
+        oversized_block_descriptor_ptr prev_cached;
         oversized_block_descriptor_ptr next_cached;
+        oversized_block_descriptor_ptr newer_cached;
+        oversized_block_descriptor_ptr older_cached;
         std::size_t current_size;
     };
 
@@ -210,17 +229,209 @@ private:
         allocator<pool, Upstream>
     > pool_vector;
 
+    typedef thrust::detail::size_class_table<
+        thrust::host_vector<std::size_t, allocator<std::size_t, Upstream> >
+    > size_class_table;
+
+    typedef thrust::host_vector<
+        oversized_block_descriptor_ptr,
+        allocator<oversized_block_descriptor_ptr, Upstream>
+    > oversized_class_vector;
+
+    // cached oversized blocks are kept in lists by size class, four per power of two,
+    // so that an allocation only searches blocks that are close to its size
+    static const std::size_t num_oversized_classes = 4 * 8 * sizeof(std::size_t);
+
+    static std::size_t oversized_class(std::size_t size)
+    {
+        if (size < 4)
+        {
+            return size;
+        }
+
+        std::size_t size_log2 = thrust::detail::log2(size);
+        return 4 * size_log2 + ((size >> (size_log2 - 2)) & 3);
+    }
+
+    // the smallest size in a size class
+    static std::size_t oversized_class_min_size(std::size_t size_class)
+    {
+        if (size_class < 8)
+        {
+            return size_class < 4 ? size_class : 4;
+        }
+
+        return (4 + size_class % 4) << (size_class / 4 - 2);
+    }
+
     Upstream * m_upstream;
 
     pool_options m_options;
-    std::size_t m_smallest_block_log2;
+    size_class_table m_size_classes;
 
     pool_vector m_pools;
     chunk_descriptor_ptr m_allocated;
     oversized_block_descriptor_ptr m_oversized;
-    oversized_block_descriptor_ptr m_cached_oversized;
+    oversized_class_vector m_cached_oversized;
+    oversized_block_descriptor_ptr m_newest_cached_oversized;
+    oversized_block_descriptor_ptr m_oldest_cached_oversized;
+    std::size_t m_cached_oversized_bytes;
+
+    // the fragmentation statistics of the pools
+    std::size_t m_requested_bytes;
+    std::size_t m_allocated_bytes;
+    std::size_t m_pooled_bytes;
+
+    // finds a cached block fit for an oversized and/or overaligned allocation, or returns null
+    oversized_block_descriptor_ptr find_cached_oversized(std::size_t bytes, std::size_t alignment)
+    {
+        for (std::size_t size_class = oversized_class(bytes); size_class < num_oversized_classes; ++size_class)
+        {
+            // if the size of every block in this and the bigger size classes is bigger than the
+            // requested size by a factor bigger than or equal to the specified cutoff for size,
+            // a new block needs to be allocated
+            if (oversized_class_min_size(size_class) / bytes >= m_options.cached_size_cutoff_factor)
+            {
+                break;
+            }
+
+            oversized_block_descriptor_ptr ptr = thrust::raw_reference_cast(m_cached_oversized[size_class]);
+            while (oversized_block_ptr_traits::get(ptr))
+            {
+                oversized_block_descriptor desc = *ptr;
+
+                // the same cutoffs apply to every single block; the smallest size class searched
+                // can also hold blocks that are smaller than requested
+                bool is_good = desc.size >= bytes && desc.alignment >= alignment
+                    && desc.size / bytes < m_options.cached_size_cutoff_factor
+                    && desc.alignment / alignment < m_options.cached_alignment_cutoff_factor;
+
+                if (is_good)
+                {
+                    return ptr;
+                }
+
+                ptr = desc.next_cached;
+            }
+        }
+
+        return oversized_block_descriptor_ptr();
+    }
+
+    // links a block into the lists of cached blocks; the caller stores desc to *ptr
+    void cache_oversized(oversized_block_descriptor_ptr ptr, oversized_block_descriptor & desc)
+    {
+        oversized_block_descriptor_ptr & head = thrust::raw_reference_cast(m_cached_oversized[oversized_class(desc.size)]);
+
+        desc.prev_cached = oversized_block_descriptor_ptr();
+        desc.next_cached = head;
+        if (oversized_block_ptr_traits::get(head))
+        {
+            thrust::raw_reference_cast(*head).prev_cached = ptr;
+        }
+        head = ptr;
+
+        desc.newer_cached = oversized_block_descriptor_ptr();
+        desc.older_cached = m_newest_cached_oversized;
+        if (oversized_block_ptr_traits::get(m_newest_cached_oversized))
+        {
+            thrust::raw_reference_cast(*m_newest_cached_oversized).newer_cached = ptr;
+        }
+        else
+        {
+            m_oldest_cached_oversized = ptr;
+        }
+        m_newest_cached_oversized = ptr;
+
+        m_cached_oversized_bytes += desc.size;
+    }
+
+    // unlinks a block from the lists of cached blocks; the caller stores desc to *ptr
+    void uncache_oversized(oversized_block_descriptor & desc)
+    {
+        if (oversized_block_ptr_traits::get(desc.prev_cached))
+        {
+            thrust::raw_reference_cast(*desc.prev_cached).next_cached = desc.next_cached;
+        }
+        else
+        {
+            thrust::raw_reference_cast(m_cached_oversized[oversized_class(desc.size)]) = desc.next_cached;
+        }
+
+        if (oversized_block_ptr_traits::get(desc.next_cached))
+        {
+            thrust::raw_reference_cast(*desc.next_cached).prev_cached = desc.prev_cached;
+        }
+
+        if (oversized_block_ptr_traits::get(desc.newer_cached))
+        {
+            thrust::raw_reference_cast(*desc.newer_cached).older_cached = desc.older_cached;
+        }
+        else
+        {
+            m_newest_cached_oversized = desc.older_cached;
+        }
+
+        if (oversized_block_ptr_traits::get(desc.older_cached))
+        {
+            thrust::raw_reference_cast(*desc.older_cached).newer_cached = desc.newer_cached;
+        }
+        else
+        {
+            m_oldest_cached_oversized = desc.newer_cached;
+        }
+
+        desc.prev_cached = oversized_block_descriptor_ptr();
+        desc.next_cached = oversized_block_descriptor_ptr();
+        desc.newer_cached = oversized_block_descriptor_ptr();
+        desc.older_cached = oversized_block_descriptor_ptr();
+
+        m_cached_oversized_bytes -= desc.size;
+    }
+
+    // returns the least recently cached blocks to upstream, until the cached blocks fit
+    // in the budget from the options
+    void trim_cached_oversized()
+    {
+        if (m_options.max_cached_oversized_bytes == 0)
+        {
+            return;
+        }
+
+        while (m_cached_oversized_bytes > m_options.max_cached_oversized_bytes)
+        {
+            oversized_block_descriptor_ptr block = m_oldest_cached_oversized;
+            oversized_block_descriptor desc = *block;
+            uncache_oversized(desc);
+
+            if (oversized_block_ptr_traits::get(desc.prev)) {
+                thrust::raw_reference_cast(*desc.prev).next = desc.next;
+            } else {
+                m_oversized = desc.next;
+            }
+
+            if (oversized_block_ptr_traits::get(desc.next)) {
+                thrust::raw_reference_cast(*desc.next).prev = desc.prev;
+            }
+
+            void_ptr p = static_cast<void_ptr>(
+                static_cast<char_ptr>(static_cast<void_ptr>(block)) - desc.size);
+            m_upstream->do_deallocate(p, desc.size + sizeof(oversized_block_descriptor), desc.alignment);
+        }
+    }
 
 public:
+    /*! Returns how well the memory in the pools is used; see \p pool_fragmentation_statistics.
+     */
+    pool_fragmentation_statistics fragmentation_statistics() const
+    {
+        pool_fragmentation_statistics ret;
+        ret.requested_bytes = m_requested_bytes;
+        ret.allocated_bytes = m_allocated_bytes;
+        ret.pooled_bytes = m_pooled_bytes;
+        return ret;
+    }
+
     /*! Releases all held memory to upstream.
      */
     void release()
@@ -263,11 +474,22 @@ public:
                 desc.alignment);
         }
 
-        m_cached_oversized = oversized_block_descriptor_ptr();
+        for (std::size_t i = 0; i < m_cached_oversized.size(); ++i)
+        {
+            thrust::raw_reference_cast(m_cached_oversized[i]) = oversized_block_descriptor_ptr();
+        }
+        m_newest_cached_oversized = oversized_block_descriptor_ptr();
+        m_oldest_cached_oversized = oversized_block_descriptor_ptr();
+        m_cached_oversized_bytes = 0;
+
+        m_requested_bytes = 0;
+        m_allocated_bytes = 0;
+        m_pooled_bytes = 0;
     }
 
     THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
     {
+        std::size_t requested = bytes;
         bytes = (std::max)(bytes, m_options.smallest_block_size);
         assert(detail::is_power_of_2(alignment));
 
@@ -276,78 +498,36 @@ public:
         {
             if (m_options.cache_oversized)
             {
-                oversized_block_descriptor_ptr ptr = m_cached_oversized;
-                oversized_block_descriptor_ptr * previous = &m_cached_oversized;
-                while (oversized_block_ptr_traits::get(ptr))
+                oversized_block_descriptor_ptr ptr = find_cached_oversized(bytes, alignment);
+                if (oversized_block_ptr_traits::get(ptr))
                 {
                     oversized_block_descriptor desc = *ptr;
-                    bool is_good = desc.size >= bytes && desc.alignment >= alignment;
-
-                    // if the size is bigger than the requested size by a factor
-                    // bigger than or equal to the specified cutoff for size,
-                    // allocate a new block
-                    if (is_good)
-                    {
-                        std::size_t size_factor = desc.size / bytes;
-                        if (size_factor >= m_options.cached_size_cutoff_factor)
-                        {
-                            is_good = false;
-                        }
-                    }
-
-                    // if the alignment is bigger than the requested one by a factor
-                    // bigger than or equal to the specified cutoff for alignment,
-                    // allocate a new block
-                    if (is_good)
-                    {
-                        std::size_t alignment_factor = desc.alignment / alignment;
-                        if (alignment_factor >= m_options.cached_alignment_cutoff_factor)
-                        {
-                            is_good = false;
-                        }
-                    }
-
-                    if (is_good)
-                    {
-                        if (previous != &m_cached_oversized)
-                        {
-                            *previous = desc.next_cached;
-                        }
-                        else
-                        {
-                            m_cached_oversized = desc.next_cached;
-                        }
-
-                        desc.next_cached = oversized_block_descriptor_ptr();
-
-                        auto ret =
-                            static_cast<char_ptr>(static_cast<void_ptr>(ptr)) -
-                            desc.size;
+                    uncache_oversized(desc);
 
-                        if (bytes != desc.size) {
-                            desc.current_size = bytes;
+                    auto ret =
+                        static_cast<char_ptr>(static_cast<void_ptr>(ptr)) -
+                        desc.size;
 
-                            ptr = static_cast<oversized_block_descriptor_ptr>(
-                                static_cast<void_ptr>(ret + bytes));
+                    if (bytes != desc.size) {
+                        desc.current_size = bytes;
 
-                            if (oversized_block_ptr_traits::get(desc.prev)) {
-                                thrust::raw_reference_cast(*desc.prev).next = ptr;
-                            } else {
-                                m_oversized = ptr;
-                            }
+                        ptr = static_cast<oversized_block_descriptor_ptr>(
+                            static_cast<void_ptr>(ret + bytes));
 
-                            if (oversized_block_ptr_traits::get(desc.next)) {
-                                thrust::raw_reference_cast(*desc.next).prev = ptr;
-                            }
+                        if (oversized_block_ptr_traits::get(desc.prev)) {
+                            thrust::raw_reference_cast(*desc.prev).next = ptr;
+                        } else {
+                            m_oversized = ptr;
                         }
 
-                        *ptr = desc;
-
-                        return static_cast<void_ptr>(ret);
+                        if (oversized_block_ptr_traits::get(desc.next)) {
+                            thrust::raw_reference_cast(*desc.next).prev = ptr;
+                        }
                     }
 
-                    previous = &thrust::raw_reference_cast(*ptr).next_cached;
-                    ptr = *previous;
+                    *ptr = desc;
+
+                    return static_cast<void_ptr>(ret);
                 }
             }
 
@@ -364,7 +544,10 @@ public:
             desc.alignment = alignment;
             desc.prev = oversized_block_descriptor_ptr();
             desc.next = m_oversized;
+            desc.prev_cached = oversized_block_descriptor_ptr();
             desc.next_cached = oversized_block_descriptor_ptr();
+            desc.newer_cached = oversized_block_descriptor_ptr();
+            desc.older_cached = oversized_block_descriptor_ptr();
             desc.current_size = bytes;
             *block = desc;
             m_oversized = block;
@@ -381,11 +564,10 @@ public:
 
         // the request is NOT for oversized and/or overaligned memory
         // allocate a block from an appropriate bucket
-        std::size_t bytes_log2 = thrust::detail::log2_ri(bytes);
-        std::size_t bucket_idx = bytes_log2 - m_smallest_block_log2;
+        std::size_t bucket_idx = m_size_classes.class_of(bytes);
         pool & bucket = thrust::raw_reference_cast(m_pools[bucket_idx]);
 
-        bytes = static_cast<std::size_t>(1) << bytes_log2;
+        bytes = m_size_classes.class_size(bucket_idx);
 
         // if the free list of the bucket has no elements, allocate a new chunk
         // and split it into blocks pushed to the free list
@@ -395,17 +577,17 @@ public:
             if (n == 0)
             {
                 n = m_options.min_blocks_per_chunk;
-                if (n < (m_options.min_bytes_per_chunk >> bytes_log2))
+                if (n < detail::divide_ri(m_options.min_bytes_per_chunk, bytes))
                 {
-                    n = m_options.min_bytes_per_chunk >> bytes_log2;
+                    n = detail::divide_ri(m_options.min_bytes_per_chunk, bytes);
                 }
             }
             else
             {
                 n = n * 3 / 2;
-                if (n > (m_options.max_bytes_per_chunk >> bytes_log2))
+                if (n > m_options.max_bytes_per_chunk / bytes)
                 {
-                    n = m_options.max_bytes_per_chunk >> bytes_log2;
+                    n = m_options.max_bytes_per_chunk / bytes;
                 }
                 if (n > m_options.max_blocks_per_chunk)
                 {
@@ -430,6 +612,7 @@ public:
             chunk_desc.next = m_allocated;
             *chunk = chunk_desc;
             m_allocated = chunk;
+            m_pooled_bytes += bytes * n;
 
             for (std::size_t i = 0; i < n; ++i)
             {
@@ -446,6 +629,9 @@ public:
             }
         }
 
+        m_requested_bytes += requested;
+        m_allocated_bytes += bytes;
+
         // allocate a block from the front of the bucket's free list
         block_descriptor_ptr block = bucket.free_list;
         bucket.free_list = thrust::raw_reference_cast(*block).next;
@@ -458,6 +644,7 @@ public:
 
     virtual void do_deallocate(void_ptr p, std::size_t n, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
     {
+        std::size_t requested = n;
         n = (std::max)(n, m_options.smallest_block_size);
         assert(detail::is_power_of_2(alignment));
 
@@ -479,8 +666,6 @@ public:
 
             if (m_options.cache_oversized)
             {
-                desc.next_cached = m_cached_oversized;
-
                 if (desc.size != n) {
                     desc.current_size = desc.size;
                     block = static_cast<oversized_block_descriptor_ptr>(
@@ -497,9 +682,11 @@ public:
                     }
                 }
 
-                m_cached_oversized = block;
+                cache_oversized(block, desc);
                 *block = desc;
 
+                trim_cached_oversized();
+
                 return;
             }
 
@@ -520,11 +707,13 @@ public:
         }
 
         // push the block to the front of the appropriate bucket's free list
-        std::size_t n_log2 = thrust::detail::log2_ri(n);
-        std::size_t bucket_idx = n_log2 - m_smallest_block_log2;
+        std::size_t bucket_idx = m_size_classes.class_of(n);
         pool & bucket = thrust::raw_reference_cast(m_pools[bucket_idx]);
 
-        n = static_cast<std::size_t>(1) << n_log2;
+        n = m_size_classes.class_size(bucket_idx);
+
+        m_requested_bytes -= requested;
+        m_allocated_bytes -= n;
 
         block_descriptor_ptr block = static_cast<block_descriptor_ptr>(
             static_cast<void_ptr>(
@@ -80,6 +80,14 @@ struct pool_options
      */
     std::size_t alignment;
 
+    /*! The number of pools per doubling of the block size, between \p smallest_block_size and
+     *      \p largest_block_size. With one pool per doubling, block sizes are powers of two, and requests just above a
+     *      power of two waste almost half of their block; with four, block sizes go 1, 1.25, 1.5, 1.75 times a power of
+     *      two, and no more than a fifth of a block is wasted. Block sizes are rounded up to \p alignment. Zero is
+     *      treated as one.
+     */
+    std::size_t size_classes_per_doubling;
+
     /*! Decides whether oversized and overaligned blocks are cached for later use, or immediately return it to the upstream
      *      resource.
      */
@@ -97,6 +105,11 @@ struct pool_options
      *      allocation request.
      */
     std::size_t cached_alignment_cutoff_factor;
+    /*! The maximal number of bytes in cached oversized and overaligned blocks. When caching a block would take the cached
+     *      blocks over this budget, the least recently cached blocks are returned to the upstream resource. Zero means
+     *      that the cache is unbounded.
+     */
+    std::size_t max_cached_oversized_bytes;
 
     /*! Checks if the options are self-consistent.
      *
@@ -124,10 +137,31 @@ struct pool_options
 
         if (alignment > smallest_block_size) return false;
 
+        if (!detail::is_power_of_2(size_classes_per_doubling)) return false;
+        if (size_classes_per_doubling > smallest_block_size) return false;
+
         return true;
     }
 };
 
+/*! A snapshot of how well a pooling resource adaptor uses the memory in its pools; oversized and overaligned blocks
+ *      are not counted.
+ */
+struct pool_fragmentation_statistics
+{
+    /*! The number of bytes requested in the blocks currently allocated from the pools.
+     */
+    std::size_t requested_bytes;
+    /*! The total size of the blocks currently allocated from the pools. The difference from \p requested_bytes is lost
+     *      to internal fragmentation: requests rounded up to the block size of their pool.
+     */
+    std::size_t allocated_bytes;
+    /*! The total size of the blocks in the chunks the pools took from upstream, allocated or free. The difference from
+     *      \p allocated_bytes is memory held idle in the pools.
+     */
+    std::size_t pooled_bytes;
+};
+
 /*! \} // memory_resources
  */
 
@@ -0,0 +1,342 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file statistics.h
+ *  \brief A memory resource adaptor which collects statistics about, and optionally a trace of, the allocations made
+ *      through it.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp11_required.h>
+
+#if _CCCL_STD_VER >= 2011
+
+#include <thrust/detail/integer_math.h>
+
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/validator.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+namespace detail
+{
+
+// the tag of the calling thread, shared by the statistics resources over every upstream
+inline const char * & this_thread_allocation_tag()
+{
+    static thread_local const char * tag = NULL;
+    return tag;
+}
+
+} // end detail
+
+namespace mr
+{
+
+/** \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! A snapshot of the statistics collected by a \p statistics_resource.
+ *
+ *  Sizes and latencies are counted in classes of powers of two: size class \p i holds the requests for at least
+ *      <tt>2^i</tt> and fewer than <tt>2^(i+1)</tt> bytes, with empty requests in class 0, and latency class \p i holds the
+ *      allocations which took at least <tt>2^i</tt> and fewer than <tt>2^(i+1)</tt> nanoseconds in the upstream resource.
+ */
+struct allocation_statistics
+{
+    /*! The number of size and latency classes.
+     */
+    static const std::size_t num_classes = 8 * sizeof(std::size_t);
+
+    std::size_t allocations;
+    std::size_t deallocations;
+    std::size_t bytes_allocated;
+    std::size_t bytes_deallocated;
+
+    /*! The number and total size of the blocks allocated and not yet deallocated.
+     */
+    std::size_t live_blocks;
+    std::size_t live_bytes;
+    /*! The highest value \p live_bytes has reached.
+     */
+    std::size_t peak_live_bytes;
+
+    std::size_t allocations_by_size_class[num_classes];
+    std::size_t bytes_by_size_class[num_classes];
+    std::size_t allocations_by_latency_class[num_classes];
+};
+
+/*! Tags the requests made by the calling thread, through any \p statistics_resource regardless of its upstream, for
+ *      the lifetime of the \p scoped_allocation_tag. Tags nest; the tag of the innermost live \p scoped_allocation_tag
+ *      is used.
+ */
+class scoped_allocation_tag
+{
+public:
+    /*! Constructor.
+     *
+     *  \param tag the tag, which must outlive the trace; typically a string literal naming a call site
+     */
+    explicit scoped_allocation_tag(const char * tag) : m_previous(thrust::detail::this_thread_allocation_tag())
+    {
+        thrust::detail::this_thread_allocation_tag() = tag;
+    }
+
+    /*! Destructor. Restores the tag of the enclosing \p scoped_allocation_tag.
+     */
+    ~scoped_allocation_tag()
+    {
+        thrust::detail::this_thread_allocation_tag() = m_previous;
+    }
+
+    scoped_allocation_tag(const scoped_allocation_tag &) = delete;
+    scoped_allocation_tag & operator=(const scoped_allocation_tag &) = delete;
+
+private:
+    const char * m_previous;
+};
+
+/*! A memory resource adaptor which forwards all requests to \p Upstream, and collects statistics about them: the number
+ *      and total size of allocations and deallocations, by size class; the number and size of live blocks, and the
+ *      high-water mark of the latter; and a histogram of the time taken by allocations. Placed under a pool resource,
+ *      it shows how much memory the pool takes from its upstream; placed under an allocator passed to an execution
+ *      policy (<tt>thrust::host(alloc)</tt>), it shows the temporary storage used by algorithms.
+ *
+ *  When tracing is enabled, every request is also recorded in a trace, together with the tag set for the calling
+ *      thread by the innermost \p scoped_allocation_tag, so that allocation spikes can be attributed to call sites. The
+ *      trace grows without bound until it's cleared.
+ *
+ *  The resource is thread-safe, provided that \p Upstream is; all bookkeeping is done under a mutex.
+ *
+ *  \tparam Upstream the type of memory resources that will be used for allocating memory
+ */
+template<typename Upstream>
+class statistics_resource final
+    : public memory_resource<typename Upstream::pointer>,
+        private validator<Upstream>
+{
+    typedef typename Upstream::pointer void_ptr;
+    typedef thrust::detail::pointer_traits<void_ptr> void_ptr_traits;
+    typedef std::lock_guard<std::mutex> lock_t;
+
+public:
+    /*! A single request recorded in the trace.
+     */
+    struct trace_entry
+    {
+        /*! True for an allocation, false for a deallocation.
+         */
+        bool allocation;
+        /*! The tag of the calling thread, or null if it had none.
+         */
+        const char * tag;
+        std::size_t bytes;
+        std::size_t alignment;
+        /*! The address of the block.
+         */
+        std::uintptr_t address;
+        /*! The time the upstream resource took to serve an allocation; zero for a deallocation.
+         */
+        std::chrono::nanoseconds latency;
+    };
+
+    /*! Tags the requests made by the calling thread, through any \p statistics_resource, for its lifetime. The same
+     *      as \p scoped_allocation_tag.
+     */
+    typedef scoped_allocation_tag scoped_tag;
+
+    /*! Constructor.
+     *
+     *  \param upstream the upstream memory resource for allocations
+     */
+    statistics_resource(Upstream * upstream) : m_upstream(upstream), m_tracing(false)
+    {
+        reset();
+    }
+
+    /*! Constructor. The upstream resource is obtained by calling \p get_global_resource<Upstream>.
+     */
+    statistics_resource() : m_upstream(get_global_resource<Upstream>()), m_tracing(false)
+    {
+        reset();
+    }
+
+    /*! Returns a snapshot of the statistics collected so far.
+     */
+    allocation_statistics statistics() const
+    {
+        lock_t lock(m_mtx);
+        return m_stats;
+    }
+
+    /*! Resets all statistics to zero, except for \p live_blocks and \p live_bytes, and starts the high-water mark from
+     *      the current \p live_bytes.
+     */
+    void reset()
+    {
+        lock_t lock(m_mtx);
+
+        std::size_t live_blocks = m_stats.live_blocks;
+        std::size_t live_bytes = m_stats.live_bytes;
+
+        std::memset(&m_stats, 0, sizeof(m_stats));
+        m_stats.live_blocks = live_blocks;
+        m_stats.live_bytes = live_bytes;
+        m_stats.peak_live_bytes = live_bytes;
+    }
+
+    /*! Enables or disables recording the trace.
+     */
+    void set_tracing(bool enabled)
+    {
+        lock_t lock(m_mtx);
+        m_tracing = enabled;
+    }
+
+    /*! Returns a copy of the trace recorded so far.
+     */
+    std::vector<trace_entry> trace() const
+    {
+        lock_t lock(m_mtx);
+        return m_trace;
+    }
+
+    /*! Discards the trace recorded so far.
+     */
+    void clear_trace()
+    {
+        lock_t lock(m_mtx);
+        m_trace.clear();
+    }
+
+    /*! Writes the trace recorded so far to \p os, one request per line.
+     */
+    void dump_trace(std::ostream & os) const
+    {
+        lock_t lock(m_mtx);
+        for (std::size_t i = 0; i < m_trace.size(); ++i)
+        {
+            const trace_entry & entry = m_trace[i];
+            os << (entry.allocation ? "allocate" : "deallocate")
+                << " tag=" << (entry.tag ? entry.tag : "-")
+                << " bytes=" << entry.bytes
+                << " alignment=" << entry.alignment
+                << " address=0x" << std::hex << entry.address << std::dec
+                << " latency_ns=" << entry.latency.count()
+                << '\n';
+        }
+    }
+
+    THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        void_ptr ret = m_upstream->do_allocate(bytes, alignment);
+        std::chrono::nanoseconds latency = std::chrono::steady_clock::now() - start;
+
+        lock_t lock(m_mtx);
+
+        ++m_stats.allocations;
+        m_stats.bytes_allocated += bytes;
+        ++m_stats.live_blocks;
+        m_stats.live_bytes += bytes;
+        if (m_stats.live_bytes > m_stats.peak_live_bytes)
+        {
+            m_stats.peak_live_bytes = m_stats.live_bytes;
+        }
+
+        std::size_t size_class = class_of(bytes);
+        ++m_stats.allocations_by_size_class[size_class];
+        m_stats.bytes_by_size_class[size_class] += bytes;
+        ++m_stats.allocations_by_latency_class[class_of(static_cast<std::size_t>(latency.count()))];
+
+        record(true, bytes, alignment, address_of(ret), latency);
+
+        return ret;
+    }
+
+    virtual void do_deallocate(void_ptr p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        {
+            // recorded before the block is returned to the upstream resource, which may free it
+            lock_t lock(m_mtx);
+
+            ++m_stats.deallocations;
+            m_stats.bytes_deallocated += bytes;
+            --m_stats.live_blocks;
+            m_stats.live_bytes -= bytes;
+
+            record(false, bytes, alignment, address_of(p), std::chrono::nanoseconds::zero());
+        }
+
+        m_upstream->do_deallocate(p, bytes, alignment);
+    }
+
+private:
+    static std::uintptr_t address_of(void_ptr p)
+    {
+        return reinterpret_cast<std::uintptr_t>(void_ptr_traits::get(p));
+    }
+
+    static std::size_t class_of(std::size_t value)
+    {
+        return value ? thrust::detail::log2(value) : 0;
+    }
+
+    void record(bool allocation, std::size_t bytes, std::size_t alignment, std::uintptr_t address, std::chrono::nanoseconds latency)
+    {
+        if (!m_tracing)
+        {
+            return;
+        }
+
+        trace_entry entry = { allocation, thrust::detail::this_thread_allocation_tag(), bytes, alignment, address, latency };
+        m_trace.push_back(entry);
+    }
+
+    Upstream * m_upstream;
+
+    mutable std::mutex m_mtx;
+    allocation_statistics m_stats = allocation_statistics();
+    bool m_tracing;
+    std::vector<trace_entry> m_trace;
+};
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
+#endif // _CCCL_STD_VER >= 2011
+
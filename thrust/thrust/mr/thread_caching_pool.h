@@ -0,0 +1,399 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file thread_caching_pool.h
+ *  \brief A pool resource which gives every thread its own \p unsynchronized_pool_resource, and lets any thread
+ *      deallocate blocks allocated by another.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp11_required.h>
+
+#if _CCCL_STD_VER >= 2011
+
+#include <thrust/mr/pool.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/cpp/detail/execution_policy.h>
+
+#include <atomic>
+#include <new>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/*! \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! A memory resource adaptor which gives every thread that uses it a private \p unsynchronized_pool_resource, so that
+ *      allocations and deallocations made by the thread that owns a block take no locks, like with \p tls_pool, and which
+ *      also allows a block to be deallocated by a thread other than the one which allocated it.
+ *
+ *  Every block carries a header naming the pool of the thread which allocated it. A block deallocated by another thread
+ *      is pushed onto a lock-free list of remote deallocations of the owning pool, which its owner drains the next time it
+ *      allocates. Memory allocated from \p Upstream must therefore be accessible from the host; upstream resources of
+ *      memory which isn't, such as device memory, are rejected at compile time, and need a disjoint pool such as
+ *      \p disjoint_synchronized_pool_resource, which keeps its bookkeeping out of band. The header takes the
+ *      size of a few pointers, rounded up to the requested alignment, and is counted towards the size of the request when
+ *      choosing a pool.
+ *
+ *  A thread only gets a pool when it first allocates; threads which only deallocate don't. The pool of a thread
+ *      outlives the thread, so that the blocks it allocated remain valid, and the next thread to get a pool adopts it,
+ *      along with the blocks other threads deallocated to it in the meantime. The number of pools is therefore bounded
+ *      by the largest number of threads which allocated from the resource and were alive at the same time. All pools
+ *      are released to upstream by \p release and by the destructor, which, as with the other pool resources, must not
+ *      run concurrently with any other use of the resource.
+ *
+ *  \tparam Upstream the type of memory resources that will be used for allocating memory blocks
+ */
+template<typename Upstream>
+class thread_caching_pool_resource final
+    : public memory_resource<typename Upstream::pointer>,
+        private validator<Upstream>
+{
+    typedef unsynchronized_pool_resource<Upstream> unsync_pool;
+    typedef std::lock_guard<std::mutex> lock_t;
+
+    typedef typename Upstream::pointer void_ptr;
+    typedef thrust::detail::pointer_traits<void_ptr> void_ptr_traits;
+    typedef typename void_ptr_traits::template rebind<char>::other char_ptr;
+
+    typedef typename thrust::iterator_system<void_ptr>::type upstream_system;
+
+    static_assert(
+        std::is_base_of<thrust::system::cpp::detail::execution_policy<upstream_system>, upstream_system>::value,
+        "thread_caching_pool_resource keeps the headers of its blocks in the blocks, so it requires an upstream resource "
+        "whose memory is accessible from the host; use disjoint_synchronized_pool_resource for other memory"
+    );
+
+public:
+    /*! Get the default options for the pools of the threads. These are meant to be a sensible set of values for many
+     *      use cases, and as such, may be tuned in the future. This function is exposed so that creating a set of options
+     *      that are just a slight departure from the defaults is easy.
+     */
+    static pool_options get_default_options()
+    {
+        return unsync_pool::get_default_options();
+    }
+
+    /*! Constructor.
+     *
+     *  \param upstream the upstream memory resource for allocations
+     *  \param options pool options to use for the pool of every thread
+     */
+    thread_caching_pool_resource(Upstream * upstream, pool_options options = get_default_options())
+        : m_upstream(upstream), m_options(options), m_id(next_id()++)
+    {
+    }
+
+    /*! Constructor. The upstream resource is obtained by calling \p get_global_resource<Upstream>.
+     *
+     *  \param options pool options to use for the pool of every thread
+     */
+    thread_caching_pool_resource(pool_options options = get_default_options())
+        : m_upstream(get_global_resource<Upstream>()), m_options(options), m_id(next_id()++)
+    {
+    }
+
+    /*! Destructor. Releases all held memory to upstream.
+     */
+    ~thread_caching_pool_resource()
+    {
+        release();
+    }
+
+    /*! Releases all held memory to upstream.
+     */
+    void release()
+    {
+        lock_t lock(m_mtx);
+        for (std::size_t i = 0; i < m_heaps.size(); ++i)
+        {
+            m_heaps[i]->remote_frees.store(NULL, std::memory_order_relaxed);
+            m_heaps[i]->pool.release();
+        }
+    }
+
+    THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        thread_heap & heap = this_thread_heap();
+        heap.drain_remote_frees();
+
+        std::size_t header_size = block_header_size(alignment);
+
+        void_ptr block = heap.pool.do_allocate(bytes + header_size, alignment);
+
+        block_header * header = ::new (static_cast<void *>(raw_header(block))) block_header();
+        header->owner = &heap;
+        header->next = NULL;
+        header->block = block;
+        header->size = bytes + header_size;
+        header->alignment = alignment;
+
+        return static_cast<void_ptr>(static_cast<char_ptr>(block) + header_size);
+    }
+
+    virtual void do_deallocate(void_ptr p, std::size_t n, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        std::size_t header_size = block_header_size(alignment);
+
+        block_header * header = raw_header(static_cast<void_ptr>(static_cast<char_ptr>(p) - header_size));
+        assert(header->size == n + header_size);
+        assert(header->alignment == alignment);
+        (void) n;
+
+        // a thread without a pool of its own doesn't get one to deallocate
+        thread_heap * heap = cached_thread_heap();
+        if (header->owner == heap)
+        {
+            heap->deallocate(header);
+            return;
+        }
+
+        // push the block onto the owner's list of remote deallocations; the owner only ever takes the whole list,
+        // so there's no ABA problem
+        thread_heap * owner = header->owner;
+        header->next = owner->remote_frees.load(std::memory_order_relaxed);
+        while (!owner->remote_frees.compare_exchange_weak(header->next, header,
+            std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+private:
+    struct thread_heap;
+
+    struct block_header
+    {
+        thread_heap * owner;
+        block_header * next;
+        void_ptr block;
+        std::size_t size;
+        std::size_t alignment;
+    };
+
+    struct thread_heap
+    {
+        thread_heap(Upstream * upstream, pool_options options)
+            : pool(upstream, options), remote_frees(NULL)
+        {
+        }
+
+        // returns the blocks deallocated by other threads to the pool
+        void drain_remote_frees()
+        {
+            if (remote_frees.load(std::memory_order_relaxed) == NULL)
+            {
+                return;
+            }
+
+            block_header * header = remote_frees.exchange(NULL, std::memory_order_acquire);
+            while (header)
+            {
+                block_header * next = header->next;
+                deallocate(header);
+                header = next;
+            }
+        }
+
+        void deallocate(block_header * header)
+        {
+            void_ptr block = header->block;
+            std::size_t size = header->size;
+            std::size_t alignment = header->alignment;
+            header->~block_header();
+
+            pool.do_deallocate(block, size, alignment);
+        }
+
+        unsync_pool pool;
+        std::atomic<block_header *> remote_frees;
+
+        // the thread which owns the heap, and the flag set when it exits
+        std::thread::id owner_thread;
+        std::shared_ptr<std::atomic<bool> > owner_exited;
+    };
+
+    // sets a flag when its thread exits; heaps share the flag of their owner, so that it outlives the thread
+    struct thread_exit_flag
+    {
+        thread_exit_flag() : exited(std::make_shared<std::atomic<bool> >(false))
+        {
+        }
+
+        ~thread_exit_flag()
+        {
+            exited->store(true, std::memory_order_release);
+        }
+
+        std::shared_ptr<std::atomic<bool> > exited;
+    };
+
+    static const std::shared_ptr<std::atomic<bool> > & this_thread_exited()
+    {
+        static thread_local thread_exit_flag flag;
+        return flag.exited;
+    }
+
+    static std::size_t block_header_size(std::size_t alignment)
+    {
+        return (sizeof(block_header) + alignment - 1) / alignment * alignment;
+    }
+
+    static block_header * raw_header(void_ptr block)
+    {
+        return static_cast<block_header *>(static_cast<void *>(void_ptr_traits::get(block)));
+    }
+
+    // every resource has an id, rather than being identified by its address, so that a thread can't mistake a
+    // resource for a destroyed one that lived at the same address
+    static std::atomic<std::size_t> & next_id()
+    {
+        static std::atomic<std::size_t> id(0);
+        return id;
+    }
+
+    // a thread rarely uses more than a few resources at once, and the cache is searched linearly
+    static const std::size_t heap_cache_size = 8;
+
+    struct heap_cache_entry
+    {
+        std::size_t resource_id;
+        thread_heap * heap;
+    };
+
+    static heap_cache_entry * thread_heap_cache()
+    {
+        static thread_local heap_cache_entry cache[heap_cache_size] = {};
+        return cache;
+    }
+
+    // the heap of the calling thread if it's in the thread's cache, or NULL
+    thread_heap * cached_thread_heap() const
+    {
+        heap_cache_entry * cache = thread_heap_cache();
+        for (std::size_t i = 0; i < heap_cache_size; ++i)
+        {
+            if (cache[i].heap && cache[i].resource_id == m_id)
+            {
+                return cache[i].heap;
+            }
+        }
+
+        return NULL;
+    }
+
+    thread_heap & this_thread_heap()
+    {
+        static thread_local std::size_t next_victim = 0;
+
+        thread_heap * heap = cached_thread_heap();
+        if (heap)
+        {
+            return *heap;
+        }
+
+        heap = find_or_adopt_heap();
+
+        heap_cache_entry entry = { m_id, heap };
+        thread_heap_cache()[next_victim] = entry;
+        next_victim = (next_victim + 1) % heap_cache_size;
+
+        return *heap;
+    }
+
+    thread_heap * find_or_adopt_heap()
+    {
+        const std::shared_ptr<std::atomic<bool> > & exited = this_thread_exited();
+        std::thread::id thread = std::this_thread::get_id();
+
+        lock_t lock(m_mtx);
+
+        // the heap of a thread which dropped it from its cache
+        typename heap_map::iterator it = m_thread_heaps.find(thread);
+        if (it != m_thread_heaps.end() && it->second->owner_exited == exited)
+        {
+            return it->second;
+        }
+
+        // a thread getting its first heap adopts the heap of an exited thread, if there is one; the blocks other
+        // threads deallocated to it are drained at the next allocation
+        thread_heap * heap = NULL;
+        for (std::size_t i = 0; i < m_heaps.size(); ++i)
+        {
+            if (m_heaps[i]->owner_exited->load(std::memory_order_acquire))
+            {
+                heap = m_heaps[i].get();
+
+                typename heap_map::iterator old = m_thread_heaps.find(heap->owner_thread);
+                if (old != m_thread_heaps.end() && old->second == heap)
+                {
+                    m_thread_heaps.erase(old);
+                }
+                break;
+            }
+        }
+
+        if (!heap)
+        {
+            m_heaps.emplace_back(new thread_heap(m_upstream, m_options));
+            heap = m_heaps.back().get();
+        }
+
+        heap->owner_thread = thread;
+        heap->owner_exited = exited;
+        m_thread_heaps[thread] = heap;
+
+        return heap;
+    }
+
+    Upstream * m_upstream;
+    pool_options m_options;
+    std::size_t m_id;
+
+    std::mutex m_mtx;
+    std::vector<std::unique_ptr<thread_heap> > m_heaps;
+    typedef std::unordered_map<std::thread::id, thread_heap *> heap_map;
+    heap_map m_thread_heaps;
+};
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
+#endif // _CCCL_STD_VER >= 2011
+
@@ -46,6 +46,9 @@ namespace mr
  */
 
 /*! Potentially constructs, if not yet created, and then returns the address of a thread-local \p unsynchronized_pool_resource,
+ *
+ *  Memory allocated from the returned pool must be deallocated by the same thread. \p thread_caching_pool_resource
+ *      provides the same per-thread pools, and accepts deallocations from any thread.
  *
  *  \tparam Upstream the template argument to the pool template
  *  \param upstream the argument to the constructor, if invoked
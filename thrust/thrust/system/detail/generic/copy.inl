@@ -32,7 +32,14 @@
 #include <thrust/for_each.h>
 #include <thrust/tuple.h>
 #include <thrust/iterator/zip_iterator.h>
+#include <thrust/iterator/counting_iterator.h>
 #include <thrust/iterator/detail/minimum_system.h>
+#include <thrust/iterator/detail/contiguous_zip_iterator.h>
+#include <thrust/type_traits/integer_sequence.h>
+#include <thrust/type_traits/is_trivially_relocatable.h>
+#include <thrust/system/detail/sequential/trivial_copy.h>
+#include <thrust/system/detail/sequential/general_copy.h>
+#include <thrust/distance.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -41,20 +48,122 @@ namespace detail
 {
 namespace generic
 {
+namespace copy_detail
+{
+
+
+// the bytes of the chunks contiguous copies are split into: enough that a
+// memmove amortizes its call, and few enough that a chunk stays in cache
+const std::size_t copy_chunk_bytes = 1 << 16;
+
+
+// the number of elements of type T in a chunk
+template<typename T>
+_CCCL_HOST_DEVICE
+  std::ptrdiff_t copy_chunk_size()
+{
+  return sizeof(T) < copy_chunk_bytes ? static_cast<std::ptrdiff_t>(copy_chunk_bytes / sizeof(T)) : 1;
+}
+
+
+template<typename InputPointer, typename OutputPointer>
+_CCCL_HOST_DEVICE
+  void copy_column_chunk(InputPointer first, std::ptrdiff_t n, OutputPointer result,
+                         thrust::detail::true_type)  // is_indirectly_trivially_relocatable_to
+{
+  thrust::system::detail::sequential::trivial_copy_n(first, n, result);
+}
+
+
+template<typename InputPointer, typename OutputPointer>
+_CCCL_HOST_DEVICE
+  void copy_column_chunk(InputPointer first, std::ptrdiff_t n, OutputPointer result,
+                         thrust::detail::false_type)  // is_indirectly_trivially_relocatable_to
+{
+  thrust::system::detail::sequential::general_copy_n(first, n, result);
+}
+
+
+// copies a chunk of every column of tuples of raw pointers: the columns of
+// trivially relocatable elements as a whole, and the others element by element
+template<typename InputTuple, typename OutputTuple>
+struct copy_columns_chunk_functor
+{
+  InputTuple     first;
+  OutputTuple    result;
+  std::ptrdiff_t n;
+  std::ptrdiff_t chunk_size;
 
+  _CCCL_HOST_DEVICE
+  void operator()(std::ptrdiff_t chunk) const
+  {
+    const std::ptrdiff_t offset = chunk * chunk_size;
+    const std::ptrdiff_t size   = n - offset < chunk_size ? n - offset : chunk_size;
 
+    copy_columns(offset, size, thrust::make_index_sequence<thrust::tuple_size<InputTuple>::value>());
+  }
+
+  template<std::size_t... Is>
+  _CCCL_HOST_DEVICE
+  void copy_columns(std::ptrdiff_t offset, std::ptrdiff_t size, thrust::index_sequence<Is...>) const
+  {
+    int ignored[] = {
+      (copy_detail::copy_column_chunk(thrust::get<Is>(first) + offset, size, thrust::get<Is>(result) + offset,
+         typename thrust::is_indirectly_trivially_relocatable_to<
+           typename thrust::tuple_element<Is,InputTuple>::type,
+           typename thrust::tuple_element<Is,OutputTuple>::type
+         >::type()), 0)...
+    };
+    (void) ignored;
+  }
+};
+
+
+// copies n elements of contiguous columns, given as tuples of raw pointers,
+// in a single loop over chunks of all columns
+template<typename DerivedPolicy,
+         typename InputTuple,
+         typename OutputTuple>
+_CCCL_HOST_DEVICE
+  void copy_chunked_columns_n(thrust::execution_policy<DerivedPolicy> &exec,
+                              InputTuple                               first,
+                              std::ptrdiff_t                           n,
+                              OutputTuple                              result,
+                              std::ptrdiff_t                           chunk_size)
+{
+  const std::ptrdiff_t num_chunks = (n + chunk_size - 1) / chunk_size;
+
+  copy_columns_chunk_functor<InputTuple,OutputTuple> f = {first, result, n, chunk_size};
+
+  thrust::for_each_n(exec, thrust::counting_iterator<std::ptrdiff_t>(0), num_chunks, f);
+} // end copy_chunked_columns_n()
+
+
+// copies contiguous ranges of trivially relocatable elements chunk by chunk,
+// with one memmove per chunk instead of a loop over the elements
 template<typename DerivedPolicy,
          typename InputIterator,
+         typename Size,
          typename OutputIterator>
 _CCCL_HOST_DEVICE
-  OutputIterator copy(thrust::execution_policy<DerivedPolicy> &exec,
-                      InputIterator                            first,
-                      InputIterator                            last,
-                      OutputIterator                           result)
+  OutputIterator copy_elements_n(thrust::execution_policy<DerivedPolicy> &exec,
+                                 InputIterator                            first,
+                                 Size                                     n,
+                                 OutputIterator                           result,
+                                 thrust::detail::true_type)  // is_indirectly_trivially_relocatable_to
 {
-  typedef typename thrust::iterator_value<InputIterator>::type T;
-  return thrust::transform(exec, first, last, result, thrust::identity<T>());
-} // end copy()
+  typedef typename thrust::iterator_value<OutputIterator>::type T;
+
+  if(n <= 0) return result;
+
+  copy_detail::copy_chunked_columns_n(exec,
+                                      thrust::make_tuple(thrust::detail::try_unwrap_contiguous_iterator(first)),
+                                      static_cast<std::ptrdiff_t>(n),
+                                      thrust::make_tuple(thrust::detail::try_unwrap_contiguous_iterator(result)),
+                                      copy_detail::copy_chunk_size<T>());
+
+  return result + n;
+} // end copy_elements_n()
 
 
 template<typename DerivedPolicy,
@@ -62,10 +171,11 @@ template<typename DerivedPolicy,
          typename Size,
          typename OutputIterator>
 _CCCL_HOST_DEVICE
-  OutputIterator copy_n(thrust::execution_policy<DerivedPolicy> &exec,
-                        InputIterator                            first,
-                        Size                                     n,
-                        OutputIterator                           result)
+  OutputIterator copy_elements_n(thrust::execution_policy<DerivedPolicy> &exec,
+                                 InputIterator                            first,
+                                 Size                                     n,
+                                 OutputIterator                           result,
+                                 thrust::detail::false_type)  // is_indirectly_trivially_relocatable_to
 {
   typedef typename thrust::iterator_value<InputIterator>::type value_type;
   typedef thrust::identity<value_type>                         xfrm_type;
@@ -78,6 +188,157 @@ _CCCL_HOST_DEVICE
   zip_iter zipped = thrust::make_zip_iterator(thrust::make_tuple(first,result));
 
   return thrust::get<1>(thrust::for_each_n(exec, zipped, n, functor_type(xfrm_type())).get_iterator_tuple());
+} // end copy_elements_n()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename Size,
+         typename OutputIterator>
+_CCCL_HOST_DEVICE
+  OutputIterator copy_n(thrust::execution_policy<DerivedPolicy> &exec,
+                        InputIterator                            first,
+                        Size                                     n,
+                        OutputIterator                           result,
+                        thrust::detail::false_type)  // is_contiguous_zip_copy
+{
+  return copy_detail::copy_elements_n(exec, first, n, result,
+    typename thrust::is_indirectly_trivially_relocatable_to<InputIterator,OutputIterator>::type());
+} // end copy_n()
+
+
+// copies structures of arrays column by column, so that every column is
+// copied by loops over contiguous ranges, and all columns in a single loop
+// over chunks
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename Size,
+         typename OutputIterator,
+         std::size_t... Is>
+_CCCL_HOST_DEVICE
+  OutputIterator copy_columns_n(thrust::execution_policy<DerivedPolicy> &exec,
+                                InputIterator                            first,
+                                Size                                     n,
+                                OutputIterator                           result,
+                                thrust::index_sequence<Is...>)
+{
+  typedef typename thrust::iterator_value<OutputIterator>::type T;
+
+  if(n <= 0) return result;
+
+  copy_detail::copy_chunked_columns_n(exec,
+    thrust::make_tuple(thrust::detail::try_unwrap_contiguous_iterator(thrust::get<Is>(first.get_iterator_tuple()))...),
+    static_cast<std::ptrdiff_t>(n),
+    thrust::make_tuple(thrust::detail::try_unwrap_contiguous_iterator(thrust::get<Is>(result.get_iterator_tuple()))...),
+    copy_detail::copy_chunk_size<T>());
+
+  return result + n;
+} // end copy_columns_n()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename Size,
+         typename OutputIterator>
+_CCCL_HOST_DEVICE
+  OutputIterator copy_n(thrust::execution_policy<DerivedPolicy> &exec,
+                        InputIterator                            first,
+                        Size                                     n,
+                        OutputIterator                           result,
+                        thrust::detail::true_type)  // is_contiguous_zip_copy
+{
+  return copy_detail::copy_columns_n(exec, first, n, result,
+    thrust::make_index_sequence<thrust::detail::zip_iterator_size<InputIterator>::value>());
+} // end copy_n()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator>
+_CCCL_HOST_DEVICE
+  OutputIterator copy_elements(thrust::execution_policy<DerivedPolicy> &exec,
+                               InputIterator                            first,
+                               InputIterator                            last,
+                               OutputIterator                           result,
+                               thrust::detail::true_type)  // is_indirectly_trivially_relocatable_to
+{
+  return copy_detail::copy_elements_n(exec, first, thrust::distance(first, last), result, thrust::detail::true_type());
+} // end copy_elements()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator>
+_CCCL_HOST_DEVICE
+  OutputIterator copy_elements(thrust::execution_policy<DerivedPolicy> &exec,
+                               InputIterator                            first,
+                               InputIterator                            last,
+                               OutputIterator                           result,
+                               thrust::detail::false_type)  // is_indirectly_trivially_relocatable_to
+{
+  typedef typename thrust::iterator_value<InputIterator>::type T;
+  return thrust::transform(exec, first, last, result, thrust::identity<T>());
+} // end copy_elements()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator>
+_CCCL_HOST_DEVICE
+  OutputIterator copy(thrust::execution_policy<DerivedPolicy> &exec,
+                      InputIterator                            first,
+                      InputIterator                            last,
+                      OutputIterator                           result,
+                      thrust::detail::false_type)  // is_contiguous_zip_copy
+{
+  return copy_detail::copy_elements(exec, first, last, result,
+    typename thrust::is_indirectly_trivially_relocatable_to<InputIterator,OutputIterator>::type());
+} // end copy()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator>
+_CCCL_HOST_DEVICE
+  OutputIterator copy(thrust::execution_policy<DerivedPolicy> &exec,
+                      InputIterator                            first,
+                      InputIterator                            last,
+                      OutputIterator                           result,
+                      thrust::detail::true_type)  // is_contiguous_zip_copy
+{
+  return copy_detail::copy_n(exec, first, thrust::distance(first, last), result, thrust::detail::true_type());
+} // end copy()
+
+
+} // end copy_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator>
+_CCCL_HOST_DEVICE
+  OutputIterator copy(thrust::execution_policy<DerivedPolicy> &exec,
+                      InputIterator                            first,
+                      InputIterator                            last,
+                      OutputIterator                           result)
+{
+  return copy_detail::copy(exec, first, last, result,
+    typename thrust::detail::is_contiguous_zip_copy<InputIterator,OutputIterator>::type());
+} // end copy()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename Size,
+         typename OutputIterator>
+_CCCL_HOST_DEVICE
+  OutputIterator copy_n(thrust::execution_policy<DerivedPolicy> &exec,
+                        InputIterator                            first,
+                        Size                                     n,
+                        OutputIterator                           result)
+{
+  return copy_detail::copy_n(exec, first, n, result,
+    typename thrust::detail::is_contiguous_zip_copy<InputIterator,OutputIterator>::type());
 } // end copy_n()
 
 
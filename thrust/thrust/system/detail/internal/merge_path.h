@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/function.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/pair.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+  // Co-ranks the output position diag of the stable merge of
+  // [first1, first1 + n1) and [first2, first2 + n2): returns the number of
+  // elements of the first range among the first diag merged elements.
+  // Elements of the first range precede equivalent elements of the second,
+  // so merging the pieces between consecutive co-ranks independently
+  // reproduces the full merge.
+  _CCCL_EXEC_CHECK_DISABLE
+  template <typename RandomAccessIterator1,
+            typename RandomAccessIterator2,
+            typename Size,
+            typename StrictWeakOrdering>
+  _CCCL_HOST_DEVICE
+    Size merge_path(RandomAccessIterator1 first1, Size n1,
+                    RandomAccessIterator2 first2, Size n2,
+                    Size diag,
+                    StrictWeakOrdering comp)
+  {
+    thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+    Size begin = diag > n2 ? diag - n2 : Size(0);
+    Size end   = diag < n1 ? diag      : n1;
+
+    while(begin < end)
+    {
+      Size mid = begin + (end - begin) / 2;
+
+      if(wrapped_comp(first2[diag - 1 - mid], first1[mid]))
+      {
+        end = mid;
+      }
+      else
+      {
+        begin = mid + 1;
+      }
+    }
+
+    return begin;
+  }
+
+
+  _CCCL_EXEC_CHECK_DISABLE
+  template <typename RandomAccessIterator,
+            typename Size,
+            typename T,
+            typename StrictWeakOrdering>
+  _CCCL_HOST_DEVICE
+    Size lower_bound_index(RandomAccessIterator first, Size n,
+                           const T &value,
+                           StrictWeakOrdering comp)
+  {
+    thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+    Size begin = 0;
+    Size end   = n;
+
+    while(begin < end)
+    {
+      Size mid = begin + (end - begin) / 2;
+
+      if(wrapped_comp(first[mid], value))
+      {
+        begin = mid + 1;
+      }
+      else
+      {
+        end = mid;
+      }
+    }
+
+    return begin;
+  }
+
+
+  // Splits [first1, first1 + n1) and [first2, first2 + n2) near the output
+  // position diag of their merge such that no run of equivalent elements
+  // straddles the split in either range. The merge path split is moved back
+  // to the beginning of the run containing the next merged element, so set
+  // operations on the pieces between consecutive splits can be evaluated
+  // independently. Returns the split positions in both ranges.
+  _CCCL_EXEC_CHECK_DISABLE
+  template <typename RandomAccessIterator1,
+            typename RandomAccessIterator2,
+            typename Size,
+            typename StrictWeakOrdering>
+  _CCCL_HOST_DEVICE
+    thrust::pair<Size,Size> balanced_path(RandomAccessIterator1 first1, Size n1,
+                                          RandomAccessIterator2 first2, Size n2,
+                                          Size diag,
+                                          StrictWeakOrdering comp)
+  {
+    thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+    Size i = merge_path(first1, n1, first2, n2, diag, comp);
+    Size j = diag - i;
+
+    if(i < n1 && (j == n2 || !wrapped_comp(first2[j], first1[i])))
+    {
+      typename thrust::iterator_value<RandomAccessIterator1>::type key = first1[i];
+
+      i = lower_bound_index(first1, i, key, comp);
+      j = lower_bound_index(first2, j, key, comp);
+    }
+    else if(j < n2)
+    {
+      typename thrust::iterator_value<RandomAccessIterator2>::type key = first2[j];
+
+      i = lower_bound_index(first1, i, key, comp);
+      j = lower_bound_index(first2, j, key, comp);
+    }
+
+    return thrust::make_pair(i, j);
+  }
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
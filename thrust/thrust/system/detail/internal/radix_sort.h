@@ -0,0 +1,201 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/functional.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/system/detail/sequential/stable_radix_sort.h>
+
+#include <cstddef>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+  // The building blocks of a stable LSD radix sort whose passes are split
+  // into tiles: every tile counts the digits of its keys, the counts of all
+  // tiles are scanned into per-tile scatter offsets, and every tile scatters
+  // its keys to those offsets. The tiles of a pass are independent, so
+  // the host backends run them in parallel.
+
+  // Radix sort applies where the sequential backend uses its primitive sort:
+  // to arithmetic keys ordered by less or greater. bool keys are excluded
+  // since they have nothing to gain from it.
+  template <typename KeyType, typename Compare>
+  struct use_radix_sort
+    : thrust::detail::and_<
+        thrust::detail::is_non_bool_arithmetic<KeyType>,
+        thrust::detail::or_<
+          thrust::detail::is_same<Compare, thrust::less<KeyType> >,
+          thrust::detail::is_same<Compare, thrust::greater<KeyType> >
+        >
+      >
+  {};
+
+
+  template <typename KeyType, typename Compare>
+  struct radix_sort_traits
+  {
+    typedef thrust::system::detail::sequential::radix_sort_detail::RadixEncoder<KeyType> encoder_type;
+    typedef typename encoder_type::result_type                                              encoded_type;
+
+    static const unsigned int radix_bits  = 8;
+    static const unsigned int num_buckets = 1 << radix_bits;
+    static const unsigned int num_passes  = (8 * sizeof(encoded_type) + radix_bits - 1) / radix_bits;
+
+    // sorting by greater is sorting by the complement of the encoding
+    static const bool descending = thrust::detail::is_same<Compare, thrust::greater<KeyType> >::value;
+
+    static std::size_t bucket(const KeyType &key, unsigned int pass)
+    {
+      encoded_type x = encoder_type()(key);
+
+      if(descending)
+      {
+        x = static_cast<encoded_type>(~x);
+      }
+
+      return static_cast<std::size_t>((x >> (radix_bits * pass)) & (num_buckets - 1));
+    }
+  };
+
+
+  // Counts the digits of [keys, keys + n) of the given pass into histogram.
+  template <typename Compare,
+            typename RandomAccessIterator,
+            typename Size>
+    void radix_histogram(RandomAccessIterator keys,
+                         Size n,
+                         unsigned int pass,
+                         std::size_t *histogram)
+  {
+    typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+    typedef radix_sort_traits<KeyType,Compare>                          traits;
+
+    for(unsigned int i = 0; i < traits::num_buckets; ++i)
+    {
+      histogram[i] = 0;
+    }
+
+    for(Size i = 0; i < n; ++i)
+    {
+      ++histogram[traits::bucket(keys[i], pass)];
+    }
+  }
+
+
+  // Turns the num_tiles consecutive histograms of a pass over n keys into the
+  // offsets at which every tile scatters its keys. Returns false if all keys
+  // share the same digit, in which case the pass can be skipped.
+  template <typename Size>
+    bool radix_offsets(std::size_t *histograms,
+                       Size num_tiles,
+                       unsigned int num_buckets,
+                       std::size_t n)
+  {
+    std::size_t sum = 0;
+
+    for(unsigned int b = 0; b < num_buckets; ++b)
+    {
+      std::size_t bucket_begin = sum;
+
+      for(Size t = 0; t < num_tiles; ++t)
+      {
+        std::size_t count = histograms[t * num_buckets + b];
+        histograms[t * num_buckets + b] = sum;
+        sum += count;
+      }
+
+      if(sum - bucket_begin == n)
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+
+  // Scatters [keys, keys + n) to the offsets of their digits, in order.
+  template <typename Compare,
+            typename RandomAccessIterator1,
+            typename Size,
+            typename RandomAccessIterator2>
+    void radix_scatter(RandomAccessIterator1 keys,
+                       Size n,
+                       unsigned int pass,
+                       std::size_t *offsets,
+                       RandomAccessIterator2 keys_result)
+  {
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+    typedef radix_sort_traits<KeyType,Compare>                           traits;
+
+    for(Size i = 0; i < n; ++i)
+    {
+      KeyType key = keys[i];
+      keys_result[offsets[traits::bucket(key, pass)]++] = key;
+    }
+  }
+
+
+  template <typename Compare,
+            typename RandomAccessIterator1,
+            typename RandomAccessIterator2,
+            typename Size,
+            typename RandomAccessIterator3,
+            typename RandomAccessIterator4>
+    void radix_scatter_by_key(RandomAccessIterator1 keys,
+                              RandomAccessIterator2 values,
+                              Size n,
+                              unsigned int pass,
+                              std::size_t *offsets,
+                              RandomAccessIterator3 keys_result,
+                              RandomAccessIterator4 values_result)
+  {
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+    typedef radix_sort_traits<KeyType,Compare>                           traits;
+
+    for(Size i = 0; i < n; ++i)
+    {
+      KeyType     key    = keys[i];
+      std::size_t offset = offsets[traits::bucket(key, pass)]++;
+
+      keys_result[offset]   = key;
+      values_result[offset] = values[i];
+    }
+  }
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -32,6 +32,8 @@
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/type_traits/pointer_traits.h>
 #include <thrust/type_traits/is_trivially_relocatable.h>
+#include <thrust/type_traits/integer_sequence.h>
+#include <thrust/iterator/detail/contiguous_zip_iterator.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -113,7 +115,77 @@ _CCCL_HOST_DEVICE
 } // end copy_n()
 
 
-} // end namespace copy_detail
+// copies structures of arrays column by column, so that contiguous columns
+// of trivially relocatable types are copied as a whole
+_CCCL_EXEC_CHECK_DISABLE
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename Size,
+         typename OutputIterator,
+         std::size_t... Is>
+_CCCL_HOST_DEVICE
+  OutputIterator copy_columns_n(sequential::execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                Size n,
+                                OutputIterator result,
+                                thrust::index_sequence<Is...>)
+{
+  int ignored[] = {
+    (thrust::system::detail::sequential::copy_n(exec, thrust::get<Is>(first.get_iterator_tuple()), n, thrust::get<Is>(result.get_iterator_tuple())), 0)...
+  };
+  (void) ignored;
+
+  return result + n;
+} // end copy_columns_n()
+
+
+_CCCL_EXEC_CHECK_DISABLE
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename Size,
+         typename OutputIterator>
+_CCCL_HOST_DEVICE
+  OutputIterator copy_n(sequential::execution_policy<DerivedPolicy> &exec,
+                        InputIterator first,
+                        Size n,
+                        OutputIterator result,
+                        thrust::detail::true_type)  // is_contiguous_zip_copy
+{
+  return copy_detail::copy_columns_n(exec, first, n, result,
+    thrust::make_index_sequence<thrust::detail::zip_iterator_size<InputIterator>::value>());
+} // end copy_n()
+
+
+_CCCL_EXEC_CHECK_DISABLE
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename Size,
+         typename OutputIterator>
+_CCCL_HOST_DEVICE
+  OutputIterator copy_n(sequential::execution_policy<DerivedPolicy> &,
+                        InputIterator first,
+                        Size n,
+                        OutputIterator result,
+                        thrust::detail::false_type)  // is_contiguous_zip_copy
+{
+  return copy_detail::copy_n(first, n, result,
+    typename thrust::is_indirectly_trivially_relocatable_to<InputIterator,OutputIterator>::type());
+} // end copy_n()
+
+
+_CCCL_EXEC_CHECK_DISABLE
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator>
+_CCCL_HOST_DEVICE
+  OutputIterator copy(sequential::execution_policy<DerivedPolicy> &exec,
+                      InputIterator first,
+                      InputIterator last,
+                      OutputIterator result,
+                      thrust::detail::true_type)  // is_contiguous_zip_copy
+{
+  return copy_detail::copy_n(exec, first, last - first, result, thrust::detail::true_type());
+} // end copy()
 
 
 _CCCL_EXEC_CHECK_DISABLE
@@ -124,26 +196,45 @@ _CCCL_HOST_DEVICE
   OutputIterator copy(sequential::execution_policy<DerivedPolicy> &,
                       InputIterator first,
                       InputIterator last,
-                      OutputIterator result)
+                      OutputIterator result,
+                      thrust::detail::false_type)  // is_contiguous_zip_copy
 {
-  return thrust::system::detail::sequential::copy_detail::copy(first, last, result,
+  return copy_detail::copy(first, last, result,
     typename thrust::is_indirectly_trivially_relocatable_to<InputIterator,OutputIterator>::type());
 } // end copy()
 
 
+} // end namespace copy_detail
+
+
+_CCCL_EXEC_CHECK_DISABLE
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator>
+_CCCL_HOST_DEVICE
+  OutputIterator copy(sequential::execution_policy<DerivedPolicy> &exec,
+                      InputIterator first,
+                      InputIterator last,
+                      OutputIterator result)
+{
+  return thrust::system::detail::sequential::copy_detail::copy(exec, first, last, result,
+    typename thrust::detail::is_contiguous_zip_copy<InputIterator,OutputIterator>::type());
+} // end copy()
+
+
 _CCCL_EXEC_CHECK_DISABLE
 template<typename DerivedPolicy,
          typename InputIterator,
          typename Size,
          typename OutputIterator>
 _CCCL_HOST_DEVICE
-  OutputIterator copy_n(sequential::execution_policy<DerivedPolicy> &,
+  OutputIterator copy_n(sequential::execution_policy<DerivedPolicy> &exec,
                         InputIterator first,
                         Size n,
                         OutputIterator result)
 {
-  return thrust::system::detail::sequential::copy_detail::copy_n(first, n, result,
-    typename thrust::is_indirectly_trivially_relocatable_to<InputIterator,OutputIterator>::type());
+  return thrust::system::detail::sequential::copy_detail::copy_n(exec, first, n, result,
+    typename thrust::detail::is_contiguous_zip_copy<InputIterator,OutputIterator>::type());
 } // end copy_n()
 
 
@@ -31,6 +31,8 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/detail/function.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/detail/contiguous_zip_iterator.h>
 #include <thrust/system/detail/sequential/execution_policy.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -40,17 +42,19 @@ namespace detail
 {
 namespace sequential
 {
+namespace for_each_detail
+{
 
 
 _CCCL_EXEC_CHECK_DISABLE
-template<typename DerivedPolicy,
-         typename InputIterator,
+template<typename InputIterator,
+         typename Size,
          typename UnaryFunction>
 _CCCL_HOST_DEVICE
-InputIterator for_each(sequential::execution_policy<DerivedPolicy> &,
-                       InputIterator first,
-                       InputIterator last,
-                       UnaryFunction f)
+InputIterator for_each_n(InputIterator first,
+                         Size n,
+                         UnaryFunction f,
+                         thrust::incrementable_traversal_tag)
 {
   // wrap f
   thrust::detail::wrapped_function<
@@ -58,40 +62,118 @@ InputIterator for_each(sequential::execution_policy<DerivedPolicy> &,
     void
   > wrapped_f(f);
 
-  for(; first != last; ++first)
+  for(Size i = 0; i != n; i++)
   {
+    // we can dereference an OutputIterator if f does not
+    // try to use the reference for anything besides assignment
     wrapped_f(*first);
+    ++first;
   }
 
   return first;
-} // end for_each()
+} // end for_each_n()
 
 
-template<typename DerivedPolicy,
-         typename InputIterator,
+// loops over random access ranges through raw pointers where they're
+// contiguous, so that loops over zipped structures of arrays dereference
+// plain references and can be vectorized
+_CCCL_EXEC_CHECK_DISABLE
+template<typename RandomAccessIterator,
          typename Size,
          typename UnaryFunction>
 _CCCL_HOST_DEVICE
-InputIterator for_each_n(sequential::execution_policy<DerivedPolicy> &,
-                         InputIterator first,
-                         Size n,
-                         UnaryFunction f)
+RandomAccessIterator for_each_n(RandomAccessIterator first,
+                                Size n,
+                                UnaryFunction f,
+                                thrust::random_access_traversal_tag)
 {
+  if(n <= 0) return first;
+
   // wrap f
   thrust::detail::wrapped_function<
     UnaryFunction,
     void
   > wrapped_f(f);
 
+  typedef thrust::detail::try_unwrap_zipped_contiguous_iterator_return_t<RandomAccessIterator> UnwrappedIterator;
+  UnwrappedIterator unwrapped_first = thrust::detail::try_unwrap_zipped_contiguous_iterator(first);
+
   for(Size i = 0; i != n; i++)
   {
-    // we can dereference an OutputIterator if f does not
-    // try to use the reference for anything besides assignment
+    wrapped_f(unwrapped_first[i]);
+  }
+
+  return first + n;
+} // end for_each_n()
+
+
+_CCCL_EXEC_CHECK_DISABLE
+template<typename InputIterator,
+         typename UnaryFunction>
+_CCCL_HOST_DEVICE
+InputIterator for_each(InputIterator first,
+                       InputIterator last,
+                       UnaryFunction f,
+                       thrust::incrementable_traversal_tag)
+{
+  // wrap f
+  thrust::detail::wrapped_function<
+    UnaryFunction,
+    void
+  > wrapped_f(f);
+
+  for(; first != last; ++first)
+  {
     wrapped_f(*first);
-    ++first;
   }
 
   return first;
+} // end for_each()
+
+
+_CCCL_EXEC_CHECK_DISABLE
+template<typename RandomAccessIterator,
+         typename UnaryFunction>
+_CCCL_HOST_DEVICE
+RandomAccessIterator for_each(RandomAccessIterator first,
+                              RandomAccessIterator last,
+                              UnaryFunction f,
+                              thrust::random_access_traversal_tag)
+{
+  return for_each_detail::for_each_n(first, last - first, f, thrust::random_access_traversal_tag());
+} // end for_each()
+
+
+} // end for_each_detail
+
+
+_CCCL_EXEC_CHECK_DISABLE
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename UnaryFunction>
+_CCCL_HOST_DEVICE
+InputIterator for_each(sequential::execution_policy<DerivedPolicy> &,
+                       InputIterator first,
+                       InputIterator last,
+                       UnaryFunction f)
+{
+  return for_each_detail::for_each(first, last, f,
+    typename thrust::iterator_traversal<InputIterator>::type());
+} // end for_each()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename Size,
+         typename UnaryFunction>
+_CCCL_HOST_DEVICE
+InputIterator for_each_n(sequential::execution_policy<DerivedPolicy> &,
+                         InputIterator first,
+                         Size n,
+                         UnaryFunction f)
+{
+  return for_each_detail::for_each_n(first, n, f,
+    typename thrust::iterator_traversal<InputIterator>::type());
 } // end for_each_n()
 
 
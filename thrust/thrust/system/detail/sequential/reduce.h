@@ -31,6 +31,8 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/detail/function.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/detail/contiguous_zip_iterator.h>
 #include <thrust/system/detail/sequential/execution_policy.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -40,19 +42,20 @@ namespace detail
 {
 namespace sequential
 {
+namespace reduce_detail
+{
 
 
 _CCCL_EXEC_CHECK_DISABLE
-template<typename DerivedPolicy,
-         typename InputIterator,
+template<typename InputIterator,
          typename OutputType,
          typename BinaryFunction>
 _CCCL_HOST_DEVICE
-  OutputType reduce(sequential::execution_policy<DerivedPolicy> &,
-                    InputIterator begin,
+  OutputType reduce(InputIterator begin,
                     InputIterator end,
                     OutputType init,
-                    BinaryFunction binary_op)
+                    BinaryFunction binary_op,
+                    thrust::incrementable_traversal_tag)
 {
   // wrap binary_op
   thrust::detail::wrapped_function<
@@ -73,6 +76,66 @@ _CCCL_HOST_DEVICE
 }
 
 
+// reduces through raw pointers when the input is contiguous, or a zip of
+// contiguous ranges
+_CCCL_EXEC_CHECK_DISABLE
+template<typename RandomAccessIterator,
+         typename OutputType,
+         typename BinaryFunction>
+_CCCL_HOST_DEVICE
+  OutputType reduce(RandomAccessIterator begin,
+                    RandomAccessIterator end,
+                    OutputType init,
+                    BinaryFunction binary_op,
+                    thrust::random_access_traversal_tag)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type Size;
+
+  const Size n = end - begin;
+
+  if(n <= 0) return init;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<
+    BinaryFunction,
+    OutputType
+  > wrapped_binary_op(binary_op);
+
+  typedef thrust::detail::try_unwrap_zipped_contiguous_iterator_return_t<RandomAccessIterator> UnwrappedIterator;
+  UnwrappedIterator unwrapped_begin = thrust::detail::try_unwrap_zipped_contiguous_iterator(begin);
+
+  // initialize the result
+  OutputType result = init;
+
+  for(Size i = 0; i != n; ++i)
+  {
+    result = wrapped_binary_op(result, unwrapped_begin[i]);
+  }
+
+  return result;
+}
+
+
+} // end reduce_detail
+
+
+_CCCL_EXEC_CHECK_DISABLE
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputType,
+         typename BinaryFunction>
+_CCCL_HOST_DEVICE
+  OutputType reduce(sequential::execution_policy<DerivedPolicy> &,
+                    InputIterator begin,
+                    InputIterator end,
+                    OutputType init,
+                    BinaryFunction binary_op)
+{
+  return reduce_detail::reduce(begin, end, init, binary_op,
+    typename thrust::iterator_traversal<InputIterator>::type());
+}
+
+
 } // end namespace sequential
 } // end namespace detail
 } // end namespace system
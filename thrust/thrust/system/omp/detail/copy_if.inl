@@ -26,7 +26,14 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/omp/detail/copy_if.h>
-#include <thrust/system/detail/generic/copy_if.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/small_temporary_array.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -35,6 +42,117 @@ namespace omp
 {
 namespace detail
 {
+namespace copy_if_detail
+{
+
+
+// Counts the elements of every interval of decomp whose stencil satisfies
+// pred, and scans the counts into per-interval output offsets. Returns the
+// total number of selected elements.
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename Predicate,
+         typename Decomposition,
+         typename Size>
+  Size count_if_intervals(execution_policy<DerivedPolicy> &exec,
+                          InputIterator stencil,
+                          Predicate pred,
+                          Decomposition decomp,
+                          Size *offsets)
+{
+  typedef thrust::detail::intptr_t index_type;
+
+  thrust::detail::wrapped_function<Predicate,bool> wrapped_pred(pred);
+
+  index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_intervals);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    InputIterator iter = stencil + decomp[i].begin();
+    InputIterator end  = stencil + decomp[i].end();
+
+    Size count = 0;
+
+    for(; iter != end; ++iter)
+    {
+      if(wrapped_pred(*iter))
+      {
+        ++count;
+      }
+    }
+
+    offsets[i] = count;
+  }
+
+  Size sum = 0;
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    Size count = offsets[i];
+    offsets[i] = sum;
+    sum += count;
+  }
+
+  return sum;
+}
+
+
+// Stream compaction over the intervals of decomp. Every interval first
+// counts its selected elements, the counts are scanned into output
+// offsets, and then every interval writes its selected elements starting
+// at its offset. Only one offset per interval is stored, so no temporary
+// proportional to the input size is needed.
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename Predicate,
+         typename Decomposition>
+  OutputIterator copy_if_intervals(execution_policy<DerivedPolicy> &exec,
+                                   InputIterator1 first,
+                                   InputIterator2 stencil,
+                                   OutputIterator result,
+                                   Predicate pred,
+                                   Decomposition decomp)
+{
+  typedef thrust::detail::intptr_t index_type;
+
+  thrust::detail::wrapped_function<Predicate,bool> wrapped_pred(pred);
+
+  index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  thrust::detail::small_temporary_array<index_type,DerivedPolicy> offsets(exec, num_intervals);
+  index_type *offset = thrust::raw_pointer_cast(offsets.data());
+
+  index_type num_selected = copy_if_detail::count_if_intervals(exec, stencil, pred, decomp, offset);
+
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_intervals);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    InputIterator1 iter1 = first   + decomp[i].begin();
+    InputIterator2 iter2 = stencil + decomp[i].begin();
+    InputIterator2 end   = stencil + decomp[i].end();
+    OutputIterator out   = result  + offset[i];
+
+    for(; iter2 != end; ++iter1, ++iter2)
+    {
+      if(wrapped_pred(*iter2))
+      {
+        *out = *iter1;
+        ++out;
+      }
+    }
+  }
+
+  return result + num_selected;
+}
+
+
+} // end copy_if_detail
 
 
 template<typename DerivedPolicy,
@@ -49,8 +167,29 @@ template<typename DerivedPolicy,
                          OutputIterator result,
                          Predicate pred)
 {
-  // omp prefers generic::copy_if to cpp::copy_if
-  return thrust::system::detail::generic::copy_if(exec, first, last, stencil, result, pred);
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  difference_type n = thrust::distance(first, last);
+
+  if(n == 0)
+  {
+    return result;
+  }
+
+  return copy_if_detail::copy_if_intervals(exec, first, stencil, result, pred,
+                                           thrust::system::omp::detail::default_decomposition(exec, n));
 } // end copy_if()
 
 
@@ -31,6 +31,9 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/detail/execution_policy.h>
+
+#include <cstddef>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -40,8 +43,34 @@ namespace omp
 namespace detail
 {
 
-template <typename IndexType>
-thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(IndexType n);
+// the fewest elements per thread when exec doesn't select it: about as many
+// simple operations as a thread performs while a team forks and joins
+const std::size_t default_min_elements_per_thread = 4096;
+
+// the most threads an algorithm may run under exec
+template <typename DerivedPolicy>
+int max_threads(execution_policy<DerivedPolicy> &exec);
+
+// the fewest elements an algorithm should hand each thread under exec, or
+// default_value when exec doesn't select it
+template <typename DerivedPolicy>
+std::size_t min_elements_per_thread(execution_policy<DerivedPolicy> &exec,
+                                    std::size_t default_value = default_min_elements_per_thread);
+
+// the number of threads to run num_tasks independent tasks under exec
+template <typename DerivedPolicy, typename IndexType>
+int team_size(execution_policy<DerivedPolicy> &exec, IndexType num_tasks);
+
+// the number of threads to process n elements under exec
+template <typename DerivedPolicy, typename IndexType>
+int num_threads_for(execution_policy<DerivedPolicy> &exec,
+                    IndexType n,
+                    std::size_t default_min_elements = default_min_elements_per_thread);
+
+// splits n elements into one interval per thread
+template <typename DerivedPolicy, typename IndexType>
+thrust::system::detail::internal::uniform_decomposition<IndexType>
+default_decomposition(execution_policy<DerivedPolicy> &exec, IndexType n);
 
 } // end namespace detail
 } // end namespace omp
@@ -26,6 +26,9 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/par.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/extrema.h>
 
 // don't attempt to #include this file without omp support
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
@@ -40,8 +43,8 @@ namespace omp
 namespace detail
 {
 
-template <typename IndexType>
-thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(IndexType n)
+template <typename DerivedPolicy>
+int max_threads(execution_policy<DerivedPolicy> &exec)
 {
   // we're attempting to launch an omp kernel, assert we're compiling with omp support
   // ========================================================================
@@ -50,18 +53,54 @@ thrust::system::detail::internal::uniform_decomposition<IndexType> default_decom
   // ========================================================================
   THRUST_STATIC_ASSERT_MSG(
     (thrust::detail::depend_on_instantiation<
-      IndexType, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+      DerivedPolicy, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
     >::value)
   , "OpenMP compiler support is not enabled"
   );
 
+  int result = get_num_threads(thrust::detail::derived_cast(exec));
+
+  if(result > 0)
+  {
+    return result;
+  }
+
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, omp_get_num_procs());
+  return omp_get_max_threads();
 #else
-  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, 1);
+  return 1;
 #endif
 }
 
+template <typename DerivedPolicy>
+std::size_t min_elements_per_thread(execution_policy<DerivedPolicy> &exec, std::size_t default_value)
+{
+  std::size_t result = get_min_elements_per_thread(thrust::detail::derived_cast(exec));
+
+  return result > 0 ? result : default_value;
+}
+
+template <typename DerivedPolicy, typename IndexType>
+int team_size(execution_policy<DerivedPolicy> &exec, IndexType num_tasks)
+{
+  const int p = max_threads(exec);
+
+  return num_tasks < static_cast<IndexType>(p) ? thrust::max<int>(1, static_cast<int>(num_tasks)) : p;
+}
+
+template <typename DerivedPolicy, typename IndexType>
+int num_threads_for(execution_policy<DerivedPolicy> &exec, IndexType n, std::size_t default_min_elements)
+{
+  return team_size(exec, static_cast<std::size_t>(n) / min_elements_per_thread(exec, default_min_elements));
+}
+
+template <typename DerivedPolicy, typename IndexType>
+thrust::system::detail::internal::uniform_decomposition<IndexType>
+default_decomposition(execution_policy<DerivedPolicy> &exec, IndexType n)
+{
+  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, num_threads_for(exec, n));
+}
+
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/find.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/detail/sequential/find.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/distance.h>
+#include <thrust/extrema.h>
+
+#include <atomic>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace find_detail
+{
+
+
+// lowers result to index, unless it already holds a smaller index
+template<typename Size>
+void atomic_min(std::atomic<Size> &result, Size index)
+{
+  Size current = result.load(std::memory_order_relaxed);
+
+  while(index < current && !result.compare_exchange_weak(current, index, std::memory_order_relaxed))
+  {
+  }
+}
+
+
+} // end find_detail
+
+
+template <typename DerivedPolicy, typename InputIterator, typename Predicate>
+InputIterator find_if(execution_policy<DerivedPolicy> &exec,
+                      InputIterator first,
+                      InputIterator last,
+                      Predicate pred)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n = static_cast<index_type>(thrust::distance(first, last));
+
+  // the number of elements searched between checks for a match found by
+  // another thread: checks stay rare, yet the search stops soon after a match
+  const index_type chunk_size = 1 << 14;
+
+  const int num_threads = thrust::system::omp::detail::num_threads_for(exec, n);
+
+  // small inputs run on the calling thread alone
+  if(num_threads < 2 || n <= chunk_size)
+  {
+    return thrust::system::detail::sequential::find_if(exec, first, last, pred);
+  }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  // wrap pred
+  thrust::detail::wrapped_function<Predicate,bool> wrapped_pred(pred);
+
+  const index_type num_chunks = (n + chunk_size - 1) / chunk_size;
+
+  // the smallest index found so far to satisfy pred
+  std::atomic<index_type> result(n);
+
+  // chunks are handed out in order, so the chunks before a match tend to be
+  // underway by the time it is found, and those after it are skipped
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads) schedule(dynamic))
+  for(index_type i = 0; i < num_chunks; ++i)
+  {
+    const index_type begin = i * chunk_size;
+
+    if(begin < result.load(std::memory_order_relaxed))
+    {
+      const index_type end = thrust::min<index_type>(begin + chunk_size, n);
+
+      InputIterator iter = first + begin;
+
+      for(index_type j = begin; j < end; ++j, ++iter)
+      {
+        if(wrapped_pred(*iter))
+        {
+          find_detail::atomic_min(result, j);
+          break;
+        }
+      }
+    }
+  }
+
+  return first + result.load();
+#else
+  return last;
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -30,7 +30,16 @@
 #include <thrust/distance.h>
 #include <thrust/for_each.h>
 #include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/detail/contiguous_zip_iterator.h>
 #include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/par.h>
+#include <thrust/system/detail/sequential/for_each.h>
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -39,12 +48,59 @@ namespace omp
 {
 namespace detail
 {
+namespace for_each_detail
+{
+
+
+// omp_set_schedule first appeared in OpenMP 3.0
+#if defined(_OPENMP) && (_OPENMP >= 200805)
+// selects the schedule of loops marked schedule(runtime) on this thread,
+// until the guard goes out of scope
+class scoped_schedule
+{
+  omp_sched_t m_old_kind;
+  int m_old_chunk_size;
+
+public:
+  explicit scoped_schedule(schedule_kind schedule)
+  {
+    omp_get_schedule(&m_old_kind, &m_old_chunk_size);
+
+    // enough iterations to amortize taking a chunk from the shared counter
+    const int chunk_size = 256;
+
+    switch(schedule)
+    {
+      case schedule_dynamic: omp_set_schedule(omp_sched_dynamic, chunk_size); break;
+      case schedule_guided:  omp_set_schedule(omp_sched_guided,  chunk_size); break;
+      default:               omp_set_schedule(omp_sched_static,  0);          break;
+    }
+  }
+
+  ~scoped_schedule()
+  {
+    omp_set_schedule(m_old_kind, m_old_chunk_size);
+  }
+};
+#else
+// the schedule can't be selected at runtime, so loops marked
+// schedule(runtime) follow OMP_SCHEDULE
+class scoped_schedule
+{
+public:
+  explicit scoped_schedule(schedule_kind) {}
+};
+#endif
+
+
+} // end for_each_detail
+
 
 template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename Size,
          typename UnaryFunction>
-RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
+RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &exec,
                                 RandomAccessIterator first,
                                 Size n,
                                 UnaryFunction f)
@@ -63,6 +119,18 @@ RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
 
   if (n <= 0) return first;  //empty range
 
+  // a single call of f may be heavy, so every element is worth a thread
+  // unless exec asks for a minimum
+  const int num_threads = thrust::system::omp::detail::num_threads_for(exec, n, 1);
+
+  // inputs too small for exec's minimum run on the calling thread alone
+  if (num_threads < 2)
+  {
+    return thrust::system::detail::sequential::for_each_n(exec, first, n, f);
+  }
+
+  for_each_detail::scoped_schedule schedule(get_schedule(thrust::detail::derived_cast(exec)));
+
   // create a wrapped function for f
   thrust::detail::wrapped_function<UnaryFunction,void> wrapped_f(f);
 
@@ -70,13 +138,16 @@ RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
   typedef typename thrust::iterator_difference<RandomAccessIterator>::type DifferenceType;
   DifferenceType signed_n = n;
 
-  THRUST_PRAGMA_OMP(parallel for)
+  // loop through raw pointers where the range is contiguous, or a zip of contiguous ranges
+  typedef thrust::detail::try_unwrap_zipped_contiguous_iterator_return_t<RandomAccessIterator> UnwrappedIterator;
+  UnwrappedIterator unwrapped_first = thrust::detail::try_unwrap_zipped_contiguous_iterator(first);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads) schedule(runtime))
   for(DifferenceType i = 0;
       i < signed_n;
       ++i)
   {
-    RandomAccessIterator temp = first + i;
-    wrapped_f(*temp);
+    wrapped_f(unwrapped_first[i]);
   }
 
   return first + n;
@@ -0,0 +1,240 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/merge.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/merge.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/static_assert.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace merge_detail
+{
+
+
+// Every interval of decomp is a range of output positions. The merge path
+// co-ranks both ends of an interval into the inputs, so every interval
+// merges its own pieces of the inputs with the same amount of work
+// regardless of how the keys are distributed.
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering,
+         typename Decomposition>
+void merge_intervals(execution_policy<DerivedPolicy> &exec,
+                     RandomAccessIterator1 first1,
+                     RandomAccessIterator2 first2,
+                     RandomAccessIterator3 result,
+                     StrictWeakOrdering comp,
+                     typename Decomposition::index_type n1,
+                     typename Decomposition::index_type n2,
+                     Decomposition decomp)
+{
+  typedef typename Decomposition::index_type Size;
+  typedef thrust::detail::intptr_t           index_type;
+
+  index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_intervals);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    Size diag_begin = decomp[i].begin();
+    Size diag_end   = decomp[i].end();
+
+    Size begin1 = thrust::system::detail::internal::merge_path(first1, n1, first2, n2, diag_begin, comp);
+    Size end1   = thrust::system::detail::internal::merge_path(first1, n1, first2, n2, diag_end,   comp);
+
+    Size begin2 = diag_begin - begin1;
+    Size end2   = diag_end   - end1;
+
+    thrust::merge(thrust::seq,
+                  first1 + begin1, first1 + end1,
+                  first2 + begin2, first2 + end2,
+                  result + diag_begin,
+                  comp);
+  }
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename RandomAccessIterator5,
+         typename RandomAccessIterator6,
+         typename StrictWeakOrdering,
+         typename Decomposition>
+void merge_by_key_intervals(execution_policy<DerivedPolicy> &exec,
+                            RandomAccessIterator1 keys_first1,
+                            RandomAccessIterator2 keys_first2,
+                            RandomAccessIterator3 values_first1,
+                            RandomAccessIterator4 values_first2,
+                            RandomAccessIterator5 keys_result,
+                            RandomAccessIterator6 values_result,
+                            StrictWeakOrdering comp,
+                            typename Decomposition::index_type n1,
+                            typename Decomposition::index_type n2,
+                            Decomposition decomp)
+{
+  typedef typename Decomposition::index_type Size;
+  typedef thrust::detail::intptr_t           index_type;
+
+  index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_intervals);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    Size diag_begin = decomp[i].begin();
+    Size diag_end   = decomp[i].end();
+
+    Size begin1 = thrust::system::detail::internal::merge_path(keys_first1, n1, keys_first2, n2, diag_begin, comp);
+    Size end1   = thrust::system::detail::internal::merge_path(keys_first1, n1, keys_first2, n2, diag_end,   comp);
+
+    Size begin2 = diag_begin - begin1;
+    Size end2   = diag_end   - end1;
+
+    thrust::merge_by_key(thrust::seq,
+                         keys_first1 + begin1, keys_first1 + end1,
+                         keys_first2 + begin2, keys_first2 + end2,
+                         values_first1 + begin1,
+                         values_first2 + begin2,
+                         keys_result + diag_begin,
+                         values_result + diag_begin,
+                         comp);
+  }
+}
+
+
+} // end namespace merge_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+OutputIterator merge(execution_policy<DerivedPolicy> &exec,
+                     InputIterator1 first1,
+                     InputIterator1 last1,
+                     InputIterator2 first2,
+                     InputIterator2 last2,
+                     OutputIterator result,
+                     StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+
+  Size n1 = thrust::distance(first1, last1);
+  Size n2 = thrust::distance(first2, last2);
+
+  merge_detail::merge_intervals(exec, first1, first2, result, comp, n1, n2,
+                                thrust::system::omp::detail::default_decomposition(exec, n1 + n2));
+
+  return result + (n1 + n2);
+} // end merge()
+
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename InputIterator3,
+          typename InputIterator4,
+          typename OutputIterator1,
+          typename OutputIterator2,
+          typename StrictWeakOrdering>
+thrust::pair<OutputIterator1,OutputIterator2>
+  merge_by_key(execution_policy<DerivedPolicy> &exec,
+               InputIterator1 keys_first1,
+               InputIterator1 keys_last1,
+               InputIterator2 keys_first2,
+               InputIterator2 keys_last2,
+               InputIterator3 values_first3,
+               InputIterator4 values_first4,
+               OutputIterator1 keys_result,
+               OutputIterator2 values_result,
+               StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+
+  Size n1 = thrust::distance(keys_first1, keys_last1);
+  Size n2 = thrust::distance(keys_first2, keys_last2);
+
+  merge_detail::merge_by_key_intervals(exec, keys_first1, keys_first2,
+                                       values_first3, values_first4,
+                                       keys_result, values_result,
+                                       comp, n1, n2,
+                                       thrust::system::omp::detail::default_decomposition(exec, n1 + n2));
+
+  return thrust::make_pair(keys_result + (n1 + n2), values_result + (n1 + n2));
+} // end merge_by_key()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
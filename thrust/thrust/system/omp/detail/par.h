@@ -27,22 +27,126 @@
 #endif // no system header
 #include <thrust/detail/allocator_aware_execution_policy.h>
 #include <thrust/system/omp/detail/execution_policy.h>
+#include <thrust/detail/execution_policy.h>
+
+#include <cstddef>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
 {
 namespace omp
 {
+
+
+// how the iterations of a loop over elements are divided among threads
+enum schedule_kind
+{
+  schedule_static,
+  schedule_dynamic,
+  schedule_guided
+};
+
+
 namespace detail
 {
 
 
+// An OpenMP policy which carries tuning parameters to the algorithms. A
+// parameter left at zero selects the algorithm's own default.
+template<typename Derived>
+struct execute_with_parameters_base : thrust::system::omp::detail::execution_policy<Derived>
+{
+private:
+  int num_threads;
+  schedule_kind schedule;
+  std::size_t min_elements_per_thread;
+
+public:
+  _CCCL_HOST_DEVICE
+  constexpr execute_with_parameters_base(int num_threads_ = 0,
+                                         schedule_kind schedule_ = schedule_static,
+                                         std::size_t min_elements_per_thread_ = 0)
+    : num_threads(num_threads_),
+      schedule(schedule_),
+      min_elements_per_thread(min_elements_per_thread_)
+  {}
+
+  // runs on at most num_threads threads, giving each at least
+  // min_elements_per_thread elements, so that small inputs run on the
+  // calling thread alone. elementwise loops have no minimum by default
+  Derived with(int num_threads,
+               schedule_kind schedule = schedule_static,
+               std::size_t min_elements_per_thread = 0) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.num_threads = num_threads;
+    result.schedule = schedule;
+    result.min_elements_per_thread = min_elements_per_thread;
+    return result;
+  }
+
+private:
+  friend int get_num_threads(const execute_with_parameters_base &exec)
+  {
+    return exec.num_threads;
+  }
+
+  friend schedule_kind get_schedule(const execute_with_parameters_base &exec)
+  {
+    return exec.schedule;
+  }
+
+  friend std::size_t get_min_elements_per_thread(const execute_with_parameters_base &exec)
+  {
+    return exec.min_elements_per_thread;
+  }
+};
+
+
+// policies without parameters select every default
+template<typename Derived>
+int get_num_threads(const thrust::system::omp::detail::execution_policy<Derived> &)
+{
+  return 0;
+}
+
+
+template<typename Derived>
+schedule_kind get_schedule(const thrust::system::omp::detail::execution_policy<Derived> &)
+{
+  return schedule_static;
+}
+
+
+template<typename Derived>
+std::size_t get_min_elements_per_thread(const thrust::system::omp::detail::execution_policy<Derived> &)
+{
+  return 0;
+}
+
+
+struct execute_with_parameters : execute_with_parameters_base<execute_with_parameters>
+{
+  typedef execute_with_parameters_base<execute_with_parameters> base_t;
+
+  _CCCL_HOST_DEVICE
+  constexpr execute_with_parameters() : base_t() {}
+};
+
+
 struct par_t : thrust::system::omp::detail::execution_policy<par_t>,
   thrust::detail::allocator_aware_execution_policy<
-    thrust::system::omp::detail::execution_policy>
+    execute_with_parameters_base>
 {
   _CCCL_HOST_DEVICE
   constexpr par_t() : thrust::system::omp::detail::execution_policy<par_t>() {}
+
+  execute_with_parameters with(int num_threads,
+                               schedule_kind schedule = schedule_static,
+                               std::size_t min_elements_per_thread = 0) const
+  {
+    return execute_with_parameters().with(num_threads, schedule, min_elements_per_thread);
+  }
 };
 
 
@@ -62,6 +166,10 @@ namespace omp
 
 
 using thrust::system::omp::par;
+using thrust::system::omp::schedule_kind;
+using thrust::system::omp::schedule_static;
+using thrust::system::omp::schedule_dynamic;
+using thrust::system::omp::schedule_guided;
 
 
 } // end omp
@@ -31,7 +31,16 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/omp/detail/partition.h>
-#include <thrust/system/detail/generic/partition.h>
+#include <thrust/system/omp/detail/copy_if.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/small_temporary_array.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -40,6 +49,117 @@ namespace omp
 {
 namespace detail
 {
+namespace partition_detail
+{
+
+
+// Writes every interval of decomp to both partitions in a single pass.
+// true_offsets holds the offset of each interval into the true partition,
+// as computed by copy_if_detail::count_if_intervals; the offset into the
+// false partition follows from the interval's position in the input.
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename Predicate,
+         typename Decomposition,
+         typename Size>
+  void stable_partition_copy_intervals(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first,
+                                       InputIterator2 stencil,
+                                       OutputIterator1 out_true,
+                                       OutputIterator2 out_false,
+                                       Predicate pred,
+                                       Decomposition decomp,
+                                       const Size *true_offsets)
+{
+  typedef thrust::detail::intptr_t index_type;
+
+  thrust::detail::wrapped_function<Predicate,bool> wrapped_pred(pred);
+
+  index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_intervals);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    InputIterator1  iter1 = first     + decomp[i].begin();
+    InputIterator2  iter2 = stencil   + decomp[i].begin();
+    InputIterator2  end   = stencil   + decomp[i].end();
+    OutputIterator1 out1  = out_true  + true_offsets[i];
+    OutputIterator2 out2  = out_false + (static_cast<Size>(decomp[i].begin()) - true_offsets[i]);
+
+    for(; iter2 != end; ++iter1, ++iter2)
+    {
+      if(wrapped_pred(*iter2))
+      {
+        *out1 = *iter1;
+        ++out1;
+      }
+      else
+      {
+        *out2 = *iter1;
+        ++out2;
+      }
+    }
+  }
+}
+
+
+// Partitions [first, last) in place from a copy of its contents which
+// begins at temp.
+template<typename DerivedPolicy,
+         typename ForwardIterator,
+         typename RandomAccessIterator,
+         typename InputIterator,
+         typename Predicate>
+  ForwardIterator stable_partition(execution_policy<DerivedPolicy> &exec,
+                                   ForwardIterator first,
+                                   ForwardIterator last,
+                                   RandomAccessIterator temp,
+                                   InputIterator stencil,
+                                   Predicate pred)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      ForwardIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+
+  difference_type n = thrust::distance(first, last);
+
+  if(n == 0)
+  {
+    return first;
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp =
+    thrust::system::omp::detail::default_decomposition(exec, n);
+
+  thrust::detail::small_temporary_array<difference_type,DerivedPolicy> offsets(exec, decomp.size());
+  difference_type *offset = thrust::raw_pointer_cast(offsets.data());
+
+  // the size of the true partition is known before anything is written,
+  // so both partitions can be written back in a single pass
+  difference_type num_true = copy_if_detail::count_if_intervals(exec, stencil, pred, decomp, offset);
+
+  partition_detail::stable_partition_copy_intervals(exec, temp, stencil, first, first + num_true, pred, decomp, offset);
+
+  return first + num_true;
+}
+
+
+} // end partition_detail
 
 
 template<typename DerivedPolicy,
@@ -50,8 +170,12 @@ template<typename DerivedPolicy,
                                    ForwardIterator last,
                                    Predicate pred)
 {
-  // omp prefers generic::stable_partition to cpp::stable_partition
-  return thrust::system::detail::generic::stable_partition(exec, first, last, pred);
+  typedef typename thrust::iterator_value<ForwardIterator>::type InputType;
+
+  // copy input to temp buffer
+  thrust::detail::temporary_array<InputType,DerivedPolicy> temp(exec, first, last);
+
+  return partition_detail::stable_partition(exec, first, last, temp.begin(), temp.begin(), pred);
 } // end stable_partition()
 
 
@@ -65,8 +189,12 @@ template<typename DerivedPolicy,
                                    InputIterator stencil,
                                    Predicate pred)
 {
-  // omp prefers generic::stable_partition to cpp::stable_partition
-  return thrust::system::detail::generic::stable_partition(exec, first, last, stencil, pred);
+  typedef typename thrust::iterator_value<ForwardIterator>::type InputType;
+
+  // copy input to temp buffer
+  thrust::detail::temporary_array<InputType,DerivedPolicy> temp(exec, first, last);
+
+  return partition_detail::stable_partition(exec, first, last, temp.begin(), stencil, pred);
 } // end stable_partition()
 
 
@@ -83,8 +211,7 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // omp prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, out_true, out_false, pred);
+  return omp::detail::stable_partition_copy(exec, first, last, first, out_true, out_false, pred);
 } // end stable_partition_copy()
 
 
@@ -103,8 +230,38 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // omp prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, stencil, out_true, out_false, pred);
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  difference_type n = thrust::distance(first, last);
+
+  if(n == 0)
+  {
+    return thrust::make_pair(out_true, out_false);
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp =
+    thrust::system::omp::detail::default_decomposition(exec, n);
+
+  thrust::detail::small_temporary_array<difference_type,DerivedPolicy> offsets(exec, decomp.size());
+  difference_type *offset = thrust::raw_pointer_cast(offsets.data());
+
+  difference_type num_true = copy_if_detail::count_if_intervals(exec, stencil, pred, decomp, offset);
+
+  partition_detail::stable_partition_copy_intervals(exec, first, stencil, out_true, out_false, pred, decomp, offset);
+
+  return thrust::make_pair(out_true + num_true, out_false + (n - num_true));
 } // end stable_partition_copy()
 
 
@@ -29,6 +29,7 @@
 #include <thrust/system/omp/detail/reduce.h>
 #include <thrust/system/omp/detail/default_decomposition.h>
 #include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/detail/small_temporary_array.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -54,12 +55,12 @@ template<typename DerivedPolicy,
   const difference_type n = thrust::distance(first,last);
 
   // determine first and second level decomposition
-  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp1 = thrust::system::omp::detail::default_decomposition(n);
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp1 = thrust::system::omp::detail::default_decomposition(exec, n);
   thrust::system::detail::internal::uniform_decomposition<difference_type> decomp2(decomp1.size() + 1, 1, 1);
 
   // allocate storage for the initializer and partial sums
   // XXX use select_system for Tag
-  thrust::detail::temporary_array<OutputType,DerivedPolicy> partial_sums(exec, decomp1.size() + 1);
+  thrust::detail::small_temporary_array<OutputType,DerivedPolicy> partial_sums(exec, decomp1.size() + 1);
 
   // set first element of temp array to init
   partial_sums[0] = init;
@@ -26,8 +26,16 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/omp/detail/reduce_by_key.h>
-#include <thrust/system/detail/generic/reduce_by_key.h>
+#include <thrust/system/omp/detail/scan_by_key.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
 #include <thrust/distance.h>
+#include <thrust/pair.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/small_temporary_array.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -36,6 +44,243 @@ namespace omp
 {
 namespace detail
 {
+namespace reduce_by_key_detail
+{
+
+
+// counts the segment heads in [first_head, end), given that first_head is one
+template<typename InputIterator,
+         typename Size,
+         typename BinaryPredicate>
+Size count_heads(InputIterator keys_first,
+                 Size first_head,
+                 Size end,
+                 BinaryPredicate binary_pred)
+{
+  typedef typename thrust::iterator_value<InputIterator>::type KeyType;
+
+  if(first_head == end)
+  {
+    return 0;
+  }
+
+  InputIterator keys = keys_first + first_head;
+
+  KeyType prev_key = *keys;
+
+  Size count = 1;
+
+  for(Size i = first_head + 1; i < end; ++i)
+  {
+    ++keys;
+
+    KeyType key = *keys;
+
+    if(!binary_pred(prev_key, key))
+    {
+      ++count;
+    }
+
+    prev_key = key;
+  }
+
+  return count;
+}
+
+
+// reduces the n > 0 elements of [values, values + n) by key, starting a new
+// segment at the first element; writes the key of every segment but only
+// the sum of the completed ones, and returns the sum of the last segment
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename Size,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+typename thrust::iterator_value<InputIterator2>::type
+  reduce_by_key_tile(InputIterator1 keys,
+                     InputIterator2 values,
+                     Size n,
+                     OutputIterator1 keys_output,
+                     OutputIterator2 values_output,
+                     BinaryPredicate binary_pred,
+                     const BinaryFunction &binary_op)
+{
+  typedef typename thrust::iterator_traits<InputIterator1>::value_type KeyType;
+  typedef typename thrust::iterator_value<InputIterator2>::type        ValueType;
+
+  KeyType   prev_key = *keys;
+  ValueType sum      = *values;
+
+  *keys_output = prev_key;
+
+  for(Size i = 1; i < n; ++i)
+  {
+    ++keys;
+    ++values;
+
+    KeyType key = *keys;
+
+    if(binary_pred(prev_key, key))
+    {
+      sum = binary_op(sum, *values);
+    }
+    else
+    {
+      *values_output = sum;
+
+      ++keys_output;
+      ++values_output;
+
+      *keys_output = key;
+      sum          = *values;
+    }
+
+    prev_key = key;
+  }
+
+  return sum;
+}
+
+
+// Segmented reduction over the intervals of decomp, without head flags.
+// Every segment is owned by the interval containing its head:
+// 1. in parallel, every interval counts its segment heads,
+// 2. serially, the counts are scanned into output offsets,
+// 3. in parallel, every interval reduces the elements before its first head
+//    into a prefix sum, and the segments it owns into the output, except for
+//    the sum of the last one, which may continue past the interval,
+// 4. serially, the last segment of every interval is completed with the
+//    prefix sums of the intervals it spans.
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename Decomposition>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    reduce_by_key_intervals(execution_policy<DerivedPolicy> &exec,
+                            InputIterator1 keys_first,
+                            InputIterator2 values_first,
+                            OutputIterator1 keys_output,
+                            OutputIterator2 values_output,
+                            BinaryPredicate binary_pred,
+                            BinaryFunction binary_op,
+                            Decomposition decomp)
+{
+  // Use the input iterator's value type per https://wg21.link/P0571
+  typedef typename thrust::iterator_value<InputIterator2>::type ValueType;
+  typedef thrust::detail::intptr_t                               index_type;
+
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  if(num_intervals == 0)
+  {
+    return thrust::make_pair(keys_output, values_output);
+  }
+
+  index_type n = static_cast<index_type>(decomp[num_intervals - 1].end());
+
+  if(num_intervals == 1)
+  {
+    index_type num_segments = reduce_by_key_detail::count_heads(keys_first, index_type(0), n, binary_pred);
+
+    values_output[num_segments - 1] =
+      reduce_by_key_detail::reduce_by_key_tile(keys_first, values_first, n, keys_output, values_output, binary_pred, wrapped_binary_op);
+
+    return thrust::make_pair(keys_output + num_segments, values_output + num_segments);
+  }
+
+  thrust::detail::small_temporary_array<index_type,DerivedPolicy> heads(exec, num_intervals);
+  thrust::detail::small_temporary_array<index_type,DerivedPolicy> offsets(exec, num_intervals + 1);
+  thrust::detail::small_temporary_array<ValueType,DerivedPolicy>  prefixes(exec, num_intervals);
+  thrust::detail::small_temporary_array<ValueType,DerivedPolicy>  suffixes(exec, num_intervals);
+
+  index_type *head   = thrust::raw_pointer_cast(heads.data());
+  index_type *offset = thrust::raw_pointer_cast(offsets.data());
+  ValueType  *prefix = thrust::raw_pointer_cast(prefixes.data());
+  ValueType  *suffix = thrust::raw_pointer_cast(suffixes.data());
+
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_intervals);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    index_type begin = static_cast<index_type>(decomp[i].begin());
+    index_type end   = static_cast<index_type>(decomp[i].end());
+
+    head[i]   = scan_by_key_detail::find_first_head(keys_first, begin, end, binary_pred);
+    offset[i] = reduce_by_key_detail::count_heads(keys_first, head[i], end, binary_pred);
+  }
+
+  index_type num_segments = 0;
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    index_type count = offset[i];
+    offset[i] = num_segments;
+    num_segments += count;
+  }
+  offset[num_intervals] = num_segments;
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    index_type begin = static_cast<index_type>(decomp[i].begin());
+    index_type end   = static_cast<index_type>(decomp[i].end());
+
+    if(begin < head[i])
+    {
+      prefix[i] = scan_by_key_detail::reduce_tile<ValueType>(values_first + begin, head[i] - begin, wrapped_binary_op);
+    }
+
+    if(head[i] < end)
+    {
+      suffix[i] = reduce_by_key_detail::reduce_by_key_tile(keys_first    + head[i],
+                                                           values_first  + head[i],
+                                                           end - head[i],
+                                                           keys_output   + offset[i],
+                                                           values_output + offset[i],
+                                                           binary_pred,
+                                                           wrapped_binary_op);
+    }
+  }
+
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    if(offset[i] == offset[i + 1])
+    {
+      continue;  // this interval owns no segment
+    }
+
+    ValueType sum = suffix[i];
+
+    for(index_type j = i + 1; j < num_intervals; ++j)
+    {
+      if(static_cast<index_type>(decomp[j].begin()) < head[j])
+      {
+        sum = wrapped_binary_op(sum, prefix[j]);
+      }
+
+      if(head[j] < static_cast<index_type>(decomp[j].end()))
+      {
+        break;
+      }
+    }
+
+    values_output[offset[i + 1] - 1] = sum;
+  }
+
+  return thrust::make_pair(keys_output + num_segments, values_output + num_segments);
+}
+
+
+} // end namespace reduce_by_key_detail
+
 
 template <typename DerivedPolicy,
           typename InputIterator1,
@@ -54,8 +299,24 @@ template <typename DerivedPolicy,
                   BinaryPredicate binary_pred,
                   BinaryFunction binary_op)
 {
-  // omp prefers generic::reduce_by_key to cpp::reduce_by_key
-  return thrust::system::detail::generic::reduce_by_key(exec, keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op);
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  difference_type n = thrust::distance(keys_first, keys_last);
+
+  return reduce_by_key_detail::reduce_by_key_intervals(exec, keys_first, values_first, keys_output, values_output, binary_pred, binary_op,
+                                                       thrust::system::omp::detail::default_decomposition(exec, n));
 } // end reduce_by_key()
 
 
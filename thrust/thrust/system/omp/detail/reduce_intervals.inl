@@ -26,9 +26,14 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/function.h>
 #include <thrust/detail/cstdint.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/type_traits/function_traits.h>
+#include <thrust/iterator/detail/contiguous_zip_iterator.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -37,13 +42,95 @@ namespace omp
 {
 namespace detail
 {
+namespace reduce_intervals_detail
+{
+
+
+// reduces the nonempty interval [first, last) in order with a single accumulator
+template<typename OutputType, typename RandomAccessIterator, typename BinaryFunction>
+OutputType reduce_interval(RandomAccessIterator first,
+                           RandomAccessIterator last,
+                           BinaryFunction binary_op,
+                           thrust::detail::false_type)
+{
+  OutputType sum = thrust::raw_reference_cast(*first);
+
+  for(++first; first != last; ++first)
+  {
+    sum = binary_op(sum, *first);
+  }
+
+  return sum;
+}
+
+
+// reduces the nonempty interval [first, last) with several independent
+// accumulators, which breaks the chain of dependent applications of binary_op
+// and leaves the compiler free to vectorize the loop
+// the operands are combined out of order, so binary_op must be commutative
+template<typename OutputType, typename RandomAccessIterator, typename BinaryFunction>
+OutputType reduce_interval(RandomAccessIterator first,
+                           RandomAccessIterator last,
+                           BinaryFunction binary_op,
+                           thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type difference_type;
+
+  // enough independent chains to hide the latency of additions on current
+  // cores, and to fill a vector register of 32-bit operands
+  const int num_accumulators = 8;
+
+  const difference_type n = last - first;
+
+  if(n < 2 * num_accumulators)
+  {
+    return reduce_interval<OutputType>(first, last, binary_op, thrust::detail::false_type());
+  }
+
+  OutputType sums[num_accumulators];
+
+  for(int j = 0; j < num_accumulators; ++j)
+  {
+    sums[j] = first[j];
+  }
+
+  difference_type i = num_accumulators;
+
+  for(; i + num_accumulators <= n; i += num_accumulators)
+  {
+    for(int j = 0; j < num_accumulators; ++j)
+    {
+      sums[j] = binary_op(sums[j], first[i + j]);
+    }
+  }
+
+  for(; i < n; ++i)
+  {
+    sums[0] = binary_op(sums[0], first[i]);
+  }
+
+  // combine the accumulators pairwise
+  for(int width = num_accumulators / 2; width > 0; width /= 2)
+  {
+    for(int j = 0; j < width; ++j)
+    {
+      sums[j] = binary_op(sums[j], sums[j + width]);
+    }
+  }
+
+  return sums[0];
+}
+
+
+} // end reduce_intervals_detail
+
 
 template <typename DerivedPolicy,
           typename InputIterator,
           typename OutputIterator,
           typename BinaryFunction,
           typename Decomposition>
-void reduce_intervals(execution_policy<DerivedPolicy> &,
+void reduce_intervals(execution_policy<DerivedPolicy> &exec,
                       InputIterator input,
                       OutputIterator output,
                       BinaryFunction binary_op,
@@ -69,25 +156,31 @@ void reduce_intervals(execution_policy<DerivedPolicy> &,
 
   typedef thrust::detail::intptr_t index_type;
 
+  // reduce through raw pointers when the input is contiguous, or a zip of contiguous ranges
+  typedef thrust::detail::try_unwrap_zipped_contiguous_iterator_return_t<InputIterator> UnwrappedIterator;
+  UnwrappedIterator unwrapped_input = thrust::detail::try_unwrap_zipped_contiguous_iterator(input);
+
+  // commutative operators on arithmetic types can use several accumulators
+  typedef thrust::detail::integral_constant<
+    bool,
+    thrust::detail::is_commutative<BinaryFunction>::value &&
+    thrust::detail::is_arithmetic<OutputType>::value
+  > use_multiple_accumulators;
+
   index_type n = static_cast<index_type>(decomp.size());
 
-  THRUST_PRAGMA_OMP(parallel for)
+  const int num_threads = thrust::system::omp::detail::team_size(exec, n);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
   for(index_type i = 0; i < n; i++)
   {
-    InputIterator begin = input + decomp[i].begin();
-    InputIterator end   = input + decomp[i].end();
+    UnwrappedIterator begin = unwrapped_input + decomp[i].begin();
+    UnwrappedIterator end   = unwrapped_input + decomp[i].end();
 
     if (begin != end)
     {
-      OutputType sum = thrust::raw_reference_cast(*begin);
-
-      ++begin;
-
-      while (begin != end)
-      {
-        sum = wrapped_binary_op(sum, *begin);
-        ++begin;
-      }
+      OutputType sum =
+        reduce_intervals_detail::reduce_interval<OutputType>(begin, end, wrapped_binary_op, use_multiple_accumulators());
 
       OutputIterator tmp = output + i;
       *tmp = sum;
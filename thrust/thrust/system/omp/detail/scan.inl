@@ -0,0 +1,300 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/scan.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/small_temporary_array.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace scan_detail
+{
+
+
+// scans [first, first + n) into result, continuing from the running sum
+template<typename InputIterator,
+         typename Size,
+         typename OutputIterator,
+         typename ValueType,
+         typename BinaryFunction>
+void inclusive_scan_tile(InputIterator first,
+                         Size n,
+                         OutputIterator result,
+                         ValueType sum,
+                         const BinaryFunction &binary_op)
+{
+  for(Size i = 0; i < n; ++i, ++first, ++result)
+  {
+    *result = sum = binary_op(sum, *first);
+  }
+}
+
+
+template<typename InputIterator,
+         typename Size,
+         typename OutputIterator,
+         typename ValueType,
+         typename BinaryFunction>
+void exclusive_scan_tile(InputIterator first,
+                         Size n,
+                         OutputIterator result,
+                         ValueType sum,
+                         const BinaryFunction &binary_op)
+{
+  for(Size i = 0; i < n; ++i, ++first, ++result)
+  {
+    ValueType tmp = *first;  // temporary value allows in-situ scan
+    *result = sum;
+    sum = binary_op(sum, tmp);
+  }
+}
+
+
+// Two-pass reduce-then-scan over the intervals of decomp:
+// 1. reduce every interval to a partial sum in parallel,
+// 2. scan the partial sums serially, in order, so that non-commutative
+//    operators are honored,
+// 3. scan every interval in parallel, seeded with the carry of its
+//    predecessors.
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename BinaryFunction,
+         typename Decomposition>
+OutputIterator inclusive_scan_intervals(execution_policy<DerivedPolicy> &exec,
+                                        InputIterator first,
+                                        OutputIterator result,
+                                        BinaryFunction binary_op,
+                                        Decomposition decomp)
+{
+  // Use the input iterator's value type per https://wg21.link/P0571
+  typedef typename thrust::iterator_value<InputIterator>::type ValueType;
+  typedef thrust::detail::intptr_t                               index_type;
+
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  if(num_intervals == 0)
+  {
+    return result;
+  }
+
+  index_type n = static_cast<index_type>(decomp[num_intervals - 1].end());
+
+  if(num_intervals == 1)
+  {
+    ValueType sum = *first;
+    *result = sum;
+    scan_detail::inclusive_scan_tile(first + 1, n - 1, result + 1, sum, wrapped_binary_op);
+    return result + n;
+  }
+
+  thrust::detail::small_temporary_array<ValueType,DerivedPolicy> carries(exec, num_intervals);
+
+  thrust::system::omp::detail::reduce_intervals(exec, first, carries.begin(), binary_op, decomp);
+
+  ValueType *carry = thrust::raw_pointer_cast(carries.data());
+
+  for(index_type i = 1; i < num_intervals; ++i)
+  {
+    carry[i] = wrapped_binary_op(carry[i - 1], carry[i]);
+  }
+
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_intervals);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    InputIterator  tile_first  = first  + decomp[i].begin();
+    OutputIterator tile_result = result + decomp[i].begin();
+    index_type     tile_size   = static_cast<index_type>(decomp[i].size());
+
+    if(i == 0)
+    {
+      ValueType sum = *tile_first;
+      *tile_result = sum;
+      scan_detail::inclusive_scan_tile(tile_first + 1, tile_size - 1, tile_result + 1, sum, wrapped_binary_op);
+    }
+    else
+    {
+      scan_detail::inclusive_scan_tile(tile_first, tile_size, tile_result, carry[i - 1], wrapped_binary_op);
+    }
+  }
+
+  return result + n;
+}
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename InitialValueType,
+         typename BinaryFunction,
+         typename Decomposition>
+OutputIterator exclusive_scan_intervals(execution_policy<DerivedPolicy> &exec,
+                                        InputIterator first,
+                                        OutputIterator result,
+                                        InitialValueType init,
+                                        BinaryFunction binary_op,
+                                        Decomposition decomp)
+{
+  // Use the initial value type per https://wg21.link/P0571
+  typedef InitialValueType          ValueType;
+  typedef thrust::detail::intptr_t  index_type;
+
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  if(num_intervals == 0)
+  {
+    return result;
+  }
+
+  index_type n = static_cast<index_type>(decomp[num_intervals - 1].end());
+
+  if(num_intervals == 1)
+  {
+    scan_detail::exclusive_scan_tile(first, n, result, ValueType(init), wrapped_binary_op);
+    return result + n;
+  }
+
+  thrust::detail::small_temporary_array<ValueType,DerivedPolicy> carries(exec, num_intervals);
+
+  thrust::system::omp::detail::reduce_intervals(exec, first, carries.begin(), binary_op, decomp);
+
+  ValueType *carry = thrust::raw_pointer_cast(carries.data());
+
+  ValueType sum = init;
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    ValueType tmp = carry[i];
+    carry[i] = sum;
+    sum = wrapped_binary_op(sum, tmp);
+  }
+
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_intervals);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    scan_detail::exclusive_scan_tile(first  + decomp[i].begin(),
+                                     static_cast<index_type>(decomp[i].size()),
+                                     result + decomp[i].begin(),
+                                     carry[i],
+                                     wrapped_binary_op);
+  }
+
+  return result + n;
+}
+
+
+} // end namespace scan_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  difference_type n = thrust::distance(first, last);
+
+  return scan_detail::inclusive_scan_intervals(exec, first, result, binary_op,
+                                               thrust::system::omp::detail::default_decomposition(exec, n));
+} // end inclusive_scan()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename InitialValueType,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                InitialValueType init,
+                                BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  difference_type n = thrust::distance(first, last);
+
+  return scan_detail::exclusive_scan_intervals(exec, first, result, init, binary_op,
+                                               thrust::system::omp::detail::default_decomposition(exec, n));
+} // end exclusive_scan()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,494 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/scan_by_key.h>
+#include <thrust/system/omp/detail/scan.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/small_temporary_array.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace scan_by_key_detail
+{
+
+
+// returns the position of the first segment head in [begin, end), or end
+// if the whole interval continues the segment open at begin
+template<typename InputIterator,
+         typename Size,
+         typename BinaryPredicate>
+Size find_first_head(InputIterator keys_first,
+                     Size begin,
+                     Size end,
+                     BinaryPredicate binary_pred)
+{
+  typedef typename thrust::iterator_value<InputIterator>::type KeyType;
+
+  if(begin == 0)
+  {
+    return 0;
+  }
+
+  InputIterator keys = keys_first + (begin - 1);
+
+  KeyType prev_key = *keys;
+
+  for(Size i = begin; i < end; ++i)
+  {
+    ++keys;
+
+    KeyType key = *keys;
+
+    if(!binary_pred(prev_key, key))
+    {
+      return i;
+    }
+
+    prev_key = key;
+  }
+
+  return end;
+}
+
+
+// reduces the n > 0 elements of [first, first + n)
+template<typename ValueType,
+         typename InputIterator,
+         typename Size,
+         typename BinaryFunction>
+ValueType reduce_tile(InputIterator first,
+                      Size n,
+                      const BinaryFunction &binary_op)
+{
+  ValueType sum = *first;
+
+  for(Size i = 1; i < n; ++i)
+  {
+    ++first;
+    sum = binary_op(sum, *first);
+  }
+
+  return sum;
+}
+
+
+// scans the n > 0 elements of [values, values + n) by key into result,
+// starting a new segment at the first element, and returns the sum of the
+// last segment
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename Size,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+typename thrust::iterator_traits<InputIterator2>::value_type
+  inclusive_scan_by_key_tile(InputIterator1 keys,
+                             InputIterator2 values,
+                             Size n,
+                             OutputIterator result,
+                             BinaryPredicate binary_pred,
+                             const BinaryFunction &binary_op)
+{
+  typedef typename thrust::iterator_traits<InputIterator1>::value_type KeyType;
+  typedef typename thrust::iterator_traits<InputIterator2>::value_type ValueType;
+
+  KeyType   prev_key = *keys;
+  ValueType sum      = *values;
+
+  *result = sum;
+
+  for(Size i = 1; i < n; ++i)
+  {
+    ++keys;
+    ++values;
+    ++result;
+
+    KeyType key = *keys;
+
+    if(binary_pred(prev_key, key))
+    {
+      sum = binary_op(sum, *values);
+    }
+    else
+    {
+      sum = *values;
+    }
+
+    *result = sum;
+
+    prev_key = key;
+  }
+
+  return sum;
+}
+
+
+// as above, but exclusive; returns the running value after the last element
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename Size,
+         typename OutputIterator,
+         typename ValueType,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+ValueType exclusive_scan_by_key_tile(InputIterator1 keys,
+                                     InputIterator2 values,
+                                     Size n,
+                                     OutputIterator result,
+                                     ValueType init,
+                                     BinaryPredicate binary_pred,
+                                     const BinaryFunction &binary_op)
+{
+  typedef typename thrust::iterator_traits<InputIterator1>::value_type KeyType;
+
+  KeyType   prev_key = *keys;
+  ValueType next     = init;
+
+  for(Size i = 0; i < n; ++i, ++keys, ++values, ++result)
+  {
+    KeyType key = *keys;
+
+    if(i > 0 && !binary_pred(prev_key, key))
+    {
+      next = init;  // reset sum
+    }
+
+    ValueType tmp = *values;  // temporary value allows in-situ scan
+    *result = next;
+    next = binary_op(next, tmp);
+
+    prev_key = key;
+  }
+
+  return next;
+}
+
+
+// Segmented scan over the intervals of decomp, without head flags:
+// 1. in parallel, every interval finds its first segment head,
+// 2. in parallel, every interval scans from that head on and records the sum
+//    of the segment left open at its end,
+// 3. serially, in order, those sums are carried through the intervals that
+//    contain no segment head,
+// 4. in parallel, every interval scans the elements before its first head,
+//    seeded with the carry of its predecessors.
+// Only the elements which continue a segment from a preceding interval are
+// visited twice.
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename Decomposition>
+OutputIterator inclusive_scan_by_key_intervals(execution_policy<DerivedPolicy> &exec,
+                                               InputIterator1 keys_first,
+                                               InputIterator2 values_first,
+                                               OutputIterator result,
+                                               BinaryPredicate binary_pred,
+                                               BinaryFunction binary_op,
+                                               Decomposition decomp)
+{
+  typedef typename thrust::iterator_traits<InputIterator2>::value_type ValueType;
+  typedef thrust::detail::intptr_t                                     index_type;
+
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  if(num_intervals == 0)
+  {
+    return result;
+  }
+
+  index_type n = static_cast<index_type>(decomp[num_intervals - 1].end());
+
+  if(num_intervals == 1)
+  {
+    scan_by_key_detail::inclusive_scan_by_key_tile(keys_first, values_first, n, result, binary_pred, wrapped_binary_op);
+    return result + n;
+  }
+
+  thrust::detail::small_temporary_array<index_type,DerivedPolicy> heads(exec, num_intervals);
+  thrust::detail::small_temporary_array<ValueType,DerivedPolicy>  carries(exec, num_intervals);
+
+  index_type *head  = thrust::raw_pointer_cast(heads.data());
+  ValueType  *carry = thrust::raw_pointer_cast(carries.data());
+
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_intervals);
+
+  // the keys may alias the result, so every head is found before any
+  // interval writes its output
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    head[i] = scan_by_key_detail::find_first_head(keys_first,
+                                                  static_cast<index_type>(decomp[i].begin()),
+                                                  static_cast<index_type>(decomp[i].end()),
+                                                  binary_pred);
+  }
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    index_type begin      = static_cast<index_type>(decomp[i].begin());
+    index_type end        = static_cast<index_type>(decomp[i].end());
+    index_type first_head = head[i];
+
+    if(first_head < end)
+    {
+      carry[i] = scan_by_key_detail::inclusive_scan_by_key_tile(keys_first   + first_head,
+                                                                values_first + first_head,
+                                                                end - first_head,
+                                                                result       + first_head,
+                                                                binary_pred,
+                                                                wrapped_binary_op);
+    }
+    else
+    {
+      carry[i] = scan_by_key_detail::reduce_tile<ValueType>(values_first + begin, end - begin, wrapped_binary_op);
+    }
+  }
+
+  for(index_type i = 1; i < num_intervals; ++i)
+  {
+    if(head[i] == static_cast<index_type>(decomp[i].end()))
+    {
+      carry[i] = wrapped_binary_op(carry[i - 1], carry[i]);
+    }
+  }
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 1; i < num_intervals; ++i)
+  {
+    index_type begin = static_cast<index_type>(decomp[i].begin());
+
+    scan_detail::inclusive_scan_tile(values_first + begin,
+                                     head[i] - begin,
+                                     result + begin,
+                                     carry[i - 1],
+                                     wrapped_binary_op);
+  }
+
+  return result + n;
+}
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename T,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename Decomposition>
+OutputIterator exclusive_scan_by_key_intervals(execution_policy<DerivedPolicy> &exec,
+                                               InputIterator1 keys_first,
+                                               InputIterator2 values_first,
+                                               OutputIterator result,
+                                               T init,
+                                               BinaryPredicate binary_pred,
+                                               BinaryFunction binary_op,
+                                               Decomposition decomp)
+{
+  typedef T                         ValueType;
+  typedef thrust::detail::intptr_t  index_type;
+
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  if(num_intervals == 0)
+  {
+    return result;
+  }
+
+  index_type n = static_cast<index_type>(decomp[num_intervals - 1].end());
+
+  if(num_intervals == 1)
+  {
+    scan_by_key_detail::exclusive_scan_by_key_tile(keys_first, values_first, n, result, ValueType(init), binary_pred, wrapped_binary_op);
+    return result + n;
+  }
+
+  thrust::detail::small_temporary_array<index_type,DerivedPolicy> heads(exec, num_intervals);
+  thrust::detail::small_temporary_array<ValueType,DerivedPolicy>  carries(exec, num_intervals);
+
+  index_type *head  = thrust::raw_pointer_cast(heads.data());
+  ValueType  *carry = thrust::raw_pointer_cast(carries.data());
+
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_intervals);
+
+  // the keys may alias the result, so every head is found before any
+  // interval writes its output
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    head[i] = scan_by_key_detail::find_first_head(keys_first,
+                                                  static_cast<index_type>(decomp[i].begin()),
+                                                  static_cast<index_type>(decomp[i].end()),
+                                                  binary_pred);
+  }
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    index_type begin      = static_cast<index_type>(decomp[i].begin());
+    index_type end        = static_cast<index_type>(decomp[i].end());
+    index_type first_head = head[i];
+
+    if(first_head < end)
+    {
+      carry[i] = scan_by_key_detail::exclusive_scan_by_key_tile(keys_first   + first_head,
+                                                                values_first + first_head,
+                                                                end - first_head,
+                                                                result       + first_head,
+                                                                ValueType(init),
+                                                                binary_pred,
+                                                                wrapped_binary_op);
+    }
+    else
+    {
+      carry[i] = scan_by_key_detail::reduce_tile<ValueType>(values_first + begin, end - begin, wrapped_binary_op);
+    }
+  }
+
+  for(index_type i = 1; i < num_intervals; ++i)
+  {
+    if(head[i] == static_cast<index_type>(decomp[i].end()))
+    {
+      carry[i] = wrapped_binary_op(carry[i - 1], carry[i]);
+    }
+  }
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 1; i < num_intervals; ++i)
+  {
+    index_type begin = static_cast<index_type>(decomp[i].begin());
+
+    scan_detail::exclusive_scan_tile(values_first + begin,
+                                     head[i] - begin,
+                                     result + begin,
+                                     carry[i - 1],
+                                     wrapped_binary_op);
+  }
+
+  return result + n;
+}
+
+
+} // end namespace scan_by_key_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  difference_type n = thrust::distance(first1, last1);
+
+  return scan_by_key_detail::inclusive_scan_by_key_intervals(exec, first1, first2, result, binary_pred, binary_op,
+                                                             thrust::system::omp::detail::default_decomposition(exec, n));
+} // end inclusive_scan_by_key()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename T,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       T init,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  difference_type n = thrust::distance(first1, last1);
+
+  return scan_by_key_detail::exclusive_scan_by_key_intervals(exec, first1, first2, result, init, binary_pred, binary_op,
+                                                             thrust::system::omp::detail::default_decomposition(exec, n));
+} // end exclusive_scan_by_key()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
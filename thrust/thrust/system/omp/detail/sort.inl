@@ -33,11 +33,20 @@
 
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/detail/internal/radix_sort.h>
 #include <thrust/system/detail/generic/select_system.h>
 #include <thrust/sort.h>
 #include <thrust/merge.h>
+#include <thrust/copy.h>
+#include <thrust/extrema.h>
 #include <thrust/detail/seq.h>
+#include <thrust/detail/cstdint.h>
 #include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits.h>
+
+#include <cstddef>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -50,135 +59,446 @@ namespace sort_detail
 {
 
 
+// Merges every pair of adjacent sorted runs of length run_size in
+// [first, first + n) into result. Every interval of decomp is a range of
+// output positions, which may span several pairs of runs; the merge path
+// co-ranks its ends into each pair, so that all intervals do the same
+// amount of work at every level, however few pairs are left.
 template<typename DerivedPolicy,
-         typename RandomAccessIterator,
-         typename StrictWeakOrdering>
-void inplace_merge(execution_policy<DerivedPolicy> &exec,
-                   RandomAccessIterator first,
-                   RandomAccessIterator middle,
-                   RandomAccessIterator last,
-                   StrictWeakOrdering comp)
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering,
+         typename Decomposition>
+void merge_adjacent_runs(execution_policy<DerivedPolicy> &exec,
+                         RandomAccessIterator1 first,
+                         RandomAccessIterator2 result,
+                         StrictWeakOrdering comp,
+                         typename Decomposition::index_type n,
+                         typename Decomposition::index_type run_size,
+                         Decomposition decomp)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+  typedef typename Decomposition::index_type Size;
+  typedef thrust::detail::intptr_t           index_type;
+
+  index_type num_intervals = static_cast<index_type>(decomp.size());
 
-  thrust::detail::temporary_array<value_type,DerivedPolicy> a(exec, first, middle);
-  thrust::detail::temporary_array<value_type,DerivedPolicy> b(exec, middle, last);
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_intervals);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    Size begin = decomp[i].begin();
+    Size end   = decomp[i].end();
 
-  thrust::merge(thrust::seq, a.begin(), a.end(), b.begin(), b.end(), first, comp);
+    while(begin < end)
+    {
+      Size pair_begin = begin - begin % (2 * run_size);
+      Size middle     = thrust::min<Size>(pair_begin + run_size, n);
+      Size pair_end   = thrust::min<Size>(middle + run_size, n);
+      Size stop       = thrust::min<Size>(end, pair_end);
+
+      Size n1 = middle   - pair_begin;
+      Size n2 = pair_end - middle;
+
+      Size diag_begin = begin - pair_begin;
+      Size diag_end   = stop  - pair_begin;
+
+      Size begin1 = thrust::system::detail::internal::merge_path(first + pair_begin, n1, first + middle, n2, diag_begin, comp);
+      Size end1   = thrust::system::detail::internal::merge_path(first + pair_begin, n1, first + middle, n2, diag_end,   comp);
+
+      thrust::merge(thrust::seq,
+                    first + pair_begin + begin1, first + pair_begin + end1,
+                    first + middle + (diag_begin - begin1), first + middle + (diag_end - end1),
+                    result + begin,
+                    comp);
+
+      begin = stop;
+    }
+  }
 }
 
 
 template<typename DerivedPolicy,
          typename RandomAccessIterator1,
          typename RandomAccessIterator2,
-         typename StrictWeakOrdering>
-void inplace_merge_by_key(execution_policy<DerivedPolicy> &exec,
-                          RandomAccessIterator1 first1,
-                          RandomAccessIterator1 middle1,
-                          RandomAccessIterator1 last1,
-                          RandomAccessIterator2 first2,
-                          StrictWeakOrdering comp)
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename StrictWeakOrdering,
+         typename Decomposition>
+void merge_adjacent_runs_by_key(execution_policy<DerivedPolicy> &exec,
+                                RandomAccessIterator1 keys_first,
+                                RandomAccessIterator2 values_first,
+                                RandomAccessIterator3 keys_result,
+                                RandomAccessIterator4 values_result,
+                                StrictWeakOrdering comp,
+                                typename Decomposition::index_type n,
+                                typename Decomposition::index_type run_size,
+                                Decomposition decomp)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator1>::type value_type1;
-  typedef typename thrust::iterator_value<RandomAccessIterator2>::type value_type2;
-
-  RandomAccessIterator2 middle2 = first2 + (middle1 - first1);
-  RandomAccessIterator2 last2   = first2 + (last1   - first1);
-
-  thrust::detail::temporary_array<value_type1,DerivedPolicy> lhs1(exec, first1, middle1);
-  thrust::detail::temporary_array<value_type1,DerivedPolicy> rhs1(exec, middle1, last1);
-  thrust::detail::temporary_array<value_type2,DerivedPolicy> lhs2(exec, first2, middle2);
-  thrust::detail::temporary_array<value_type2,DerivedPolicy> rhs2(exec, middle2, last2);
-
-  thrust::merge_by_key(thrust::seq,
-                       lhs1.begin(), lhs1.end(),
-                       rhs1.begin(), rhs1.end(),
-                       lhs2.begin(), rhs2.begin(),
-                       first1, first2,
-                       comp);
-}
+  typedef typename Decomposition::index_type Size;
+  typedef thrust::detail::intptr_t           index_type;
 
+  index_type num_intervals = static_cast<index_type>(decomp.size());
 
-} // end sort_detail
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_intervals);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    Size begin = decomp[i].begin();
+    Size end   = decomp[i].end();
+
+    while(begin < end)
+    {
+      Size pair_begin = begin - begin % (2 * run_size);
+      Size middle     = thrust::min<Size>(pair_begin + run_size, n);
+      Size pair_end   = thrust::min<Size>(middle + run_size, n);
+      Size stop       = thrust::min<Size>(end, pair_end);
+
+      Size n1 = middle   - pair_begin;
+      Size n2 = pair_end - middle;
+
+      Size diag_begin = begin - pair_begin;
+      Size diag_end   = stop  - pair_begin;
+
+      Size begin1 = thrust::system::detail::internal::merge_path(keys_first + pair_begin, n1, keys_first + middle, n2, diag_begin, comp);
+      Size end1   = thrust::system::detail::internal::merge_path(keys_first + pair_begin, n1, keys_first + middle, n2, diag_end,   comp);
+
+      Size begin2 = diag_begin - begin1;
+      Size end2   = diag_end   - end1;
+
+      thrust::merge_by_key(thrust::seq,
+                           keys_first + pair_begin + begin1, keys_first + pair_begin + end1,
+                           keys_first + middle + begin2, keys_first + middle + end2,
+                           values_first + pair_begin + begin1,
+                           values_first + middle + begin2,
+                           keys_result + begin,
+                           values_result + begin,
+                           comp);
+
+      begin = stop;
+    }
+  }
+}
 
 
+// Every thread sorts a run of ceil(n / p) elements, then adjacent runs are
+// merged pairwise, level by level, with all threads cooperating on every
+// level. The levels alternate between the input and a single temporary
+// buffer.
 template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename StrictWeakOrdering>
 void stable_sort(execution_policy<DerivedPolicy> &exec,
                  RandomAccessIterator first,
                  RandomAccessIterator last,
-                 StrictWeakOrdering comp)
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
 {
-  // we're attempting to launch an omp kernel, assert we're compiling with omp support
-  // ========================================================================
-  // X Note to the user: If you've found this line due to a compiler error, X
-  // X you need to enable OpenMP support in your compiler.                  X
-  // ========================================================================
-  THRUST_STATIC_ASSERT_MSG(
-    (thrust::detail::depend_on_instantiation<
-      RandomAccessIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-    >::value)
-  , "OpenMP compiler support is not enabled"
-  );
-
-  // Avoid issues on compilers that don't provide `omp_get_num_threads()`.
+  // Avoid issues on compilers that don't provide `omp_get_max_threads()`.
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
   typedef typename thrust::iterator_difference<RandomAccessIterator>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      value_type;
+
+  IndexType n = last - first;
 
-  if(first == last)
+  IndexType num_threads = thrust::system::omp::detail::num_threads_for(exec, n);
+
+  if(n <= 1)
     return;
 
-  THRUST_PRAGMA_OMP(parallel)
+  if(num_threads <= 1 || n <= num_threads)
+  {
+    thrust::stable_sort(thrust::seq, first, last, comp);
+    return;
+  }
+
+  IndexType run_size = (n + num_threads - 1) / num_threads;
+  IndexType num_runs = (n + run_size - 1) / run_size;
+
+  // every thread sorts its own run
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(IndexType i = 0; i < num_runs; ++i)
   {
-    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(last - first, 1, omp_get_num_threads());
+    thrust::stable_sort(thrust::seq,
+                        first + i * run_size,
+                        first + thrust::min<IndexType>((i + 1) * run_size, n),
+                        comp);
+  }
+
+  thrust::detail::temporary_array<value_type,DerivedPolicy> buffer(exec, n);
+
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(n, 1, num_threads);
 
-    // process id
-    IndexType p_i = omp_get_thread_num();
+  bool in_buffer = false;
 
-    // every thread sorts its own tile
-    if(p_i < decomp.size())
+  for(; run_size < n; run_size *= 2)
+  {
+    if(in_buffer)
+    {
+      sort_detail::merge_adjacent_runs(exec, buffer.begin(), first, comp, n, run_size, decomp);
+    }
+    else
     {
-      thrust::stable_sort(thrust::seq,
-                          first + decomp[p_i].begin(),
-                          first + decomp[p_i].end(),
-                          comp);
+      sort_detail::merge_adjacent_runs(exec, first, buffer.begin(), comp, n, run_size, decomp);
     }
 
-    THRUST_PRAGMA_OMP(barrier)
+    in_buffer = !in_buffer;
+  }
+
+  if(in_buffer)
+  {
+    thrust::copy(exec, buffer.begin(), buffer.end(), first);
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp,
+                        thrust::detail::false_type)
+{
+  // Avoid issues on compilers that don't provide `omp_get_max_threads()`.
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type      key_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type      value_type;
+
+  IndexType n = keys_last - keys_first;
+
+  IndexType num_threads = thrust::system::omp::detail::num_threads_for(exec, n);
+
+  if(n <= 1)
+    return;
+
+  if(num_threads <= 1 || n <= num_threads)
+  {
+    thrust::stable_sort_by_key(thrust::seq, keys_first, keys_last, values_first, comp);
+    return;
+  }
+
+  IndexType run_size = (n + num_threads - 1) / num_threads;
+  IndexType num_runs = (n + run_size - 1) / run_size;
+
+  // every thread sorts its own run
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(IndexType i = 0; i < num_runs; ++i)
+  {
+    thrust::stable_sort_by_key(thrust::seq,
+                               keys_first + i * run_size,
+                               keys_first + thrust::min<IndexType>((i + 1) * run_size, n),
+                               values_first + i * run_size,
+                               comp);
+  }
 
-    // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
-    ;
+  thrust::detail::temporary_array<key_type,DerivedPolicy>   keys_buffer(exec, n);
+  thrust::detail::temporary_array<value_type,DerivedPolicy> values_buffer(exec, n);
 
-    IndexType nseg = decomp.size();
-    IndexType h = 2;
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(n, 1, num_threads);
 
-    // keep track of which sub-range we're processing
-    IndexType a=p_i, b=p_i, c=p_i+1;
+  bool in_buffer = false;
 
-    while(nseg>1)
+  for(; run_size < n; run_size *= 2)
+  {
+    if(in_buffer)
+    {
+      sort_detail::merge_adjacent_runs_by_key(exec, keys_buffer.begin(), values_buffer.begin(),
+                                              keys_first, values_first,
+                                              comp, n, run_size, decomp);
+    }
+    else
     {
-      if(c >= decomp.size())
-        c = decomp.size() - 1;
+      sort_detail::merge_adjacent_runs_by_key(exec, keys_first, values_first,
+                                              keys_buffer.begin(), values_buffer.begin(),
+                                              comp, n, run_size, decomp);
+    }
 
-      if((p_i % h) == 0 && c > b)
-      {
-        sort_detail::inplace_merge(exec,
-                                   first + decomp[a].begin(),
-                                   first + decomp[b].end(),
-                                   first + decomp[c].end(),
-                                   comp);
+    in_buffer = !in_buffer;
+  }
+
+  if(in_buffer)
+  {
+    thrust::copy(exec, keys_buffer.begin(),   keys_buffer.end(),   keys_first);
+    thrust::copy(exec, values_buffer.begin(), values_buffer.end(), values_first);
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
 
-        b = c;
-        c += h;
-      }
 
-      nseg = (nseg + 1) / 2;
-      h *= 2;
+// Runs one pass of the radix sort of [keys, keys + n), which is split into
+// num_tiles tiles of tile_size keys. Returns false if the pass was skipped
+// because all keys share the same digit.
+template<typename StrictWeakOrdering,
+         typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size>
+bool radix_sort_pass(execution_policy<DerivedPolicy> &exec,
+                     RandomAccessIterator1 keys,
+                     RandomAccessIterator2 keys_result,
+                     Size n,
+                     Size tile_size,
+                     Size num_tiles,
+                     unsigned int pass,
+                     std::size_t *histograms)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type                          KeyType;
+  typedef thrust::system::detail::internal::radix_sort_traits<KeyType,StrictWeakOrdering> traits;
+
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_tiles);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(Size t = 0; t < num_tiles; ++t)
+  {
+    Size begin = t * tile_size;
+
+    thrust::system::detail::internal::radix_histogram<StrictWeakOrdering>(keys + begin,
+                                                                          thrust::min<Size>(tile_size, n - begin),
+                                                                          pass,
+                                                                          histograms + t * traits::num_buckets);
+  }
+
+  if(!thrust::system::detail::internal::radix_offsets(histograms, num_tiles, traits::num_buckets, n))
+  {
+    return false;
+  }
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(Size t = 0; t < num_tiles; ++t)
+  {
+    Size begin = t * tile_size;
+
+    thrust::system::detail::internal::radix_scatter<StrictWeakOrdering>(keys + begin,
+                                                                        thrust::min<Size>(tile_size, n - begin),
+                                                                        pass,
+                                                                        histograms + t * traits::num_buckets,
+                                                                        keys_result);
+  }
+
+  return true;
+}
 
-      THRUST_PRAGMA_OMP(barrier)
+
+template<typename StrictWeakOrdering,
+         typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Size>
+bool radix_sort_by_key_pass(execution_policy<DerivedPolicy> &exec,
+                            RandomAccessIterator1 keys,
+                            RandomAccessIterator2 values,
+                            RandomAccessIterator3 keys_result,
+                            RandomAccessIterator4 values_result,
+                            Size n,
+                            Size tile_size,
+                            Size num_tiles,
+                            unsigned int pass,
+                            std::size_t *histograms)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type                          KeyType;
+  typedef thrust::system::detail::internal::radix_sort_traits<KeyType,StrictWeakOrdering> traits;
+
+  const int num_threads = thrust::system::omp::detail::team_size(exec, num_tiles);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(Size t = 0; t < num_tiles; ++t)
+  {
+    Size begin = t * tile_size;
+
+    thrust::system::detail::internal::radix_histogram<StrictWeakOrdering>(keys + begin,
+                                                                          thrust::min<Size>(tile_size, n - begin),
+                                                                          pass,
+                                                                          histograms + t * traits::num_buckets);
+  }
+
+  if(!thrust::system::detail::internal::radix_offsets(histograms, num_tiles, traits::num_buckets, n))
+  {
+    return false;
+  }
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_threads))
+  for(Size t = 0; t < num_tiles; ++t)
+  {
+    Size begin = t * tile_size;
+
+    thrust::system::detail::internal::radix_scatter_by_key<StrictWeakOrdering>(keys + begin,
+                                                                               values + begin,
+                                                                               thrust::min<Size>(tile_size, n - begin),
+                                                                               pass,
+                                                                               histograms + t * traits::num_buckets,
+                                                                               keys_result,
+                                                                               values_result);
+  }
+
+  return true;
+}
+
+
+// Radix sorts arithmetic keys ordered by less or greater. Every thread owns a
+// tile of ceil(n / p) keys; every pass counts the digits of all tiles in
+// parallel, scans the counts serially and scatters all tiles in parallel.
+// The passes alternate between the input and a single temporary buffer.
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+  // Avoid issues on compilers that don't provide `omp_get_max_threads()`.
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type          IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type               key_type;
+  typedef thrust::system::detail::internal::radix_sort_traits<key_type,StrictWeakOrdering> traits;
+
+  IndexType n = last - first;
+
+  IndexType num_threads = thrust::system::omp::detail::num_threads_for(exec, n);
+
+  // every tile should at least fill its histogram
+  if(num_threads <= 1 || n < num_threads * static_cast<IndexType>(traits::num_buckets))
+  {
+    thrust::stable_sort(thrust::seq, first, last, comp);
+    return;
+  }
+
+  IndexType tile_size = (n + num_threads - 1) / num_threads;
+  IndexType num_tiles = (n + tile_size - 1) / tile_size;
+
+  thrust::detail::temporary_array<key_type,DerivedPolicy>    buffer(exec, n);
+  thrust::detail::temporary_array<std::size_t,DerivedPolicy> histograms(exec, num_tiles * traits::num_buckets);
+
+  std::size_t *histogram = thrust::raw_pointer_cast(histograms.data());
+
+  bool in_buffer = false;
+
+  for(unsigned int pass = 0; pass < traits::num_passes; ++pass)
+  {
+    bool scattered = in_buffer ?
+      sort_detail::radix_sort_pass<StrictWeakOrdering>(exec, buffer.begin(), first, n, tile_size, num_tiles, pass, histogram) :
+      sort_detail::radix_sort_pass<StrictWeakOrdering>(exec, first, buffer.begin(), n, tile_size, num_tiles, pass, histogram);
+
+    if(scattered)
+    {
+      in_buffer = !in_buffer;
     }
   }
+
+  if(in_buffer)
+  {
+    thrust::copy(exec, buffer.begin(), buffer.end(), first);
+  }
 #endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
 }
 
@@ -191,7 +511,73 @@ void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
                         RandomAccessIterator1 keys_first,
                         RandomAccessIterator1 keys_last,
                         RandomAccessIterator2 values_first,
-                        StrictWeakOrdering comp)
+                        StrictWeakOrdering comp,
+                        thrust::detail::true_type)
+{
+  // Avoid issues on compilers that don't provide `omp_get_max_threads()`.
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type         IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type              key_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type              value_type;
+  typedef thrust::system::detail::internal::radix_sort_traits<key_type,StrictWeakOrdering> traits;
+
+  IndexType n = keys_last - keys_first;
+
+  IndexType num_threads = thrust::system::omp::detail::num_threads_for(exec, n);
+
+  // every tile should at least fill its histogram
+  if(num_threads <= 1 || n < num_threads * static_cast<IndexType>(traits::num_buckets))
+  {
+    thrust::stable_sort_by_key(thrust::seq, keys_first, keys_last, values_first, comp);
+    return;
+  }
+
+  IndexType tile_size = (n + num_threads - 1) / num_threads;
+  IndexType num_tiles = (n + tile_size - 1) / tile_size;
+
+  thrust::detail::temporary_array<key_type,DerivedPolicy>    keys_buffer(exec, n);
+  thrust::detail::temporary_array<value_type,DerivedPolicy>  values_buffer(exec, n);
+  thrust::detail::temporary_array<std::size_t,DerivedPolicy> histograms(exec, num_tiles * traits::num_buckets);
+
+  std::size_t *histogram = thrust::raw_pointer_cast(histograms.data());
+
+  bool in_buffer = false;
+
+  for(unsigned int pass = 0; pass < traits::num_passes; ++pass)
+  {
+    bool scattered = in_buffer ?
+      sort_detail::radix_sort_by_key_pass<StrictWeakOrdering>(exec, keys_buffer.begin(), values_buffer.begin(),
+                                                              keys_first, values_first,
+                                                              n, tile_size, num_tiles, pass, histogram) :
+      sort_detail::radix_sort_by_key_pass<StrictWeakOrdering>(exec, keys_first, values_first,
+                                                              keys_buffer.begin(), values_buffer.begin(),
+                                                              n, tile_size, num_tiles, pass, histogram);
+
+    if(scattered)
+    {
+      in_buffer = !in_buffer;
+    }
+  }
+
+  if(in_buffer)
+  {
+    thrust::copy(exec, keys_buffer.begin(),   keys_buffer.end(),   keys_first);
+    thrust::copy(exec, values_buffer.begin(), values_buffer.end(), values_first);
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+
+} // end sort_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp)
 {
   // we're attempting to launch an omp kernel, assert we're compiling with omp support
   // ========================================================================
@@ -200,71 +586,46 @@ void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
   // ========================================================================
   THRUST_STATIC_ASSERT_MSG(
     (thrust::detail::depend_on_instantiation<
-      RandomAccessIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+      RandomAccessIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
     >::value)
   , "OpenMP compiler support is not enabled"
   );
 
-  // Avoid issues on compilers that don't provide `omp_get_num_threads()`.
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
-
-  if(keys_first == keys_last)
-    return;
-
-  THRUST_PRAGMA_OMP(parallel)
-  {
-    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(keys_last - keys_first, 1, omp_get_num_threads());
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
 
-    // process id
-    IndexType p_i = omp_get_thread_num();
+  thrust::system::detail::internal::use_radix_sort<key_type,StrictWeakOrdering> use_radix_sort;
 
-    // every thread sorts its own tile
-    if(p_i < decomp.size())
-    {
-      thrust::stable_sort_by_key(thrust::seq,
-                                 keys_first + decomp[p_i].begin(),
-                                 keys_first + decomp[p_i].end(),
-                                 values_first + decomp[p_i].begin(),
-                                 comp);
-    }
+  sort_detail::stable_sort(exec, first, last, comp, use_radix_sort);
+}
 
-    THRUST_PRAGMA_OMP(barrier)
 
-    // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
-    ;
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      RandomAccessIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
 
-    IndexType nseg = decomp.size();
-    IndexType h = 2;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
 
-    // keep track of which sub-range we're processing
-    IndexType a=p_i, b=p_i, c=p_i+1;
+  thrust::system::detail::internal::use_radix_sort<key_type,StrictWeakOrdering> use_radix_sort;
 
-    while(nseg>1)
-    {
-      if(c >= decomp.size())
-        c = decomp.size() - 1;
-
-      if((p_i % h) == 0 && c > b)
-      {
-        sort_detail::inplace_merge_by_key(exec,
-                                          keys_first + decomp[a].begin(),
-                                          keys_first + decomp[b].end(),
-                                          keys_first + decomp[c].end(),
-                                          values_first + decomp[a].begin(),
-                                          comp);
-
-        b = c;
-        c += h;
-      }
-
-      nseg = (nseg + 1) / 2;
-      h *= 2;
-
-      THRUST_PRAGMA_OMP(barrier)
-    }
-  }
-#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  sort_detail::stable_sort_by_key(exec, keys_first, keys_last, values_first, comp, use_radix_sort);
 }
 
 
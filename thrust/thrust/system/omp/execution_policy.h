@@ -147,6 +147,22 @@ struct tag : thrust::system::omp::execution_policy<tag> { unspecified };
  *
  *  // 0 1 2 is printed to standard output in some unspecified order
  *  \endcode
+ *
+ *  <tt>thrust::omp::par.with(num_threads, schedule, min_elements_per_thread)</tt> returns a policy
+ *  whose algorithms run on at most \p num_threads threads, and give each thread at least
+ *  \p min_elements_per_thread elements. Inputs too small for a second thread run on the calling
+ *  thread. \p schedule, one of \p thrust::omp::schedule_static, \p thrust::omp::schedule_dynamic
+ *  or \p thrust::omp::schedule_guided, selects how elementwise loops such as \p thrust::for_each
+ *  and \p thrust::transform divide their iterations among the threads. A parameter of zero
+ *  selects the default: as many threads as \p omp_get_max_threads() returns, and a few thousand
+ *  elements per thread, except for elementwise loops such as \p thrust::for_each, which divide
+ *  any number of elements among the threads.
+ *
+ *  \code
+ *  // run on at most two threads, and only on one for fewer than 100000 elements
+ *  thrust::for_each(thrust::omp::par.with(2, thrust::omp::schedule_static, 50000),
+ *                   vec.begin(), vec.end(), printf_functor());
+ *  \endcode
  */
 static const unspecified par;
 
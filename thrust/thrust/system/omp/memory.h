@@ -33,6 +33,7 @@
 #include <thrust/memory.h>
 #include <thrust/detail/type_traits.h>
 #include <thrust/mr/allocator.h>
+#include <thrust/detail/allocator/host_system_allocator.h>
 #include <ostream>
 
 THRUST_NAMESPACE_BEGIN
@@ -90,6 +91,15 @@ using universal_allocator = thrust::mr::stateless_resource_allocator<
   T, thrust::system::omp::universal_memory_resource
 >;
 
+/*! \p omp::host_allocator allocates ordinary host memory, like
+ *  \p std::allocator, with raw pointers. Containers using it construct, copy
+ *  and fill their elements in parallel with the \p omp system.
+ */
+template<typename T>
+using host_allocator = thrust::detail::host_system_allocator<
+  T, thrust::system::omp::tag
+>;
+
 }} // namespace system::omp
 
 /*! \namespace thrust::omp
@@ -101,6 +111,7 @@ using thrust::system::omp::malloc;
 using thrust::system::omp::free;
 using thrust::system::omp::allocator;
 using thrust::system::omp::universal_allocator;
+using thrust::system::omp::host_allocator;
 } // namespace omp
 
 THRUST_NAMESPACE_END
@@ -32,6 +32,7 @@
 #endif // no system header
 #include <thrust/system/omp/memory.h>
 #include <thrust/detail/vector_base.h>
+#include <thrust/host_vector.h>
 #include <vector>
 
 THRUST_NAMESPACE_BEGIN
@@ -79,12 +80,29 @@ using vector = thrust::detail::vector_base<T, Allocator>;
 template <typename T, typename Allocator = thrust::system::omp::universal_allocator<T>>
 using universal_vector = thrust::detail::vector_base<T, Allocator>;
 
+/*! \p omp::host_vector is a \p host_vector whose elements reside in
+ *  ordinary host memory, and are constructed, copied and filled in parallel
+ *  with the \p omp system, rather than sequentially. Combined with
+ *  \p default_init, large buffers which are about to be overwritten can be
+ *  allocated without writing to them at all.
+ *
+ *  \tparam T The element type of the \p omp::host_vector.
+ *  \tparam Allocator The allocator type of the \p omp::host_vector.
+ *          Defaults to \p omp::host_allocator.
+ *
+ *  \see host_vector
+ *  \see default_init
+ */
+template <typename T, typename Allocator = thrust::system::omp::host_allocator<T>>
+using host_vector = thrust::host_vector<T, Allocator>;
+
 }} // namespace system::omp
 
 namespace omp
 {
 using thrust::system::omp::vector;
 using thrust::system::omp::universal_vector;
+using thrust::system::omp::host_vector;
 }
 
 THRUST_NAMESPACE_END
@@ -27,6 +27,7 @@
 #endif // no system header
 #include <thrust/detail/function.h>
 #include <thrust/system/tbb/detail/copy_if.h>
+#include <thrust/system/tbb/detail/parallel.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/distance.h>
 #include <tbb/blocked_range.h>
@@ -105,11 +106,12 @@ struct body
 
 } // end copy_if_detail
 
-template<typename InputIterator1,
+template<typename DerivedPolicy,
+         typename InputIterator1,
          typename InputIterator2,
          typename OutputIterator,
          typename Predicate>
-  OutputIterator copy_if(tag,
+  OutputIterator copy_if(execution_policy<DerivedPolicy> &exec,
                          InputIterator1 first,
                          InputIterator1 last,
                          InputIterator2 stencil,
@@ -124,7 +126,7 @@ template<typename InputIterator1,
   if (n != 0)
   {
     Body body(first, stencil, result, pred);
-    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n), body);
+    thrust::system::tbb::detail::parallel_scan(exec, n, body);
     thrust::advance(result, body.sum);
   }
 
@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/find.h>
+#include <thrust/system/tbb/detail/parallel.h>
+#include <thrust/system/detail/sequential/find.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/distance.h>
+#include <thrust/extrema.h>
+
+#include <atomic>
+
+#include <tbb/blocked_range.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace find_detail
+{
+
+
+// lowers result to index, unless it already holds a smaller index
+template<typename Size>
+void atomic_min(std::atomic<Size> &result, Size index)
+{
+  Size current = result.load(std::memory_order_relaxed);
+
+  while(index < current && !result.compare_exchange_weak(current, index, std::memory_order_relaxed))
+  {
+  }
+}
+
+
+template<typename InputIterator, typename Size, typename Predicate>
+  struct body
+{
+  InputIterator first;
+  Size n;
+  Size chunk_size;
+  thrust::detail::wrapped_function<Predicate,bool> pred;
+  std::atomic<Size> &result;
+
+  body(InputIterator first, Size n, Size chunk_size, Predicate pred, std::atomic<Size> &result)
+    : first(first), n(n), chunk_size(chunk_size), pred(pred), result(result)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i != r.end(); ++i)
+    {
+      const Size begin = i * chunk_size;
+
+      // this chunk and the rest of the range lie past a match
+      if(begin >= result.load(std::memory_order_relaxed))
+      {
+        return;
+      }
+
+      const Size end = thrust::min<Size>(begin + chunk_size, n);
+
+      InputIterator iter = first + begin;
+
+      for(Size j = begin; j < end; ++j, ++iter)
+      {
+        if(pred(*iter))
+        {
+          atomic_min(result, j);
+          return;
+        }
+      }
+    }
+  }
+}; // end body
+
+
+template<typename InputIterator, typename Size, typename Predicate>
+  body<InputIterator,Size,Predicate>
+    make_body(InputIterator first, Size n, Size chunk_size, Predicate pred, std::atomic<Size> &result)
+{
+  return body<InputIterator,Size,Predicate>(first, n, chunk_size, pred, result);
+}
+
+
+} // end find_detail
+
+
+template <typename DerivedPolicy, typename InputIterator, typename Predicate>
+InputIterator find_if(execution_policy<DerivedPolicy> &exec,
+                      InputIterator first,
+                      InputIterator last,
+                      Predicate pred)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type Size;
+
+  const Size n = thrust::distance(first, last);
+
+  // the number of elements searched between checks for a match found by
+  // another thread: checks stay rare, yet the search stops soon after a match
+  const Size chunk_size = 1 << 14;
+
+  // small inputs aren't worth any tasks
+  if(n <= chunk_size)
+  {
+    return thrust::system::detail::sequential::find_if(exec, first, last, pred);
+  }
+
+  const Size num_chunks = (n + chunk_size - 1) / chunk_size;
+
+  // the smallest index found so far to satisfy pred
+  std::atomic<Size> result(n);
+
+  thrust::system::tbb::detail::parallel_for_tasks(exec, num_chunks,
+    find_detail::make_body(first, n, chunk_size, pred, result));
+
+  return first + result.load();
+}
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -28,11 +28,12 @@
 #include <thrust/detail/static_assert.h>
 #include <thrust/distance.h>
 #include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/detail/contiguous_zip_iterator.h>
 #include <thrust/distance.h>
 #include <thrust/system/detail/sequential/execution_policy.h>
+#include <thrust/system/tbb/detail/parallel.h>
 
 #include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -79,12 +80,15 @@ template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename Size,
          typename UnaryFunction>
-RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
+RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &exec,
                                 RandomAccessIterator first,
                                 Size n,
                                 UnaryFunction f)
 {
-  ::tbb::parallel_for(::tbb::blocked_range<Size>(0,n), for_each_detail::make_body<Size>(first,f));
+  if (n <= 0) return first;  //empty range
+
+  // the bodies loop through raw pointers where the range is contiguous, or a zip of contiguous ranges
+  thrust::system::tbb::detail::parallel_for(exec, n, for_each_detail::make_body<Size>(thrust::detail::try_unwrap_zipped_contiguous_iterator(first), f));
 
   // return the end of the range
   return first + n;
@@ -27,22 +27,256 @@
 #endif // no system header
 #include <thrust/detail/allocator_aware_execution_policy.h>
 #include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/detail/execution_policy.h>
+
+#include <cstddef>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
 {
 namespace tbb
 {
+
+
+// how a loop over elements splits its range into tasks
+enum partitioner_kind
+{
+  partition_auto,
+  partition_affinity,
+  partition_static
+};
+
+
 namespace detail
 {
 
 
+// The partitioner types of TBB. They're defined only where the algorithms
+// include TBB, so that this header doesn't need TBB's headers.
+template<typename Dummy>
+struct tbb_partitioners;
+
+
+// A reference to a task arena. The arena's type is only known to the function
+// which enters it, so that any type with tbb::task_arena's execute can be used.
+class arena_ref
+{
+private:
+  void *m_arena;
+  void (*m_execute)(void *arena, void (*f)(void *), void *f_state);
+
+  template<typename TaskArena>
+  static void execute_in(void *arena, void (*f)(void *), void *f_state)
+  {
+    static_cast<TaskArena *>(arena)->execute([=] { f(f_state); });
+  }
+
+  template<typename Function>
+  static void call(void *f)
+  {
+    (*static_cast<Function *>(f))();
+  }
+
+public:
+  _CCCL_HOST_DEVICE
+  constexpr arena_ref() : m_arena(nullptr), m_execute(nullptr) {}
+
+  template<typename TaskArena>
+  explicit arena_ref(TaskArena &arena)
+    : m_arena(&arena), m_execute(&execute_in<TaskArena>)
+  {}
+
+  // runs f() in the arena, or in the calling thread's arena if none is referenced
+  template<typename Function>
+  void execute(Function &f) const
+  {
+    if(m_arena == nullptr)
+    {
+      f();
+    }
+    else
+    {
+      m_execute(m_arena, &call<Function>, &f);
+    }
+  }
+};
+
+
+// A TBB policy which carries tuning parameters to the algorithms. A
+// parameter left at zero selects the algorithm's own default.
+template<typename Derived>
+struct execute_with_parameters_base : thrust::system::tbb::detail::execution_policy<Derived>
+{
+private:
+  std::size_t sort_threshold;
+  arena_ref arena;
+  partitioner_kind partitioner;
+  void *affinity_state;
+  std::size_t grain_size;
+
+public:
+  _CCCL_HOST_DEVICE
+  constexpr execute_with_parameters_base(std::size_t sort_threshold_ = 0)
+    : sort_threshold(sort_threshold_),
+      arena(),
+      partitioner(partition_auto),
+      affinity_state(nullptr),
+      grain_size(0)
+  {}
+
+  // sequences shorter than n elements are sorted sequentially
+  Derived with_sort_threshold(std::size_t n) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.sort_threshold = n;
+    return result;
+  }
+
+  // algorithms run their tasks in task_arena rather than in the calling
+  // thread's arena
+  template<typename TaskArena>
+  Derived on(TaskArena &task_arena) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.arena = arena_ref(task_arena);
+    return result;
+  }
+
+  // loops over elements split their ranges with the given partitioner
+  Derived with_partitioner(partitioner_kind kind) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.partitioner = kind;
+    result.affinity_state = nullptr;
+    return result;
+  }
+
+  // loops over elements split their ranges with an affinity partitioner
+  // whose state outlives the call, so that repeated calls on the same data
+  // replay the same assignment of tasks to threads
+  template<typename Dummy = void>
+  Derived with_affinity(typename tbb_partitioners<Dummy>::affinity_partitioner &state) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.partitioner = partition_affinity;
+    result.affinity_state = &state;
+    return result;
+  }
+
+  // loops over elements don't split ranges of n or fewer elements
+  Derived with_grain_size(std::size_t n) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.grain_size = n;
+    return result;
+  }
+
+private:
+  friend std::size_t get_sort_threshold(const execute_with_parameters_base &exec)
+  {
+    return exec.sort_threshold;
+  }
+
+  friend const arena_ref &get_arena(const execute_with_parameters_base &exec)
+  {
+    return exec.arena;
+  }
+
+  friend partitioner_kind get_partitioner(const execute_with_parameters_base &exec)
+  {
+    return exec.partitioner;
+  }
+
+  friend void *get_affinity_state(const execute_with_parameters_base &exec)
+  {
+    return exec.affinity_state;
+  }
+
+  friend std::size_t get_grain_size(const execute_with_parameters_base &exec)
+  {
+    return exec.grain_size;
+  }
+};
+
+
+// policies without parameters select every default
+template<typename Derived>
+std::size_t get_sort_threshold(const thrust::system::tbb::detail::execution_policy<Derived> &)
+{
+  return 0;
+}
+
+
+template<typename Derived>
+arena_ref get_arena(const thrust::system::tbb::detail::execution_policy<Derived> &)
+{
+  return arena_ref();
+}
+
+
+template<typename Derived>
+partitioner_kind get_partitioner(const thrust::system::tbb::detail::execution_policy<Derived> &)
+{
+  return partition_auto;
+}
+
+
+template<typename Derived>
+void *get_affinity_state(const thrust::system::tbb::detail::execution_policy<Derived> &)
+{
+  return nullptr;
+}
+
+
+template<typename Derived>
+std::size_t get_grain_size(const thrust::system::tbb::detail::execution_policy<Derived> &)
+{
+  return 0;
+}
+
+
+struct execute_with_parameters : execute_with_parameters_base<execute_with_parameters>
+{
+  typedef execute_with_parameters_base<execute_with_parameters> base_t;
+
+  _CCCL_HOST_DEVICE
+  constexpr execute_with_parameters() : base_t() {}
+};
+
+
 struct par_t : thrust::system::tbb::detail::execution_policy<par_t>,
   thrust::detail::allocator_aware_execution_policy<
-    thrust::system::tbb::detail::execution_policy>
+    execute_with_parameters_base>
 {
   _CCCL_HOST_DEVICE
   constexpr par_t() : thrust::system::tbb::detail::execution_policy<par_t>() {}
+
+  execute_with_parameters with_sort_threshold(std::size_t n) const
+  {
+    return execute_with_parameters().with_sort_threshold(n);
+  }
+
+  template<typename TaskArena>
+  execute_with_parameters on(TaskArena &task_arena) const
+  {
+    return execute_with_parameters().on(task_arena);
+  }
+
+  execute_with_parameters with_partitioner(partitioner_kind kind) const
+  {
+    return execute_with_parameters().with_partitioner(kind);
+  }
+
+  template<typename Dummy = void>
+  execute_with_parameters with_affinity(typename tbb_partitioners<Dummy>::affinity_partitioner &state) const
+  {
+    return execute_with_parameters().with_affinity(state);
+  }
+
+  execute_with_parameters with_grain_size(std::size_t n) const
+  {
+    return execute_with_parameters().with_grain_size(n);
+  }
 };
 
 
@@ -62,6 +296,10 @@ namespace tbb
 
 
 using thrust::system::tbb::par;
+using thrust::system::tbb::partitioner_kind;
+using thrust::system::tbb::partition_auto;
+using thrust::system::tbb::partition_affinity;
+using thrust::system::tbb::partition_static;
 
 
 } // end tbb
@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/tbb/detail/par.h>
+#include <thrust/detail/execution_policy.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_scan.h>
+#include <tbb/partitioner.h>
+
+#include <cstddef>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+template<typename Dummy>
+struct tbb_partitioners
+{
+  typedef ::tbb::affinity_partitioner affinity_partitioner;
+};
+
+
+// The algorithms launch their TBB loops through these functions, which apply
+// the parameters of exec: the arena the loop runs in, and for loops over
+// elements, the partitioner and grain size.
+
+
+// runs f() in the arena exec is bound to
+template<typename DerivedPolicy, typename Function>
+void execute(execution_policy<DerivedPolicy> &exec, Function f)
+{
+  get_arena(thrust::detail::derived_cast(exec)).execute(f);
+}
+
+
+// the range of a loop over n elements under exec
+template<typename DerivedPolicy, typename Size>
+::tbb::blocked_range<Size> element_range(execution_policy<DerivedPolicy> &exec, Size n)
+{
+  std::size_t grain_size = get_grain_size(thrust::detail::derived_cast(exec));
+
+  return ::tbb::blocked_range<Size>(0, n, grain_size > 0 ? static_cast<Size>(grain_size) : Size(1));
+}
+
+
+// runs body over the elements [0, n)
+template<typename DerivedPolicy, typename Size, typename Body>
+void parallel_for(execution_policy<DerivedPolicy> &exec, Size n, const Body &body)
+{
+  const ::tbb::blocked_range<Size> range = element_range(exec, n);
+
+  partitioner_kind kind = get_partitioner(thrust::detail::derived_cast(exec));
+  ::tbb::affinity_partitioner *state =
+    static_cast<::tbb::affinity_partitioner *>(get_affinity_state(thrust::detail::derived_cast(exec)));
+
+  execute(exec, [&] {
+    if(kind == partition_static)
+    {
+      ::tbb::parallel_for(range, body, ::tbb::static_partitioner());
+    }
+    else if(kind == partition_affinity && state != nullptr)
+    {
+      ::tbb::parallel_for(range, body, *state);
+    }
+    else if(kind == partition_affinity)
+    {
+      ::tbb::affinity_partitioner partitioner;
+      ::tbb::parallel_for(range, body, partitioner);
+    }
+    else
+    {
+      ::tbb::parallel_for(range, body, ::tbb::auto_partitioner());
+    }
+  });
+}
+
+
+// reduces the elements [0, n) into body
+template<typename DerivedPolicy, typename Size, typename Body>
+void parallel_reduce(execution_policy<DerivedPolicy> &exec, Size n, Body &body)
+{
+  const ::tbb::blocked_range<Size> range = element_range(exec, n);
+
+  partitioner_kind kind = get_partitioner(thrust::detail::derived_cast(exec));
+  ::tbb::affinity_partitioner *state =
+    static_cast<::tbb::affinity_partitioner *>(get_affinity_state(thrust::detail::derived_cast(exec)));
+
+  execute(exec, [&] {
+    if(kind == partition_static)
+    {
+      ::tbb::parallel_reduce(range, body, ::tbb::static_partitioner());
+    }
+    else if(kind == partition_affinity && state != nullptr)
+    {
+      ::tbb::parallel_reduce(range, body, *state);
+    }
+    else if(kind == partition_affinity)
+    {
+      ::tbb::affinity_partitioner partitioner;
+      ::tbb::parallel_reduce(range, body, partitioner);
+    }
+    else
+    {
+      ::tbb::parallel_reduce(range, body, ::tbb::auto_partitioner());
+    }
+  });
+}
+
+
+// scans the elements [0, n) with body
+// parallel_scan accepts only the auto and simple partitioners, so scans
+// ignore the partitioner of exec
+template<typename DerivedPolicy, typename Size, typename Body>
+void parallel_scan(execution_policy<DerivedPolicy> &exec, Size n, Body &body)
+{
+  const ::tbb::blocked_range<Size> range = element_range(exec, n);
+
+  execute(exec, [&] {
+    ::tbb::parallel_scan(range, body, ::tbb::auto_partitioner());
+  });
+}
+
+
+// runs body over the tasks [0, num_tasks), one task per index
+template<typename DerivedPolicy, typename Size, typename Body>
+void parallel_for_tasks(execution_policy<DerivedPolicy> &exec, Size num_tasks, const Body &body)
+{
+  execute(exec, [&] {
+    ::tbb::parallel_for(::tbb::blocked_range<Size>(0, num_tasks, 1), body, ::tbb::simple_partitioner());
+  });
+}
+
+
+} // end detail
+} // end tbb
+} // end system
+THRUST_NAMESPACE_END
+
@@ -27,6 +27,12 @@
 #endif // no system header
 #include <thrust/system/tbb/detail/partition.h>
 #include <thrust/system/detail/generic/partition.h>
+#include <thrust/detail/function.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/advance.h>
+#include <thrust/system/tbb/detail/parallel.h>
+#include <tbb/blocked_range.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -35,6 +41,81 @@ namespace tbb
 {
 namespace detail
 {
+namespace partition_detail
+{
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename Predicate,
+         typename Size>
+struct body
+{
+
+  InputIterator1 first;
+  InputIterator2 stencil;
+  OutputIterator1 out_true;
+  OutputIterator2 out_false;
+  thrust::detail::wrapped_function<Predicate,bool> pred;
+  Size sum;
+
+  body(InputIterator1 first, InputIterator2 stencil, OutputIterator1 out_true, OutputIterator2 out_false, Predicate pred)
+    : first(first), stencil(stencil), out_true(out_true), out_false(out_false), pred(pred), sum(0)
+  {}
+
+  body(body& b, ::tbb::split)
+    : first(b.first), stencil(b.stencil), out_true(b.out_true), out_false(b.out_false), pred(b.pred), sum(0)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::pre_scan_tag)
+  {
+    InputIterator2 iter = stencil + r.begin();
+
+    for (Size i = r.begin(); i != r.end(); ++i, ++iter)
+    {
+      if (pred(*iter))
+        ++sum;
+    }
+  }
+
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::final_scan_tag)
+  {
+    // sum counts the true elements before r, so every other element
+    // before r belongs to the false partition
+    InputIterator1  iter1 = first     + r.begin();
+    InputIterator2  iter2 = stencil   + r.begin();
+    OutputIterator1 iter3 = out_true  + sum;
+    OutputIterator2 iter4 = out_false + (r.begin() - sum);
+
+    for (Size i = r.begin(); i != r.end(); ++i, ++iter1, ++iter2)
+    {
+      if (pred(*iter2))
+      {
+        *iter3 = *iter1;
+        ++sum;
+        ++iter3;
+      }
+      else
+      {
+        *iter4 = *iter1;
+        ++iter4;
+      }
+    }
+  }
+
+  void reverse_join(body& b)
+  {
+    sum = b.sum + sum;
+  }
+
+  void assign(body& b)
+  {
+    sum = b.sum;
+  }
+}; // end body
+
+} // end partition_detail
 
 
 template<typename DerivedPolicy,
@@ -77,8 +158,7 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // tbb prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, out_true, out_false, pred);
+  return tbb::detail::stable_partition_copy(exec, first, last, first, out_true, out_false, pred);
 } // end stable_partition_copy()
 
 
@@ -97,8 +177,20 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // tbb prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, stencil, out_true, out_false, pred);
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+  typedef typename partition_detail::body<InputIterator1,InputIterator2,OutputIterator1,OutputIterator2,Predicate,Size> Body;
+
+  Size n = thrust::distance(first, last);
+
+  if (n != 0)
+  {
+    Body body(first, stencil, out_true, out_false, pred);
+    thrust::system::tbb::detail::parallel_scan(exec, n, body);
+    thrust::advance(out_true, body.sum);
+    thrust::advance(out_false, n - body.sum);
+  }
+
+  return thrust::make_pair(out_true, out_false);
 } // end stable_partition_copy()
 
 
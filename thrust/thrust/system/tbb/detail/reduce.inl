@@ -29,10 +29,11 @@
 #include <thrust/detail/function.h>
 #include <thrust/detail/static_assert.h>
 #include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/detail/contiguous_zip_iterator.h>
 #include <thrust/distance.h>
 #include <thrust/reduce.h>
+#include <thrust/system/tbb/detail/parallel.h>
 #include <tbb/blocked_range.h>
-#include <tbb/parallel_reduce.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -107,7 +108,7 @@ template<typename DerivedPolicy,
          typename InputIterator,
          typename OutputType,
          typename BinaryFunction>
-  OutputType reduce(execution_policy<DerivedPolicy> &,
+  OutputType reduce(execution_policy<DerivedPolicy> &exec,
                     InputIterator begin,
                     InputIterator end,
                     OutputType init,
@@ -123,9 +124,11 @@ template<typename DerivedPolicy,
   }
   else
   {
-    typedef typename reduce_detail::body<InputIterator,OutputType,BinaryFunction> Body;
-    Body reduce_body(begin, init, binary_op);
-    ::tbb::parallel_reduce(::tbb::blocked_range<Size>(0,n), reduce_body);
+    // the bodies reduce through raw pointers when the input is contiguous, or a zip of contiguous ranges
+    typedef thrust::detail::try_unwrap_zipped_contiguous_iterator_return_t<InputIterator> UnwrappedIterator;
+    typedef typename reduce_detail::body<UnwrappedIterator,OutputType,BinaryFunction> Body;
+    Body reduce_body(thrust::detail::try_unwrap_zipped_contiguous_iterator(begin), init, binary_op);
+    thrust::system::tbb::detail::parallel_reduce(exec, n, reduce_body);
     return binary_op(init, reduce_body.sum);
   }
 }
@@ -30,11 +30,11 @@
 #include <thrust/detail/seq.h>
 #include <thrust/system/tbb/detail/execution_policy.h>
 #include <thrust/system/tbb/detail/reduce_intervals.h>
+#include <thrust/system/tbb/detail/parallel.h>
 #include <thrust/detail/minmax.h>
-#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/small_temporary_array.h>
 #include <thrust/detail/range/tail_flags.h>
 #include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
 
 #include <cassert>
 #include <thread>
@@ -299,7 +299,7 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
 
   // decompose the input into intervals of size N / num_intervals
   // add one extra element to this vector to store the size of the entire result
-  thrust::detail::temporary_array<difference_type, DerivedPolicy> interval_output_offsets(0, exec, num_intervals + 1);
+  thrust::detail::small_temporary_array<difference_type, DerivedPolicy> interval_output_offsets(0, exec, num_intervals + 1);
 
   // first count the number of tail flags in each interval
   thrust::detail::tail_flags<Iterator1,BinaryPredicate> tail_flags = thrust::detail::make_tail_flags(keys_first, keys_last, binary_pred);
@@ -314,19 +314,17 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
   // do a reduce_by_key serially in each thread
   // the final interval never has a carry by definition, so don't reserve space for it
   typedef typename reduce_by_key_detail::partial_sum_type<Iterator2,BinaryFunction>::type carry_type;
-  thrust::detail::temporary_array<carry_type, DerivedPolicy> carries(0, exec, num_intervals - 1);
+  thrust::detail::small_temporary_array<carry_type, DerivedPolicy> carries(0, exec, num_intervals - 1);
 
-  // force grainsize == 1 with simple_partioner()
-  ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_intervals, 1),
-    reduce_by_key_detail::make_serial_reduce_by_key_body(keys_first, values_first, interval_output_offsets.begin(), keys_result, values_result, carries.begin(), n, interval_size, num_intervals, binary_pred, binary_op),
-    ::tbb::simple_partitioner());
+  thrust::system::tbb::detail::parallel_for_tasks(exec, num_intervals,
+    reduce_by_key_detail::make_serial_reduce_by_key_body(keys_first, values_first, interval_output_offsets.begin(), keys_result, values_result, carries.begin(), n, interval_size, num_intervals, binary_pred, binary_op));
 
   difference_type size_of_result = interval_output_offsets[num_intervals];
 
   // sequentially accumulate the carries
   // note that the last interval does not have a carry
   // XXX find a way to express this loop via a sequential algorithm, perhaps reduce_by_key
-  for(typename thrust::detail::temporary_array<carry_type,DerivedPolicy>::size_type i = 0; i < carries.size(); ++i)
+  for(typename thrust::detail::small_temporary_array<carry_type, DerivedPolicy>::size_type i = 0; i < carries.size(); ++i)
   {
     // if our interval has a carry, then we need to sum the carry to the next interval's output offset
     // if it does not have a carry, then we need to ignore carry_value[i]
@@ -26,9 +26,9 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/tbb/detail/parallel.h>
 #include <thrust/detail/seq.h>
 
-#include <tbb/parallel_for.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/minmax.h>
 #include <thrust/system/cpp/memory.h>
@@ -97,7 +97,7 @@ template<typename RandomAccessIterator1, typename RandomAccessIterator2, typenam
 
 
 template<typename DerivedPolicy, typename RandomAccessIterator1, typename Size, typename RandomAccessIterator2, typename BinaryFunction>
-  void reduce_intervals(thrust::tbb::execution_policy<DerivedPolicy> &,
+  void reduce_intervals(thrust::tbb::execution_policy<DerivedPolicy> &exec,
                         RandomAccessIterator1 first,
                         RandomAccessIterator1 last,
                         Size interval_size,
@@ -108,7 +108,8 @@ template<typename DerivedPolicy, typename RandomAccessIterator1, typename Size,
 
   Size num_intervals = reduce_intervals_detail::divide_ri(n, interval_size);
 
-  ::tbb::parallel_for(::tbb::blocked_range<Size>(0, num_intervals, 1), reduce_intervals_detail::make_body(first, result, Size(n), interval_size, binary_op), ::tbb::simple_partitioner());
+  thrust::system::tbb::detail::parallel_for_tasks(exec, num_intervals,
+    reduce_intervals_detail::make_body(first, result, Size(n), interval_size, binary_op));
 }
 
 
@@ -0,0 +1,272 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/set_operations.h>
+#include <thrust/system/tbb/detail/parallel.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/detail/internal/set_operations.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/pair.h>
+#include <thrust/detail/minmax.h>
+#include <thrust/detail/small_temporary_array.h>
+#include <tbb/blocked_range.h>
+
+#include <cassert>
+#include <thread>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace set_operations_detail
+{
+
+
+template<typename L, typename R>
+  inline L divide_ri(const L x, const R y)
+{
+  return (x + (y - 1)) / y;
+}
+
+
+// Every interval of merged output positions is moved onto boundaries
+// between runs of equivalent elements with balanced_path, so the set
+// operation on the pieces of an interval can be evaluated on its own.
+// When Counting is true, the body records the size of every interval's
+// output; otherwise it writes the output at the scanned offsets.
+template<bool Counting,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename OutputIterator,
+         typename Size,
+         typename StrictWeakOrdering,
+         typename SetOperation>
+  struct body
+{
+  RandomAccessIterator1 first1;
+  RandomAccessIterator2 first2;
+  OutputIterator result;
+  Size *offsets;
+  Size n1, n2, interval_size;
+  StrictWeakOrdering comp;
+  SetOperation set_op;
+
+  body(RandomAccessIterator1 first1, RandomAccessIterator2 first2, OutputIterator result, Size *offsets, Size n1, Size n2, Size interval_size, StrictWeakOrdering comp, SetOperation set_op)
+    : first1(first1), first2(first2), result(result), offsets(offsets),
+      n1(n1), n2(n2), interval_size(interval_size),
+      comp(comp), set_op(set_op)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    assert(r.size() == 1);
+
+    using thrust::system::detail::internal::balanced_path;
+
+    const Size interval_idx = r.begin();
+
+    const Size diag_begin = (thrust::min)(n1 + n2, interval_size * interval_idx);
+    const Size diag_end   = (thrust::min)(n1 + n2, diag_begin + interval_size);
+
+    thrust::pair<Size,Size> begin = balanced_path(first1, n1, first2, n2, diag_begin, comp);
+    thrust::pair<Size,Size> end   = balanced_path(first1, n1, first2, n2, diag_end,   comp);
+
+    if(Counting)
+    {
+      thrust::discard_iterator<> discard;
+
+      offsets[interval_idx] = set_op(first1 + begin.first, first1 + end.first,
+                                     first2 + begin.second, first2 + end.second,
+                                     discard,
+                                     comp) - discard;
+    }
+    else
+    {
+      set_op(first1 + begin.first, first1 + end.first,
+             first2 + begin.second, first2 + end.second,
+             result + offsets[interval_idx],
+             comp);
+    }
+  }
+};
+
+
+template<bool Counting, typename RandomAccessIterator1, typename RandomAccessIterator2, typename OutputIterator, typename Size, typename StrictWeakOrdering, typename SetOperation>
+  body<Counting,RandomAccessIterator1,RandomAccessIterator2,OutputIterator,Size,StrictWeakOrdering,SetOperation>
+    make_body(RandomAccessIterator1 first1, RandomAccessIterator2 first2, OutputIterator result, Size *offsets, Size n1, Size n2, Size interval_size, StrictWeakOrdering comp, SetOperation set_op)
+{
+  return body<Counting,RandomAccessIterator1,RandomAccessIterator2,OutputIterator,Size,StrictWeakOrdering,SetOperation>(first1, first2, result, offsets, n1, n2, interval_size, comp, set_op);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering,
+         typename SetOperation>
+  OutputIterator set_operation(execution_policy<DerivedPolicy> &exec,
+                               RandomAccessIterator1 first1,
+                               RandomAccessIterator1 last1,
+                               RandomAccessIterator2 first2,
+                               RandomAccessIterator2 last2,
+                               OutputIterator result,
+                               StrictWeakOrdering comp,
+                               SetOperation set_op)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference_type;
+
+  difference_type n1 = thrust::distance(first1, last1);
+  difference_type n2 = thrust::distance(first2, last2);
+
+  // below this many elements, spawning tasks costs more than the operation itself
+  const difference_type parallelism_threshold = 10000;
+
+  if(n1 + n2 < parallelism_threshold)
+  {
+    // don't bother parallelizing for small n
+    return set_op(first1, last1, first2, last2, result, comp);
+  }
+
+  // count the number of processors
+  const unsigned int p = thrust::max<unsigned int>(1u, std::thread::hardware_concurrency());
+
+  // generate O(P) intervals of sequential work
+  // several intervals per processor, so that work stealing evens out uneven intervals
+  const unsigned int subscription_rate = 4;
+  difference_type num_intervals = thrust::min<difference_type>(subscription_rate * p, divide_ri(n1 + n2, parallelism_threshold));
+  difference_type interval_size = divide_ri(n1 + n2, num_intervals);
+
+  thrust::detail::small_temporary_array<difference_type, DerivedPolicy> offsets(exec, num_intervals);
+  difference_type *offset = thrust::raw_pointer_cast(offsets.data());
+
+  // first count the output of each interval
+  thrust::system::tbb::detail::parallel_for_tasks(exec, num_intervals,
+    make_body<true>(first1, first2, result, offset, n1, n2, interval_size, comp, set_op));
+
+  // scan the counts to get each body's output offset
+  difference_type size_of_result = 0;
+  for(difference_type i = 0; i < num_intervals; ++i)
+  {
+    difference_type count = offset[i];
+    offset[i] = size_of_result;
+    size_of_result += count;
+  }
+
+  // write the output of each interval
+  thrust::system::tbb::detail::parallel_for_tasks(exec, num_intervals,
+    make_body<false>(first1, first2, result, offset, n1, n2, interval_size, comp, set_op));
+
+  return result + size_of_result;
+}
+
+
+} // end namespace set_operations_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_difference(execution_policy<DerivedPolicy> &exec,
+                                InputIterator1 first1,
+                                InputIterator1 last1,
+                                InputIterator2 first2,
+                                InputIterator2 last2,
+                                OutputIterator result,
+                                StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp,
+                                              thrust::system::detail::internal::set_difference_functor());
+} // end set_difference()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_intersection(execution_policy<DerivedPolicy> &exec,
+                                  InputIterator1 first1,
+                                  InputIterator1 last1,
+                                  InputIterator2 first2,
+                                  InputIterator2 last2,
+                                  OutputIterator result,
+                                  StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp,
+                                              thrust::system::detail::internal::set_intersection_functor());
+} // end set_intersection()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_symmetric_difference(execution_policy<DerivedPolicy> &exec,
+                                          InputIterator1 first1,
+                                          InputIterator1 last1,
+                                          InputIterator2 first2,
+                                          InputIterator2 last2,
+                                          OutputIterator result,
+                                          StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp,
+                                              thrust::system::detail::internal::set_symmetric_difference_functor());
+} // end set_symmetric_difference()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_union(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 first1,
+                           InputIterator1 last1,
+                           InputIterator2 first2,
+                           InputIterator2 last2,
+                           OutputIterator result,
+                           StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp,
+                                              thrust::system::detail::internal::set_union_functor());
+} // end set_union()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -25,6 +25,8 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
+#include <thrust/system/tbb/detail/par.h>
+#include <thrust/system/tbb/detail/parallel.h>
 #include <thrust/detail/temporary_array.h>
 #include <thrust/detail/copy.h>
 #include <thrust/iterator/iterator_traits.h>
@@ -32,8 +34,16 @@
 #include <thrust/merge.h>
 #include <thrust/sort.h>
 #include <thrust/detail/seq.h>
+#include <thrust/detail/minmax.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/system/detail/internal/radix_sort.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_invoke.h>
 
+#include <cstddef>
+#include <thread>
+
 THRUST_NAMESPACE_BEGIN
 namespace system
 {
@@ -45,12 +55,49 @@ namespace sort_detail
 {
 
 
-// TODO tune this based on data type and comp
-const static int threshold = 128 * 1024;
+template<typename L, typename R>
+  inline L divide_ri(const L x, const R y)
+{
+  return (x + (y - 1)) / y;
+}
+
+
+// Returns the length below which a sort of n elements of element_size bytes
+// each proceeds sequentially, unless the policy overrides it. The sequential
+// pieces fit in a core's share of the cache, and are small enough to leave
+// several pieces for every processor.
+template<typename DerivedPolicy, typename Size>
+Size sort_threshold(execution_policy<DerivedPolicy> &exec, Size n, std::size_t element_size)
+{
+  std::size_t threshold = get_sort_threshold(thrust::detail::derived_cast(exec));
+
+  if(threshold != 0)
+  {
+    // a piece of a single element can't be split any further
+    return static_cast<Size>(thrust::max<std::size_t>(2, threshold));
+  }
+
+  // about the L2 cache of a core, which a piece sorted serially should fit in
+  const std::size_t cache_size = 512 * 1024;
+
+  // below this many elements, spawning a task costs more than sorting the piece
+  const std::size_t min_threshold = 4096;
+
+  // count the number of processors
+  const unsigned int p = thrust::max<unsigned int>(1u, std::thread::hardware_concurrency());
+
+  // several pieces per processor, so that work stealing evens out uneven pieces
+  const unsigned int subscription_rate = 4;
+
+  threshold = thrust::min<std::size_t>(cache_size / element_size,
+                                       divide_ri(static_cast<std::size_t>(n), subscription_rate * p));
+
+  return static_cast<Size>(thrust::max<std::size_t>(min_threshold, threshold));
+}
 
 
 template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typename StrictWeakOrdering>
-void merge_sort(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterator1 last1, Iterator2 first2, StrictWeakOrdering comp, bool inplace);
+void merge_sort(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterator1 last1, Iterator2 first2, StrictWeakOrdering comp, std::size_t threshold, bool inplace);
 
 
 template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typename StrictWeakOrdering>
@@ -60,27 +107,28 @@ struct merge_sort_closure
   Iterator1 first1, last1;
   Iterator2 first2;
   StrictWeakOrdering comp;
+  std::size_t threshold;
   bool inplace;
 
-  merge_sort_closure(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterator1 last1, Iterator2 first2, StrictWeakOrdering comp, bool inplace)
-    : exec(exec), first1(first1), last1(last1), first2(first2), comp(comp), inplace(inplace)
+  merge_sort_closure(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterator1 last1, Iterator2 first2, StrictWeakOrdering comp, std::size_t threshold, bool inplace)
+    : exec(exec), first1(first1), last1(last1), first2(first2), comp(comp), threshold(threshold), inplace(inplace)
   {}
 
   void operator()(void) const
   {
-    merge_sort(exec, first1, last1, first2, comp, inplace);
+    merge_sort(exec, first1, last1, first2, comp, threshold, inplace);
   }
 };
 
 
 template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typename StrictWeakOrdering>
-void merge_sort(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterator1 last1, Iterator2 first2, StrictWeakOrdering comp, bool inplace)
+void merge_sort(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterator1 last1, Iterator2 first2, StrictWeakOrdering comp, std::size_t threshold, bool inplace)
 {
   typedef typename thrust::iterator_difference<Iterator1>::type difference_type;
 
   difference_type n = thrust::distance(first1, last1);
 
-  if (n < threshold)
+  if (static_cast<std::size_t>(n) < threshold)
   {
     thrust::stable_sort(thrust::seq, first1, last1, comp);
 
@@ -98,8 +146,8 @@ void merge_sort(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterato
 
   typedef merge_sort_closure<DerivedPolicy,Iterator1,Iterator2,StrictWeakOrdering> Closure;
 
-  Closure left (exec, first1, mid1,  first2, comp, !inplace);
-  Closure right(exec, mid1,   last1, mid2,   comp, !inplace);
+  Closure left (exec, first1, mid1,  first2, comp, threshold, !inplace);
+  Closure right(exec, mid1,   last1, mid2,   comp, threshold, !inplace);
 
   ::tbb::parallel_invoke(left, right);
 
@@ -115,10 +163,6 @@ namespace sort_by_key_detail
 {
 
 
-// TODO tune this based on data type and comp
-const static int threshold = 128 * 1024;
-
-
 template<typename DerivedPolicy,
          typename Iterator1,
          typename Iterator2,
@@ -132,6 +176,7 @@ void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
                        Iterator3 first3,
                        Iterator4 first4,
                        StrictWeakOrdering comp,
+                       std::size_t threshold,
                        bool inplace);
 
 
@@ -149,6 +194,7 @@ struct merge_sort_by_key_closure
   Iterator3 first3;
   Iterator4 first4;
   StrictWeakOrdering comp;
+  std::size_t threshold;
   bool inplace;
 
   merge_sort_by_key_closure(execution_policy<DerivedPolicy> &exec,
@@ -158,13 +204,14 @@ struct merge_sort_by_key_closure
                             Iterator3 first3,
                             Iterator4 first4,
                             StrictWeakOrdering comp,
+                            std::size_t threshold,
                             bool inplace)
-    : exec(exec), first1(first1), last1(last1), first2(first2), first3(first3), first4(first4), comp(comp), inplace(inplace)
+    : exec(exec), first1(first1), last1(last1), first2(first2), first3(first3), first4(first4), comp(comp), threshold(threshold), inplace(inplace)
   {}
 
   void operator()(void) const
   {
-    merge_sort_by_key(exec, first1, last1, first2, first3, first4, comp, inplace);
+    merge_sort_by_key(exec, first1, last1, first2, first3, first4, comp, threshold, inplace);
   }
 };
 
@@ -182,6 +229,7 @@ void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
                        Iterator3 first3,
                        Iterator4 first4,
                        StrictWeakOrdering comp,
+                       std::size_t threshold,
                        bool inplace)
 {
   typedef typename thrust::iterator_difference<Iterator1>::type difference_type;
@@ -195,7 +243,7 @@ void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
   Iterator2 last2 = first2 + n;
   Iterator3 last3 = first3 + n;
 
-  if (n < threshold)
+  if (static_cast<std::size_t>(n) < threshold)
   {
     thrust::stable_sort_by_key(thrust::seq, first1, last1, first2, comp);
 
@@ -210,8 +258,8 @@ void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
 
   typedef merge_sort_by_key_closure<DerivedPolicy,Iterator1,Iterator2,Iterator3,Iterator4,StrictWeakOrdering> Closure;
 
-  Closure left (exec, first1, mid1,  first2, first3, first4, comp, !inplace);
-  Closure right(exec, mid1,   last1, mid2,   mid3,   mid4,   comp, !inplace);
+  Closure left (exec, first1, mid1,  first2, first3, first4, comp, threshold, !inplace);
+  Closure right(exec, mid1,   last1, mid2,   mid3,   mid4,   comp, threshold, !inplace);
 
   ::tbb::parallel_invoke(left, right);
 
@@ -229,19 +277,351 @@ void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
 } // end namespace sort_detail
 
 
+namespace radix_sort_detail
+{
+
+
+template<typename StrictWeakOrdering, typename RandomAccessIterator, typename Size>
+struct histogram_body
+{
+  RandomAccessIterator keys;
+  Size n, tile_size;
+  unsigned int pass;
+  std::size_t *histograms;
+
+  histogram_body(RandomAccessIterator keys, Size n, Size tile_size, unsigned int pass, std::size_t *histograms)
+    : keys(keys), n(n), tile_size(tile_size), pass(pass), histograms(histograms)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    typedef typename thrust::iterator_value<RandomAccessIterator>::type                     KeyType;
+    typedef thrust::system::detail::internal::radix_sort_traits<KeyType,StrictWeakOrdering> traits;
+
+    for(Size t = r.begin(); t < r.end(); ++t)
+    {
+      Size begin = t * tile_size;
+
+      thrust::system::detail::internal::radix_histogram<StrictWeakOrdering>(keys + begin,
+                                                                            thrust::min<Size>(tile_size, n - begin),
+                                                                            pass,
+                                                                            histograms + t * traits::num_buckets);
+    }
+  }
+};
+
+
+template<typename StrictWeakOrdering, typename RandomAccessIterator, typename Size>
+  histogram_body<StrictWeakOrdering,RandomAccessIterator,Size>
+    make_histogram_body(RandomAccessIterator keys, Size n, Size tile_size, unsigned int pass, std::size_t *histograms)
+{
+  return histogram_body<StrictWeakOrdering,RandomAccessIterator,Size>(keys, n, tile_size, pass, histograms);
+}
+
+
+template<typename StrictWeakOrdering, typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size>
+struct scatter_body
+{
+  RandomAccessIterator1 keys;
+  RandomAccessIterator2 keys_result;
+  Size n, tile_size;
+  unsigned int pass;
+  std::size_t *offsets;
+
+  scatter_body(RandomAccessIterator1 keys, RandomAccessIterator2 keys_result, Size n, Size tile_size, unsigned int pass, std::size_t *offsets)
+    : keys(keys), keys_result(keys_result), n(n), tile_size(tile_size), pass(pass), offsets(offsets)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type                    KeyType;
+    typedef thrust::system::detail::internal::radix_sort_traits<KeyType,StrictWeakOrdering> traits;
+
+    for(Size t = r.begin(); t < r.end(); ++t)
+    {
+      Size begin = t * tile_size;
+
+      thrust::system::detail::internal::radix_scatter<StrictWeakOrdering>(keys + begin,
+                                                                          thrust::min<Size>(tile_size, n - begin),
+                                                                          pass,
+                                                                          offsets + t * traits::num_buckets,
+                                                                          keys_result);
+    }
+  }
+};
+
+
+template<typename StrictWeakOrdering, typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size>
+  scatter_body<StrictWeakOrdering,RandomAccessIterator1,RandomAccessIterator2,Size>
+    make_scatter_body(RandomAccessIterator1 keys, RandomAccessIterator2 keys_result, Size n, Size tile_size, unsigned int pass, std::size_t *offsets)
+{
+  return scatter_body<StrictWeakOrdering,RandomAccessIterator1,RandomAccessIterator2,Size>(keys, keys_result, n, tile_size, pass, offsets);
+}
+
+
+template<typename StrictWeakOrdering,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Size>
+struct scatter_by_key_body
+{
+  RandomAccessIterator1 keys;
+  RandomAccessIterator2 values;
+  RandomAccessIterator3 keys_result;
+  RandomAccessIterator4 values_result;
+  Size n, tile_size;
+  unsigned int pass;
+  std::size_t *offsets;
+
+  scatter_by_key_body(RandomAccessIterator1 keys,
+                      RandomAccessIterator2 values,
+                      RandomAccessIterator3 keys_result,
+                      RandomAccessIterator4 values_result,
+                      Size n,
+                      Size tile_size,
+                      unsigned int pass,
+                      std::size_t *offsets)
+    : keys(keys), values(values), keys_result(keys_result), values_result(values_result),
+      n(n), tile_size(tile_size), pass(pass), offsets(offsets)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type                    KeyType;
+    typedef thrust::system::detail::internal::radix_sort_traits<KeyType,StrictWeakOrdering> traits;
+
+    for(Size t = r.begin(); t < r.end(); ++t)
+    {
+      Size begin = t * tile_size;
+
+      thrust::system::detail::internal::radix_scatter_by_key<StrictWeakOrdering>(keys + begin,
+                                                                                 values + begin,
+                                                                                 thrust::min<Size>(tile_size, n - begin),
+                                                                                 pass,
+                                                                                 offsets + t * traits::num_buckets,
+                                                                                 keys_result,
+                                                                                 values_result);
+    }
+  }
+};
+
+
+template<typename StrictWeakOrdering,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Size>
+  scatter_by_key_body<StrictWeakOrdering,RandomAccessIterator1,RandomAccessIterator2,RandomAccessIterator3,RandomAccessIterator4,Size>
+    make_scatter_by_key_body(RandomAccessIterator1 keys,
+                             RandomAccessIterator2 values,
+                             RandomAccessIterator3 keys_result,
+                             RandomAccessIterator4 values_result,
+                             Size n,
+                             Size tile_size,
+                             unsigned int pass,
+                             std::size_t *offsets)
+{
+  return scatter_by_key_body<StrictWeakOrdering,RandomAccessIterator1,RandomAccessIterator2,RandomAccessIterator3,RandomAccessIterator4,Size>(keys, values, keys_result, values_result, n, tile_size, pass, offsets);
+}
+
+
+// chooses the tiles of a radix sort of n keys: at most one per processor,
+// each of at least threshold keys
+template<typename Size>
+  Size num_tiles(Size n, Size threshold)
+{
+  // count the number of processors
+  const unsigned int p = thrust::max<unsigned int>(1u, std::thread::hardware_concurrency());
+
+  return thrust::min<Size>(p, n / threshold);
+}
+
+
+// Radix sorts arithmetic keys ordered by less or greater. Every pass counts
+// the digits of all tiles in parallel, scans the counts serially and
+// scatters all tiles in parallel. The passes alternate between the input and
+// a single temporary buffer.
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_radix_sort(execution_policy<DerivedPolicy> &exec,
+                       RandomAccessIterator first,
+                       RandomAccessIterator last,
+                       StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type                 difference_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type                      key_type;
+  typedef thrust::system::detail::internal::radix_sort_traits<key_type,StrictWeakOrdering> traits;
+
+  difference_type n = thrust::distance(first, last);
+
+  difference_type threshold = sort_detail::sort_threshold(exec, n, sizeof(key_type));
+
+  if(n < threshold)
+  {
+    // don't bother parallelizing for small n
+    thrust::stable_sort(thrust::seq, first, last, comp);
+    return;
+  }
+
+  difference_type num_tiles = radix_sort_detail::num_tiles(n, threshold);
+  difference_type tile_size = sort_detail::divide_ri(n, num_tiles);
+
+  thrust::detail::temporary_array<key_type,DerivedPolicy>    buffer(exec, n);
+  thrust::detail::temporary_array<std::size_t,DerivedPolicy> histograms(exec, num_tiles * traits::num_buckets);
+
+  std::size_t *histogram = thrust::raw_pointer_cast(histograms.data());
+
+  bool in_buffer = false;
+
+  for(unsigned int pass = 0; pass < traits::num_passes; ++pass)
+  {
+    if(in_buffer)
+    {
+      thrust::system::tbb::detail::parallel_for_tasks(exec, num_tiles,
+        make_histogram_body<StrictWeakOrdering>(buffer.begin(), n, tile_size, pass, histogram));
+    }
+    else
+    {
+      thrust::system::tbb::detail::parallel_for_tasks(exec, num_tiles,
+        make_histogram_body<StrictWeakOrdering>(first, n, tile_size, pass, histogram));
+    }
+
+    if(!thrust::system::detail::internal::radix_offsets(histogram, num_tiles, traits::num_buckets, n))
+    {
+      // all keys share this digit
+      continue;
+    }
+
+    if(in_buffer)
+    {
+      thrust::system::tbb::detail::parallel_for_tasks(exec, num_tiles,
+        make_scatter_body<StrictWeakOrdering>(buffer.begin(), first, n, tile_size, pass, histogram));
+    }
+    else
+    {
+      thrust::system::tbb::detail::parallel_for_tasks(exec, num_tiles,
+        make_scatter_body<StrictWeakOrdering>(first, buffer.begin(), n, tile_size, pass, histogram));
+    }
+
+    in_buffer = !in_buffer;
+  }
+
+  if(in_buffer)
+  {
+    thrust::copy(exec, buffer.begin(), buffer.end(), first);
+  }
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_radix_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                              RandomAccessIterator1 keys_first,
+                              RandomAccessIterator1 keys_last,
+                              RandomAccessIterator2 values_first,
+                              StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type                difference_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type                     key_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type                     value_type;
+  typedef thrust::system::detail::internal::radix_sort_traits<key_type,StrictWeakOrdering> traits;
+
+  difference_type n = thrust::distance(keys_first, keys_last);
+
+  difference_type threshold = sort_detail::sort_threshold(exec, n, sizeof(key_type) + sizeof(value_type));
+
+  if(n < threshold)
+  {
+    // don't bother parallelizing for small n
+    thrust::stable_sort_by_key(thrust::seq, keys_first, keys_last, values_first, comp);
+    return;
+  }
+
+  difference_type num_tiles = radix_sort_detail::num_tiles(n, threshold);
+  difference_type tile_size = sort_detail::divide_ri(n, num_tiles);
+
+  thrust::detail::temporary_array<key_type,DerivedPolicy>    keys_buffer(exec, n);
+  thrust::detail::temporary_array<value_type,DerivedPolicy>  values_buffer(exec, n);
+  thrust::detail::temporary_array<std::size_t,DerivedPolicy> histograms(exec, num_tiles * traits::num_buckets);
+
+  std::size_t *histogram = thrust::raw_pointer_cast(histograms.data());
+
+  bool in_buffer = false;
+
+  for(unsigned int pass = 0; pass < traits::num_passes; ++pass)
+  {
+    if(in_buffer)
+    {
+      thrust::system::tbb::detail::parallel_for_tasks(exec, num_tiles,
+        make_histogram_body<StrictWeakOrdering>(keys_buffer.begin(), n, tile_size, pass, histogram));
+    }
+    else
+    {
+      thrust::system::tbb::detail::parallel_for_tasks(exec, num_tiles,
+        make_histogram_body<StrictWeakOrdering>(keys_first, n, tile_size, pass, histogram));
+    }
+
+    if(!thrust::system::detail::internal::radix_offsets(histogram, num_tiles, traits::num_buckets, n))
+    {
+      // all keys share this digit
+      continue;
+    }
+
+    if(in_buffer)
+    {
+      thrust::system::tbb::detail::parallel_for_tasks(exec, num_tiles,
+        make_scatter_by_key_body<StrictWeakOrdering>(keys_buffer.begin(), values_buffer.begin(), keys_first, values_first,
+                                                     n, tile_size, pass, histogram));
+    }
+    else
+    {
+      thrust::system::tbb::detail::parallel_for_tasks(exec, num_tiles,
+        make_scatter_by_key_body<StrictWeakOrdering>(keys_first, values_first, keys_buffer.begin(), values_buffer.begin(),
+                                                     n, tile_size, pass, histogram));
+    }
+
+    in_buffer = !in_buffer;
+  }
+
+  if(in_buffer)
+  {
+    thrust::copy(exec, keys_buffer.begin(),   keys_buffer.end(),   keys_first);
+    thrust::copy(exec, values_buffer.begin(), values_buffer.end(), values_first);
+  }
+}
+
+
+} // end namespace radix_sort_detail
+
+
+namespace stable_sort_detail
+{
+
+
 template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename StrictWeakOrdering>
 void stable_sort(execution_policy<DerivedPolicy> &exec,
                  RandomAccessIterator first,
                  RandomAccessIterator last,
-                 StrictWeakOrdering comp)
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
 {
   typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
 
   thrust::detail::temporary_array<key_type, DerivedPolicy> temp(exec, first, last);
 
-  sort_detail::merge_sort(exec, first, last, temp.begin(), comp, true);
+  std::size_t threshold = sort_detail::sort_threshold(exec, temp.size(), sizeof(key_type));
+
+  thrust::system::tbb::detail::execute(exec, [&] {
+    sort_detail::merge_sort(exec, first, last, temp.begin(), comp, threshold, true);
+  });
 }
 
 
@@ -253,7 +633,8 @@ template<typename DerivedPolicy,
                           RandomAccessIterator1 first1,
                           RandomAccessIterator1 last1,
                           RandomAccessIterator2 first2,
-                          StrictWeakOrdering comp)
+                          StrictWeakOrdering comp,
+                 thrust::detail::false_type)
 {
   typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
   typedef typename thrust::iterator_value<RandomAccessIterator2>::type val_type;
@@ -263,7 +644,76 @@ template<typename DerivedPolicy,
   thrust::detail::temporary_array<key_type, DerivedPolicy> temp1(exec, first1, last1);
   thrust::detail::temporary_array<val_type, DerivedPolicy> temp2(exec, first2, last2);
 
-  sort_by_key_detail::merge_sort_by_key(exec, first1, last1, first2, temp1.begin(), temp2.begin(), comp, true);
+  std::size_t threshold = sort_detail::sort_threshold(exec, temp1.size(), sizeof(key_type) + sizeof(val_type));
+
+  thrust::system::tbb::detail::execute(exec, [&] {
+    sort_by_key_detail::merge_sort_by_key(exec, first1, last1, first2, temp1.begin(), temp2.begin(), comp, threshold, true);
+  });
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+  radix_sort_detail::stable_radix_sort(exec, first, last, comp);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+  void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          StrictWeakOrdering comp,
+                          thrust::detail::true_type)
+{
+  radix_sort_detail::stable_radix_sort_by_key(exec, first1, last1, first2, comp);
+}
+
+
+} // end namespace stable_sort_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+
+  thrust::system::detail::internal::use_radix_sort<key_type,StrictWeakOrdering> use_radix_sort;
+
+  stable_sort_detail::stable_sort(exec, first, last, comp, use_radix_sort);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+  void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+
+  thrust::system::detail::internal::use_radix_sort<key_type,StrictWeakOrdering> use_radix_sort;
+
+  stable_sort_detail::stable_sort_by_key(exec, first1, last1, first2, comp, use_radix_sort);
 }
 
 
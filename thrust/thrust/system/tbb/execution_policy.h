@@ -147,6 +147,24 @@ struct tag : thrust::system::tbb::execution_policy<tag> { unspecified };
  *
  *  // 0 1 2 is printed to standard output in some unspecified order
  *  \endcode
+ *
+ *  \p thrust::tbb::par can also carry parameters for the algorithms it dispatches.
+ *  <tt>par.on(arena)</tt> runs them in the <tt>tbb::task_arena</tt> \p arena, which must outlive
+ *  the call. <tt>par.with_partitioner(kind)</tt> selects how loops over elements split their
+ *  range: \p thrust::tbb::partition_auto (the default), \p thrust::tbb::partition_affinity or
+ *  \p thrust::tbb::partition_static. <tt>par.with_affinity(ap)</tt> uses the
+ *  <tt>tbb::affinity_partitioner</tt> \p ap, so that repeated calls over the same data can reuse
+ *  the same threads. <tt>par.with_grain_size(n)</tt> keeps loops from splitting ranges of \p n
+ *  or fewer elements. Scans accept only the default partitioner, and ignore the others.
+ *
+ *  \code
+ *  tbb::task_arena arena(2);
+ *  tbb::affinity_partitioner ap;
+ *
+ *  // run on the two threads of arena, replaying the assignment of elements to threads
+ *  thrust::for_each(thrust::tbb::par.on(arena).with_affinity(ap).with_grain_size(1024),
+ *                   vec.begin(), vec.end(), printf_functor());
+ *  \endcode
  */
 static const unspecified par;
 
@@ -33,6 +33,7 @@
 #include <thrust/memory.h>
 #include <thrust/detail/type_traits.h>
 #include <thrust/mr/allocator.h>
+#include <thrust/detail/allocator/host_system_allocator.h>
 #include <ostream>
 
 THRUST_NAMESPACE_BEGIN
@@ -92,6 +93,15 @@ using universal_allocator = thrust::mr::stateless_resource_allocator<
   T, thrust::system::tbb::universal_memory_resource
 >;
 
+/*! \p tbb::host_allocator allocates ordinary host memory, like
+ *  \p std::allocator, with raw pointers. Containers using it construct, copy
+ *  and fill their elements in parallel with the \p tbb system.
+ */
+template<typename T>
+using host_allocator = thrust::detail::host_system_allocator<
+  T, thrust::system::tbb::tag
+>;
+
 }} // namespace system::tbb
 
 /*! \namespace thrust::tbb
@@ -103,6 +113,7 @@ using thrust::system::tbb::malloc;
 using thrust::system::tbb::free;
 using thrust::system::tbb::allocator;
 using thrust::system::tbb::universal_allocator;
+using thrust::system::tbb::host_allocator;
 } // namsespace tbb
 
 THRUST_NAMESPACE_END
@@ -32,6 +32,7 @@
 #endif // no system header
 #include <thrust/system/tbb/memory.h>
 #include <thrust/detail/vector_base.h>
+#include <thrust/host_vector.h>
 #include <vector>
 
 THRUST_NAMESPACE_BEGIN
@@ -79,12 +80,29 @@ using vector = thrust::detail::vector_base<T, Allocator>;
 template <typename T, typename Allocator = thrust::system::tbb::universal_allocator<T>>
 using universal_vector = thrust::detail::vector_base<T, Allocator>;
 
+/*! \p tbb::host_vector is a \p host_vector whose elements reside in
+ *  ordinary host memory, and are constructed, copied and filled in parallel
+ *  with the \p tbb system, rather than sequentially. Combined with
+ *  \p default_init, large buffers which are about to be overwritten can be
+ *  allocated without writing to them at all.
+ *
+ *  \tparam T The element type of the \p tbb::host_vector.
+ *  \tparam Allocator The allocator type of the \p tbb::host_vector.
+ *          Defaults to \p tbb::host_allocator.
+ *
+ *  \see host_vector
+ *  \see default_init
+ */
+template <typename T, typename Allocator = thrust::system::tbb::host_allocator<T>>
+using host_vector = thrust::host_vector<T, Allocator>;
+
 }} // namespace system::tbb
 
 namespace tbb
 {
 using thrust::system::tbb::vector;
 using thrust::system::tbb::universal_vector;
+using thrust::system::tbb::host_vector;
 }
 
 THRUST_NAMESPACE_END